@@ -0,0 +1,95 @@
+# Footprint report for the firmware image, run by PlatformIO after linking.
+#
+# Lists flash and RAM use per module (object file) and per symbol, then fails the
+# build when the totals go over custom_flash_budget / custom_ram_budget from
+# platformio.ini, if they are set. The report is also written to footprint.txt in the
+# build directory.
+# Peak stack depth is only known at runtime, see stack_peak_usage() in src/stack.cpp.
+
+import os
+import re
+import subprocess
+
+Import("env")
+
+
+def nm_symbols(path):
+    """Returns (size, type, name) for every sized symbol of an ELF or object file."""
+    nm = env.subst("$CC").replace("gcc", "nm")
+    output = subprocess.check_output([nm, "-S", "-C", "--size-sort", path], env=env["ENV"]).decode()
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4:
+            symbols.append((int(fields[1], 16), fields[2].lower(), fields[3]))
+    return symbols
+
+
+def footprint(symbols):
+    """Flash and RAM bytes of a list of symbols. Initialized data uses both."""
+    flash = sum(size for size, kind, _ in symbols if kind in "trd")
+    ram = sum(size for size, kind, _ in symbols if kind in "bd")
+    return flash, ram
+
+
+def footprint_report(source, target, env):
+    build_dir = env.subst("$BUILD_DIR")
+    elf = str(target[0])
+
+    lines = ["%-24s %8s %8s" % ("module", "flash", "ram")]
+    for root, _, files in os.walk(os.path.join(build_dir, "src")):
+        for name in sorted(files):
+            if name.endswith(".o"):
+                flash, ram = footprint(nm_symbols(os.path.join(root, name)))
+                lines.append("%-24s %8d %8d" % (name[:-2], flash, ram))
+
+    symbols = nm_symbols(elf)
+    lines.append("")
+    lines.append("%-40s %6s %s" % ("symbol", "size", "section"))
+    for size, kind, name in sorted(symbols, reverse=True):
+        section = {"t": "flash", "r": "flash", "d": "flash+ram", "b": "ram"}.get(kind)
+        if section:
+            lines.append("%-40s %6d %s" % (name[:40], size, section))
+
+    # totals from the section headers, which include padding and the vector table
+    output = subprocess.check_output([env.subst("$SIZETOOL"), "-A", elf], env=env["ENV"]).decode()
+    sections = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0].startswith("."):
+            sections[fields[0]] = int(fields[1])
+    flash = sections.get(".text", 0) + sections.get(".data", 0)
+    ram = sections.get(".data", 0) + sections.get(".bss", 0) + sections.get(".noinit", 0)
+
+    # budgets are optional, a total without one is only reported
+    flash_budget = env.GetProjectOption("custom_flash_budget", "")
+    ram_budget = env.GetProjectOption("custom_ram_budget", "")
+    lines.insert(0, "flash %d%s bytes, ram %d%s bytes (stack not included)"
+                 % (flash, " / " + flash_budget if flash_budget else "",
+                    ram, " / " + ram_budget if ram_budget else ""))
+    lines.insert(1, "")
+
+    # compare with the totals of another environment (bare-metal against Arduino)
+    baseline = env.GetProjectOption("custom_footprint_baseline", "")
+    if baseline:
+        path = os.path.join(os.path.dirname(build_dir), baseline, "footprint.txt")
+        if os.path.exists(path):
+            with open(path) as f:
+                totals = re.match(r"flash (\d+).*ram (\d+)", f.readline())
+            if totals:
+                base_flash, base_ram = int(totals.group(1)), int(totals.group(2))
+                lines.insert(1, "%s: flash %d bytes, ram %d bytes, saved flash %d bytes, ram %d bytes"
+                             % (baseline, base_flash, base_ram, base_flash - flash, base_ram - ram))
+
+    report = "\n".join(lines) + "\n"
+    with open(os.path.join(build_dir, "footprint.txt"), "w") as f:
+        f.write(report)
+    print(report)
+
+    if (flash_budget and flash > int(flash_budget)) or (ram_budget and ram > int(ram_budget)):
+        print("Footprint budget exceeded")
+        return 1
+    return 0
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", footprint_report)
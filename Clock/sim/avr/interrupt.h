@@ -0,0 +1,35 @@
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+// Interrupt vectors of the host simulator (sim.cpp), in the order of the ATmega2560 
+// vector table, which is also their priority. Only the vectors used by the firmware 
+// are listed.
+typedef enum simVector_enum {
+    sim_INT4_vect, sim_INT5_vect, sim_TIMER1_COMPA_vect, sim_TIMER0_COMPA_vect,
+    sim_TIMER0_OVF_vect, sim_SPI_STC_vect, sim_TIMER3_COMPA_vect, sim_TIMER5_COMPA_vect,
+    sim_USART2_RX_vect, sim_vector_count}
+simVector;
+
+#define ISR_BLOCK 0
+#define ISR_NOBLOCK 1
+
+// Registers handler for the vector, flags are ISR_BLOCK or ISR_NOBLOCK
+int sim_register_isr(simVector vector, void (*handler)(), int flags);
+
+static inline int sim_isr_flags(int flags){ return flags; }
+static inline int sim_isr_flags(int, int flags){ return flags; }
+
+// The handler is a plain function the simulator calls when the interrupt is taken, 
+// with SREG_I cleared unless ISR_NOBLOCK is given
+#define ISR(vector, ...) \
+    static void vector##_handler(); \
+    [[maybe_unused]] static int vector##_registered = \
+        sim_register_isr(sim_##vector, vector##_handler, sim_isr_flags(0, ##__VA_ARGS__)); \
+    static void vector##_handler()
+
+static inline void sei(){ SREG |= (1 << SREG_I); }
+static inline void cli(){ SREG &= ~(1 << SREG_I); }
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SIM_AVR_WDT_H
+#define SIM_AVR_WDT_H
+
+#define WDTO_15MS 0
+#define WDTO_30MS 1
+#define WDTO_60MS 2
+#define WDTO_120MS 3
+#define WDTO_250MS 4
+#define WDTO_500MS 5
+#define WDTO_1S 6
+#define WDTO_2S 7
+#define WDTO_4S 8
+#define WDTO_8S 9
+
+// Watchdog of the host simulator (sim.cpp). A timeout is counted, not acted on.
+void sim_watchdog_enable(int timeout);
+void sim_watchdog_disable();
+
+// Feeding the watchdog once per pass of the main loop is where the simulator lets
+// virtual time run and hands control back to the scenario
+void sim_loop_point();
+
+static inline void wdt_enable(int timeout){ sim_watchdog_enable(timeout); }
+static inline void wdt_disable(){ sim_watchdog_disable(); }
+static inline void wdt_reset(){ sim_loop_point(); }
+
+#endif
@@ -0,0 +1,163 @@
+#include <avr/io.h>
+
+// Storage of the plain registers of avr/io.h. They start at 0 like after a reset, the
+// simulator sets the inputs (sim.cpp).
+
+volatile uint8_t PINA;
+volatile uint8_t DDRA;
+volatile uint8_t PORTA;
+volatile uint8_t PINB;
+volatile uint8_t DDRB;
+volatile uint8_t PORTB;
+volatile uint8_t PINC;
+volatile uint8_t DDRC;
+volatile uint8_t PORTC;
+volatile uint8_t PIND;
+volatile uint8_t DDRD;
+volatile uint8_t PORTD;
+volatile uint8_t PINE;
+volatile uint8_t DDRE;
+volatile uint8_t PORTE;
+volatile uint8_t PINF;
+volatile uint8_t DDRF;
+volatile uint8_t PORTF;
+volatile uint8_t PING;
+volatile uint8_t DDRG;
+volatile uint8_t PORTG;
+volatile uint8_t PINH;
+volatile uint8_t DDRH;
+volatile uint8_t PORTH;
+volatile uint8_t PINJ;
+volatile uint8_t DDRJ;
+volatile uint8_t PORTJ;
+volatile uint8_t PINK;
+volatile uint8_t DDRK;
+volatile uint8_t PORTK;
+volatile uint8_t PINL;
+volatile uint8_t DDRL;
+volatile uint8_t PORTL;
+volatile uint8_t PCIFR;
+volatile uint8_t EIMSK;
+volatile uint8_t GPIOR0;
+volatile uint8_t GPIOR1;
+volatile uint8_t GPIOR2;
+volatile uint8_t EECR;
+volatile uint8_t EEDR;
+volatile uint8_t SPL;
+volatile uint8_t SPH;
+volatile uint8_t TCCR0A;
+volatile uint8_t TCCR0B;
+volatile uint8_t OCR0A;
+volatile uint8_t OCR0B;
+volatile uint8_t SPCR;
+volatile uint8_t SPSR;
+volatile uint8_t SPDR;
+volatile uint8_t ACSR;
+volatile uint8_t SMCR;
+volatile uint8_t MCUSR;
+volatile uint8_t MCUCR;
+volatile uint8_t SPMCSR;
+volatile uint8_t WDTCSR;
+volatile uint8_t CLKPR;
+volatile uint8_t PRR0;
+volatile uint8_t PRR1;
+volatile uint8_t OSCCAL;
+volatile uint8_t PCICR;
+volatile uint8_t EICRA;
+volatile uint8_t EICRB;
+volatile uint8_t PCMSK0;
+volatile uint8_t PCMSK1;
+volatile uint8_t PCMSK2;
+volatile uint8_t TIMSK0;
+volatile uint8_t TIMSK1;
+volatile uint8_t TIMSK2;
+volatile uint8_t TIMSK3;
+volatile uint8_t TIMSK4;
+volatile uint8_t TIMSK5;
+volatile uint8_t ADCL;
+volatile uint8_t ADCH;
+volatile uint8_t ADCSRB;
+volatile uint8_t ADMUX;
+volatile uint8_t DIDR0;
+volatile uint8_t DIDR1;
+volatile uint8_t DIDR2;
+volatile uint8_t TCCR1A;
+volatile uint8_t TCCR1B;
+volatile uint8_t TCCR1C;
+volatile uint8_t TCCR2A;
+volatile uint8_t TCCR2B;
+volatile uint8_t OCR2A;
+volatile uint8_t OCR2B;
+volatile uint8_t ASSR;
+volatile uint8_t TWBR;
+volatile uint8_t TWSR;
+volatile uint8_t TWAR;
+volatile uint8_t TWDR;
+volatile uint8_t TWAMR;
+volatile uint8_t TCCR3A;
+volatile uint8_t TCCR3B;
+volatile uint8_t TCCR3C;
+volatile uint8_t TCCR4A;
+volatile uint8_t TCCR4B;
+volatile uint8_t TCCR4C;
+volatile uint8_t TCCR5A;
+volatile uint8_t TCCR5B;
+volatile uint8_t TCCR5C;
+volatile uint8_t UCSR0B;
+volatile uint8_t UCSR0C;
+volatile uint8_t UBRR0L;
+volatile uint8_t UBRR0H;
+volatile uint8_t UCSR1A;
+volatile uint8_t UCSR1B;
+volatile uint8_t UCSR1C;
+volatile uint8_t UDR1;
+volatile uint8_t UCSR2A;
+volatile uint8_t UCSR2B;
+volatile uint8_t UCSR2C;
+volatile uint8_t UDR2;
+volatile uint8_t UCSR3A;
+volatile uint8_t UCSR3B;
+volatile uint8_t UCSR3C;
+volatile uint8_t UDR3;
+volatile uint16_t ICR1;
+volatile uint16_t OCR1A;
+volatile uint16_t OCR1B;
+volatile uint16_t OCR1C;
+volatile uint16_t ICR3;
+volatile uint16_t OCR3A;
+volatile uint16_t OCR3B;
+volatile uint16_t OCR3C;
+volatile uint16_t ICR4;
+volatile uint16_t OCR4A;
+volatile uint16_t OCR4B;
+volatile uint16_t OCR4C;
+volatile uint16_t ICR5;
+volatile uint16_t OCR5A;
+volatile uint16_t OCR5B;
+volatile uint16_t OCR5C;
+volatile uint16_t UBRR0;
+volatile uint16_t UBRR1;
+volatile uint16_t UBRR2;
+volatile uint16_t UBRR3;
+volatile uint16_t ADC;
+volatile uint16_t SP;
+volatile uint16_t EEAR;
+// Registers handled by the simulator
+simRegister<uint8_t> SREG(sim_sreg);
+simRegister<uint8_t> TWCR(sim_twcr);
+simRegister<uint8_t> TIFR0(sim_tifr0);
+simRegister<uint8_t> TIFR1(sim_tifr1);
+simRegister<uint8_t> TIFR2(sim_tifr2);
+simRegister<uint8_t> TIFR3(sim_tifr3);
+simRegister<uint8_t> TIFR4(sim_tifr4);
+simRegister<uint8_t> TIFR5(sim_tifr5);
+simRegister<uint8_t> EIFR(sim_eifr);
+simRegister<uint8_t> UCSR0A(sim_ucsr0a);
+simRegister<uint8_t> UDR0(sim_udr0);
+simRegister<uint8_t> ADCSRA(sim_adcsra);
+simRegister<uint8_t> TCNT0(sim_tcnt0);
+simRegister<uint16_t> TCNT1(sim_tcnt1);
+simRegister<uint8_t> TCNT2(sim_tcnt2);
+simRegister<uint16_t> TCNT3(sim_tcnt3);
+simRegister<uint16_t> TCNT4(sim_tcnt4);
+simRegister<uint16_t> TCNT5(sim_tcnt5);
@@ -0,0 +1,872 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/wdt.h>
+#include <util/twi.h>
+#include <ucontext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include "sim.h"
+#include "global_header.h"
+#include "pin_map.h"
+#include "remote.h"
+
+// main() of the firmware, renamed by main.cpp when built for the simulator
+int firmware_main();
+
+// Virtual time taken by one pass of the firmware main loop and by one poll of a busy
+// register (about 6 cycles for a load, test and branch)
+#define SIM_LOOP_CYCLES 1600
+#define SIM_POLL_CYCLES 6
+
+// Time that never comes
+#define SIM_NEVER UINT64_MAX
+
+// Virtual time in CPU cycles
+static uint64_t now = 0;
+
+// The timers are only moved when one of their events is due or a counter is accessed.
+// Until then the time of the next event computed last stays valid, unless the
+// firmware changes a timer: it is computed again after every register access through
+// the simulator, every interrupt routine and every pass of the main loop.
+static uint64_t timers_time = 0;
+static uint64_t next_event = 0;
+
+// Value of SREG
+static uint8_t status_register = 0;
+
+// Set when an interrupt may have become pending (a flag set, an enable bit or SREG_I
+// written), so the vectors are only looked at then
+static char interrupt_hint = 1;
+
+/*Scheduled actions*/
+
+static std::multimap<uint64_t, std::function<void()>> actions;
+
+static void schedule_at(uint64_t cycles, std::function<void()> action){
+    actions.insert(std::make_pair(cycles, action));
+    if(cycles < next_event)
+        next_event = cycles;
+}
+
+void sim_schedule_us(uint64_t delay_us, std::function<void()> action){
+    schedule_at(now + delay_us * SIM_CYCLES_PER_US, action);
+}
+
+/*Timers*/
+
+// Registers of a timer and its counter, kept in CPU cycles since the last wrap
+typedef struct simTimer_struct {
+    volatile uint8_t * tccra;
+    volatile uint8_t * tccrb;
+    volatile uint8_t * ocra8;
+    volatile uint16_t * ocra16;
+    volatile uint8_t * timsk;
+    volatile uint8_t * prr;
+    uint8_t prr_bit;
+    uint64_t phase;
+    uint8_t flags;
+} simTimer;
+
+static simTimer timers[6] = {
+    {&TCCR0A, &TCCR0B, &OCR0A, 0, &TIMSK0, &PRR0, PRTIM0, 0, 0},
+    {&TCCR1A, &TCCR1B, 0, &OCR1A, &TIMSK1, &PRR0, PRTIM1, 0, 0},
+    {&TCCR2A, &TCCR2B, &OCR2A, 0, &TIMSK2, &PRR0, PRTIM2, 0, 0},
+    {&TCCR3A, &TCCR3B, 0, &OCR3A, &TIMSK3, &PRR1, PRTIM3, 0, 0},
+    {&TCCR4A, &TCCR4B, 0, &OCR4A, &TIMSK4, &PRR1, PRTIM4, 0, 0},
+    {&TCCR5A, &TCCR5B, 0, &OCR5A, &TIMSK5, &PRR1, PRTIM5, 0, 0}};
+
+// Prescaler of the clock select bits, 0 when stopped (external clocks are not used)
+static uint32_t timer_divider(int n){
+    static const uint16_t dividers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+    static const uint16_t dividers2[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+    simTimer * timer = &timers[n];
+    if(*timer->prr & (1 << timer->prr_bit))
+        return 0;
+    return (n == 2 ? dividers2 : dividers)[*timer->tccrb & 7];
+}
+
+static uint32_t timer_ocra(int n){
+    return timers[n].ocra8 ? *timers[n].ocra8 : *timers[n].ocra16;
+}
+
+// Waveform generation mode
+static uint8_t timer_mode(int n){
+    simTimer * timer = &timers[n];
+    if(n == 0 || n == 2)
+        return (*timer->tccra & 3) | ((*timer->tccrb >> 1) & 4);
+    return (*timer->tccra & 3) | ((*timer->tccrb >> 1) & 12);
+}
+
+// TOP of the counter, and whether it is OCRnA (compare A flag at TOP) and whether
+// TOV is set at TOP (normal and fast PWM modes, the CTC modes set it at MAX only)
+static uint32_t timer_top(int n, char * top_is_ocra, char * overflow_at_top){
+    uint8_t mode = timer_mode(n);
+    *top_is_ocra = 0;
+    *overflow_at_top = 1;
+    if(n == 0 || n == 2){
+        if(mode == 2 || mode == 7){
+            *top_is_ocra = 1;
+            *overflow_at_top = (mode == 7);
+            return timer_ocra(n);
+        }
+        return 0xFF;
+    }
+    switch(mode){
+        case 4:
+            *overflow_at_top = 0;
+            *top_is_ocra = 1;
+            return timer_ocra(n);
+        case 15:
+            *top_is_ocra = 1;
+            return timer_ocra(n);
+        case 1: case 5: return 0xFF;
+        case 2: case 6: return 0x1FF;
+        case 3: case 7: return 0x3FF;
+        default: return 0xFFFF;
+    }
+}
+
+// Only timers with an interrupt enabled or with flags polled by the firmware (display
+// and delay timers) need their events, the others only keep counting
+static char timer_has_events(int n){
+    return *timers[n].timsk != 0 || n == 0 || n == 2;
+}
+
+// Cycles until the next flag of the timer is set
+static uint64_t timer_next_event(int n){
+    uint32_t divider = timer_divider(n);
+    if(!divider || !timer_has_events(n))
+        return SIM_NEVER;
+    char top_is_ocra, overflow_at_top;
+    uint32_t top = timer_top(n, &top_is_ocra, &overflow_at_top);
+    uint64_t period = (uint64_t)(top + 1) * divider;
+    uint64_t phase = timers[n].phase;
+    if(phase >= period)
+        return 0;
+    uint64_t next = period - phase;
+    if(!top_is_ocra){
+        uint64_t compare = (uint64_t)(timer_ocra(n) + 1) * divider;
+        if(compare <= period && phase < compare && compare - phase < next)
+            next = compare - phase;
+    }
+    return next;
+}
+
+// Moves the timer by the given cycles, which must not go past its next event by more
+// than a register change made meanwhile
+static void timer_step(int n, uint64_t cycles){
+    simTimer * timer = &timers[n];
+    uint32_t divider = timer_divider(n);
+    if(!divider)
+        return;
+    char top_is_ocra, overflow_at_top;
+    uint32_t top = timer_top(n, &top_is_ocra, &overflow_at_top);
+    uint64_t period = (uint64_t)(top + 1) * divider;
+
+    if(!timer_has_events(n)){
+        timer->phase = (timer->phase + cycles) % period;
+        return;
+    }
+
+    uint64_t previous = timer->phase;
+    timer->phase += cycles;
+    if(!top_is_ocra){
+        uint64_t compare = (uint64_t)(timer_ocra(n) + 1) * divider;
+        if(previous < compare && timer->phase >= compare && compare <= period)
+            timer->flags |= (1 << OCF1A);
+        interrupt_hint = 1;
+    }
+    if(timer->phase >= period){
+        // a TOP written below the count is passed at once rather than after MAX
+        timer->phase -= period;
+        if(timer->phase >= period)
+            timer->phase = 0;
+        if(overflow_at_top)
+            timer->flags |= (1 << TOV1);
+        if(top_is_ocra)
+            timer->flags |= (1 << OCF1A);
+        interrupt_hint = 1;
+    }
+}
+
+static void sync_timers(){
+    for(int n = 0; n < 6; n++)
+        timer_step(n, now - timers_time);
+    timers_time = now;
+}
+
+static void recompute_next_event(){
+    next_event = SIM_NEVER;
+    for(int n = 0; n < 6; n++){
+        uint64_t next = timer_next_event(n);
+        if(next != SIM_NEVER && now + next < next_event)
+            next_event = now + next;
+    }
+    if(!actions.empty() && actions.begin()->first < next_event)
+        next_event = actions.begin()->first;
+}
+
+static uint16_t timer_count(int n){
+    sync_timers();
+    uint32_t divider = timer_divider(n);
+    return timers[n].phase / (divider ? divider : 1);
+}
+
+static void set_timer_count(int n, uint16_t count){
+    sync_timers();
+    uint32_t divider = timer_divider(n);
+    timers[n].phase = (uint64_t)count * (divider ? divider : 1);
+}
+
+/*Interrupts*/
+
+typedef struct simHandler_struct {
+    void (*handler)();
+    int flags;
+    unsigned long count;
+} simHandler;
+
+static simHandler handlers[sim_vector_count];
+
+int sim_register_isr(simVector vector, void (*handler)(), int flags){
+    handlers[vector].handler = handler;
+    handlers[vector].flags = flags;
+    return 1;
+}
+
+unsigned long sim_isr_count(simVector vector){
+    return handlers[vector].count;
+}
+
+// Called before (entering 1) and after (entering 0) every interrupt routine
+static std::function<void(simVector, int)> interrupt_watch;
+
+void sim_watch_interrupts(std::function<void(simVector vector, int entering)> watch){
+    interrupt_watch = watch;
+}
+
+// External interrupt flags
+static uint8_t external_flags = 0;
+
+// Returns 1 if the interrupt is enabled and its flag is set, and clears the flag if
+// take is set, as the hardware does when it jumps to the vector
+static char interrupt_pending(simVector vector, char take){
+    volatile uint8_t * mask = 0;
+    uint8_t * flags = 0;
+    uint8_t enable = 0, flag = 0;
+    switch(vector){
+        case sim_INT4_vect:
+            mask = &EIMSK; enable = 1 << INT4; flags = &external_flags; flag = 1 << INTF4; break;
+        case sim_INT5_vect:
+            mask = &EIMSK; enable = 1 << INT5; flags = &external_flags; flag = 1 << INTF5; break;
+        case sim_TIMER1_COMPA_vect:
+            mask = &TIMSK1; enable = 1 << OCIE1A; flags = &timers[1].flags; flag = 1 << OCF1A; break;
+        case sim_TIMER0_COMPA_vect:
+            mask = &TIMSK0; enable = 1 << OCIE0A; flags = &timers[0].flags; flag = 1 << OCF0A; break;
+        case sim_TIMER0_OVF_vect:
+            mask = &TIMSK0; enable = 1 << TOIE0; flags = &timers[0].flags; flag = 1 << TOV0; break;
+        case sim_TIMER3_COMPA_vect:
+            mask = &TIMSK3; enable = 1 << OCIE3A; flags = &timers[3].flags; flag = 1 << OCF3A; break;
+        case sim_TIMER5_COMPA_vect:
+            mask = &TIMSK5; enable = 1 << OCIE5A; flags = &timers[5].flags; flag = 1 << OCF5A; break;
+        case sim_USART2_RX_vect:
+            // the flag stays set until the routine reads UDR2
+            return (UCSR2B & (1 << RXCIE2)) && (UCSR2A & (1 << RXC2));
+        default:
+            // SPI transfers are not simulated
+            return 0;
+    }
+    if(!(*mask & enable) || !(*flags & flag))
+        return 0;
+    if(take)
+        *flags &= ~flag;
+    return 1;
+}
+
+static void capture_display();
+
+// Runs the pending interrupt routines in priority order while interrupts are enabled.
+// A routine runs with SREG_I cleared, or set first thing with ISR_NOBLOCK so other
+// interrupts nest in it, and the return from interrupt sets SREG_I again.
+static void dispatch_interrupts(){
+    if(!interrupt_hint)
+        return;
+    while(status_register & (1 << SREG_I)){
+        int vector = 0;
+        while(vector < sim_vector_count &&
+            !(handlers[vector].handler && interrupt_pending((simVector)vector, 0)))
+            vector += 1;
+        if(vector == sim_vector_count){
+            interrupt_hint = 0;
+            return;
+        }
+
+        interrupt_pending((simVector)vector, 1);
+        handlers[vector].count += 1;
+        status_register &= ~(1 << SREG_I);
+        if(handlers[vector].flags & ISR_NOBLOCK)
+            sim_register_write(sim_sreg, status_register | (1 << SREG_I));
+        if(interrupt_watch)
+            interrupt_watch((simVector)vector, 1);
+        handlers[vector].handler();
+        if(interrupt_watch)
+            interrupt_watch((simVector)vector, 0);
+        status_register |= (1 << SREG_I);
+        next_event = now;
+
+        if(vector == sim_TIMER0_OVF_vect)
+            capture_display();
+    }
+}
+
+/*Watchdog*/
+
+static uint64_t watchdog_timeout = 0;
+static uint64_t watchdog_fed = 0;
+static unsigned long watchdog_timeouts = 0;
+
+void sim_watchdog_enable(int timeout){
+    // 15 ms doubled for every step of the WDTO_ values
+    watchdog_timeout = (uint64_t)(15000UL << timeout) * SIM_CYCLES_PER_US;
+    watchdog_fed = now;
+}
+
+void sim_watchdog_disable(){
+    watchdog_timeout = 0;
+}
+
+unsigned long sim_watchdog_timeouts(){
+    return watchdog_timeouts;
+}
+
+/*TWI bus*/
+
+#define TWI_SCL PIND0
+#define TWI_SDA PIND1
+#define MPU_ADDRESS 0x68
+#define OLED_ADDRESS 0x3C
+
+static struct {
+    char started;           // a start has been sent, the bus belongs to the master
+    char address_next;      // the next byte is the address frame
+    char reading;           // direction of the transfer
+    char slave;             // address of the slave that answered, 0 if none
+    char pointer_next;      // the next byte written to the MPU is the register address
+    uint64_t done;          // time TWINT is set
+    uint64_t stop_done;     // time the stop condition is sent
+    uint8_t control;        // TWCR bits set by the firmware
+    int nacks;              // address frames to NACK
+    int bus_errors;         // operations to fail with a bus error
+    int sda_pulses;         // SCL pulses before SDA is released, 0 if not held
+    unsigned long scl_pulses;
+    unsigned long stops;    // stop conditions sent
+    uint8_t ddrd;           // DDRD as last seen, to count SCL pulses
+} twi = {0, 0, 0, 0, 0, SIM_NEVER, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static struct {
+    char connected;
+    uint8_t registers[128];
+    uint8_t pointer;
+} mpu = {1, {0}, 0};
+
+static unsigned long oled_bytes = 0;
+
+void sim_mpu_connect(int connected){
+    mpu.connected = connected;
+    if(connected){
+        // asleep after a power up
+        mpu.registers[0x6B] = 0x40;
+        mpu.registers[0x75] = MPU_ADDRESS;
+    }
+}
+
+static void set_mpu_word(uint8_t address, int value){
+    mpu.registers[address] = (uint16_t)value >> 8;
+    mpu.registers[address + 1] = value & 0xFF;
+}
+
+void sim_mpu_accel(int x, int y, int z){
+    set_mpu_word(0x3B, x);
+    set_mpu_word(0x3D, y);
+    set_mpu_word(0x3F, z);
+}
+
+void sim_mpu_temperature(int raw){
+    set_mpu_word(0x41, raw);
+}
+
+uint8_t sim_mpu_register(uint8_t address){
+    return mpu.registers[address & 0x7F];
+}
+
+void sim_twi_nack(int frames){
+    twi.nacks = frames;
+}
+
+void sim_twi_bus_error(int operations){
+    twi.bus_errors = operations;
+}
+
+void sim_twi_hold_sda(int pulses){
+    twi.sda_pulses = pulses;
+}
+
+int sim_twi_sda_held(){
+    return twi.sda_pulses > 0;
+}
+
+unsigned long sim_twi_scl_pulses(){
+    return twi.scl_pulses;
+}
+
+unsigned long sim_twi_stops(){
+    return twi.stops;
+}
+
+unsigned long sim_oled_bytes(){
+    return oled_bytes;
+}
+
+// Follows SCL and SDA driven by hand (the pins are pulled low by making them outputs):
+// a release of SCL is a clock pulse for the slave holding SDA
+static void watch_bus_pins(){
+    uint8_t ddrd = DDRD;
+    if((twi.ddrd & (1 << TWI_SCL)) && !(ddrd & (1 << TWI_SCL))){
+        twi.scl_pulses += 1;
+        if(twi.sda_pulses > 0)
+            twi.sda_pulses -= 1;
+    }
+    twi.ddrd = ddrd;
+
+    uint8_t pins = (1 << TWI_SCL) | (1 << TWI_SDA);
+    if(ddrd & (1 << TWI_SCL))
+        pins &= ~(1 << TWI_SCL);
+    if((ddrd & (1 << TWI_SDA)) || twi.sda_pulses > 0)
+        pins &= ~(1 << TWI_SDA);
+    PIND = (PIND & ~((1 << TWI_SCL) | (1 << TWI_SDA))) | pins;
+}
+
+// CPU cycles per SCL period: 16 + 2 * TWBR * 4^TWPS
+static uint64_t twi_bit_cycles(){
+    return 16 + 2 * (uint64_t)TWBR * (1 << (2 * (TWSR & 3)));
+}
+
+static void twi_status(uint8_t status, uint64_t cycles){
+    TWSR = (TWSR & 3) | status;
+    twi.done = now + cycles;
+}
+
+static void twi_control(uint8_t value){
+    twi.control = value & ((1 << TWEA) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE));
+
+    if(!(value & (1 << TWEN))){
+        twi.started = 0;
+        twi.done = SIM_NEVER;
+        twi.stop_done = 0;
+        return;
+    }
+    // writing TWINT clears it and starts the operation
+    if(!(value & (1 << TWINT)))
+        return;
+    twi.done = SIM_NEVER;
+
+    uint64_t bit = twi_bit_cycles();
+    if(value & (1 << TWSTO)){
+        // TWINT is not set after a stop
+        twi.started = 0;
+        twi.stops += 1;
+        twi.stop_done = now + 2 * bit;
+        return;
+    }
+    // the bus never becomes free and nothing completes
+    if(twi.sda_pulses > 0)
+        return;
+    if(twi.bus_errors > 0){
+        twi.bus_errors -= 1;
+        twi.started = 0;
+        twi_status(TW_BUS_ERROR, bit);
+        return;
+    }
+    if(value & (1 << TWSTA)){
+        twi_status(twi.started ? TW_REP_START : TW_START, bit);
+        twi.started = 1;
+        twi.address_next = 1;
+        return;
+    }
+    // not a master, nothing to send
+    if(!twi.started)
+        return;
+
+    if(twi.address_next){
+        twi.address_next = 0;
+        uint8_t address = TWDR >> 1;
+        twi.reading = TWDR & 1;
+        char ack = (address == MPU_ADDRESS && mpu.connected) || address == OLED_ADDRESS;
+        if(twi.nacks > 0){
+            twi.nacks -= 1;
+            ack = 0;
+        }
+        twi.slave = ack ? address : 0;
+        twi.pointer_next = 1;
+        if(twi.reading)
+            twi_status(ack ? TW_MR_SLA_ACK : TW_MR_SLA_NACK, 9 * bit);
+        else
+            twi_status(ack ? TW_MT_SLA_ACK : TW_MT_SLA_NACK, 9 * bit);
+        return;
+    }
+
+    if(!twi.reading){
+        if(twi.slave == MPU_ADDRESS){
+            if(twi.pointer_next)
+                mpu.pointer = TWDR & 0x7F;
+            else{
+                mpu.registers[mpu.pointer] = TWDR;
+                mpu.pointer = (mpu.pointer + 1) & 0x7F;
+            }
+            twi.pointer_next = 0;
+        }
+        else if(twi.slave == OLED_ADDRESS)
+            oled_bytes += 1;
+        twi_status(twi.slave ? TW_MT_DATA_ACK : TW_MT_DATA_NACK, 9 * bit);
+        return;
+    }
+
+    TWDR = 0xFF;
+    if(twi.slave == MPU_ADDRESS){
+        TWDR = mpu.registers[mpu.pointer];
+        mpu.pointer = (mpu.pointer + 1) & 0x7F;
+    }
+    twi_status((value & (1 << TWEA)) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK, 9 * bit);
+}
+
+static uint8_t twi_control_read(){
+    uint8_t value = twi.control;
+    if(now >= twi.done)
+        value |= (1 << TWINT);
+    if(now < twi.stop_done)
+        value |= (1 << TWSTO);
+    return value;
+}
+
+/*IR remote*/
+
+// End of the last IR frame queued, in cycles
+static uint64_t ir_queue_end = 0;
+
+// NEC frame gap and timing in microseconds. The decoder waits for 200 idle slots
+// (112.5 ms) before a frame.
+#define IR_IDLE_US 150000
+#define IR_SLOT_US 562.5
+
+static void ir_level(uint64_t at, int burst){
+    schedule_at(at, [burst](){
+        if(burst)
+            PINH &= ~(1 << PINH4);
+        else
+            PINH |= (1 << PINH4);
+    });
+}
+
+uint64_t sim_ir_button(char button){
+    int code = 0;
+    while(code < 256 && button_code_to_button(code) != button)
+        code += 1;
+    if(code == 256)
+        code = 0;
+
+    // address 0x00 and its complement, then the code and its complement, each sent
+    // in the order the decoder shifts them in
+    uint32_t frame = (0x00FFUL << 16) | ((uint32_t)code << 8) | (uint8_t)~code;
+
+    uint64_t t = now > ir_queue_end ? now : ir_queue_end;
+    t += IR_IDLE_US * SIM_CYCLES_PER_US;
+    const uint64_t slot = (uint64_t)(IR_SLOT_US * SIM_CYCLES_PER_US);
+
+    // 9 ms burst and 4.5 ms space
+    ir_level(t, 1);
+    t += 16 * slot;
+    ir_level(t, 0);
+    t += 8 * slot;
+    for(int k = 31; k >= 0; k--){
+        ir_level(t, 1);
+        t += slot;
+        ir_level(t, 0);
+        t += ((frame >> k) & 1) ? 3 * slot : slot;
+    }
+    // stop burst
+    ir_level(t, 1);
+    t += slot;
+    ir_level(t, 0);
+
+    ir_queue_end = t;
+    return t / SIM_CYCLES_PER_US;
+}
+
+/*Push button*/
+
+void sim_button(int pressed){
+    if(pressed)
+        PINE &= ~(1 << PINE4);
+    else
+        PINE |= (1 << PINE4);
+    // any edge interrupt
+    external_flags |= (1 << INTF4);
+    interrupt_hint = 1;
+}
+
+/*Display and tone*/
+
+#if DISPLAY_WIRING == 0
+static const uint8_t segment_pins[8] = {
+    pin(port_a, 0), pin(port_a, 1), pin(port_a, 2), pin(port_a, 3),
+    pin(port_a, 4), pin(port_a, 5), pin(port_a, 6), pin(port_a, 7)};
+static const uint8_t digit_pins[4] = {
+    pin(port_c, 0), pin(port_c, 1), pin(port_c, 2), pin(port_c, 3)};
+#else
+static const uint8_t segment_pins[8] = {
+    pin(port_f, 4), pin(port_f, 2), pin(port_l, 7), pin(port_l, 3),
+    pin(port_l, 1), pin(port_f, 3), pin(port_g, 1), pin(port_l, 5)};
+static const uint8_t digit_pins[4] = {
+    pin(port_f, 7), pin(port_f, 6), pin(port_f, 5), pin(port_k, 4)};
+#endif
+
+static uint8_t display_segments[4] = {0, 0, 0, 0};
+
+static int pin_level(uint8_t p, bool ddr){
+    return (pin_map::gpio_register(pin_map::port_of(p), ddr) >> pin_map::bit_of(p)) & 1;
+}
+
+// Records the segments of the digit selected by the refresh (its pin an output)
+static void capture_display(){
+    int selected = -1;
+    for(int k = 0; k < 4; k++){
+        if(pin_level(digit_pins[k], true)){
+            if(selected >= 0)
+                return;
+            selected = k;
+        }
+    }
+    if(selected < 0)
+        return;
+    uint8_t segments = 0;
+    for(int k = 0; k < 8; k++)
+        segments |= pin_level(segment_pins[k], false) << k;
+    display_segments[selected] = segments;
+}
+
+int sim_display_lit(){
+    for(int k = 0; k < 4; k++)
+        if(pin_level(digit_pins[k], true))
+            return 1;
+    return 0;
+}
+
+uint8_t sim_display_segments(int digit){
+    return display_segments[digit];
+}
+
+void sim_display_text(char text[5]){
+    static const uint8_t patterns[14] = {
+        0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x00, 0x39, 0x71, 0x40};
+    static const char characters[15] = "0123456789 CF-";
+    for(int digit = 0; digit < 4; digit++){
+        text[digit] = '?';
+        for(int k = 0; k < 14; k++)
+            if((display_segments[digit] & 0x7F) == patterns[k])
+                text[digit] = characters[k];
+    }
+    text[4] = 0;
+}
+
+int sim_am_pm_led(){
+    return (PORTH >> PORTH6) & 1;
+}
+
+int sim_alarm_led(){
+    return (PORTB >> PORTB4) & 1;
+}
+
+unsigned long sim_tone_hz(){
+    uint32_t divider = timer_divider(4);
+    if(!divider || !(TCCR4A & (1 << COM4C1)) || !(DDRH & (1 << DDH5)))
+        return 0;
+    return F_CPU / divider / (OCR4A + 1UL);
+}
+
+/*Virtual time*/
+
+// Lets the given number of cycles pass: timers count, scheduled actions run and
+// interrupts are taken as their flags are set
+static void advance(uint64_t cycles){
+    uint64_t target = now + cycles;
+    while(1){
+        dispatch_interrupts();
+        if(now >= target)
+            break;
+
+        if(target < next_event)
+            now = target;
+        else{
+            if(next_event > now)
+                now = next_event;
+            sync_timers();
+            while(!actions.empty() && actions.begin()->first <= now){
+                std::function<void()> action = actions.begin()->second;
+                actions.erase(actions.begin());
+                action();
+            }
+            recompute_next_event();
+        }
+
+        watch_bus_pins();
+        if(watchdog_timeout && now - watchdog_fed > watchdog_timeout){
+            watchdog_timeouts += 1;
+            watchdog_fed = now;
+        }
+    }
+}
+
+uint64_t sim_cycles(){
+    return now;
+}
+
+uint64_t sim_now_us(){
+    return now / SIM_CYCLES_PER_US;
+}
+
+/*Registers*/
+
+static std::string serial_output;
+static uint8_t adc_control = 0;
+
+const char * sim_serial_output(){
+    return serial_output.c_str();
+}
+
+uint16_t sim_register_read(simRegisterId id){
+    switch(id){
+        case sim_sreg:
+            return status_register;
+        case sim_twcr:
+            advance(SIM_POLL_CYCLES);
+            return twi_control_read();
+        case sim_tifr0: case sim_tifr1: case sim_tifr3: case sim_tifr4: case sim_tifr5:
+            return timers[id - sim_tifr0].flags;
+        case sim_tifr2:
+            // polled by the busy-wait delays
+            advance(SIM_POLL_CYCLES);
+            return timers[2].flags;
+        case sim_eifr:
+            return external_flags;
+        case sim_ucsr0a:
+            // the transmitter is always ready
+            return (1 << UDRE0) | (1 << TXC0);
+        case sim_udr0:
+            return 0;
+        case sim_adcsra:
+            // conversions are done at once
+            return adc_control;
+        case sim_tcnt0: case sim_tcnt1: case sim_tcnt2: case sim_tcnt3: case sim_tcnt4:
+        case sim_tcnt5:
+            return timer_count(id - sim_tcnt0);
+        default:
+            return 0;
+    }
+}
+
+void sim_register_write(simRegisterId id, uint16_t value){
+    next_event = now;
+    interrupt_hint = 1;
+    switch(id){
+        case sim_sreg:{
+            uint8_t previous = status_register;
+            status_register = value;
+            if(!(previous & (1 << SREG_I)) && (value & (1 << SREG_I)))
+                dispatch_interrupts();
+            break;
+        }
+        case sim_twcr:
+            twi_control(value);
+            break;
+        case sim_tifr0: case sim_tifr1: case sim_tifr2: case sim_tifr3: case sim_tifr4:
+        case sim_tifr5:
+            // flags are cleared by writing 1
+            timers[id - sim_tifr0].flags &= ~value;
+            break;
+        case sim_eifr:
+            external_flags &= ~value;
+            break;
+        case sim_udr0:
+            serial_output += (char)value;
+            break;
+        case sim_adcsra:
+            adc_control = value & ~(1 << ADSC);
+            break;
+        case sim_tcnt0: case sim_tcnt1: case sim_tcnt2: case sim_tcnt3: case sim_tcnt4:
+        case sim_tcnt5:
+            set_timer_count(id - sim_tcnt0, value);
+            break;
+        default:
+            break;
+    }
+}
+
+/*Firmware coroutine*/
+
+static ucontext_t scenario_context;
+static ucontext_t firmware_context;
+static char firmware_stack[1 << 20];
+static char booted = 0;
+static uint64_t run_until = 0;
+
+static void firmware_entry(){
+    firmware_main();
+    // the firmware never leaves its main loop
+    abort();
+}
+
+void sim_loop_point(){
+    watchdog_fed = now;
+    next_event = now;
+    interrupt_hint = 1;
+    advance(SIM_LOOP_CYCLES);
+    if(now >= run_until)
+        swapcontext(&firmware_context, &scenario_context);
+}
+
+void sim_boot(){
+    if(booted)
+        return;
+    booted = 1;
+
+    // inputs idle: no IR burst, button released, TWI lines pulled up
+    PINH |= (1 << PINH4);
+    PINE |= (1 << PINE4);
+    PIND |= (1 << TWI_SCL) | (1 << TWI_SDA);
+    // power-on reset
+    MCUSR = (1 << PORF);
+
+    sim_mpu_connect(mpu.connected);
+    sim_mpu_accel(0, 0, 16384);
+    sim_mpu_temperature(-3920);
+
+    getcontext(&firmware_context);
+    firmware_context.uc_stack.ss_sp = firmware_stack;
+    firmware_context.uc_stack.ss_size = sizeof(firmware_stack);
+    firmware_context.uc_link = 0;
+    makecontext(&firmware_context, firmware_entry, 0);
+
+    run_until = now;
+    swapcontext(&scenario_context, &firmware_context);
+}
+
+void sim_run_us(uint64_t us){
+    run_until = now + us * SIM_CYCLES_PER_US;
+    swapcontext(&scenario_context, &firmware_context);
+}
+
+void sim_run_ms(uint64_t ms){
+    sim_run_us(ms * 1000);
+}
@@ -0,0 +1,110 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <functional>
+#include <avr/interrupt.h>
+
+// Host simulator of the clock board, used by the native test environment. The
+// firmware is built unchanged against the register shims of sim/avr and runs in a
+// coroutine: its main() is started by sim_boot() and hands control back to the
+// scenario each time it feeds the watchdog once the requested virtual time has run.
+// Virtual time only moves while the firmware polls a register (TWI, delay timer) or
+// goes around the main loop (SIM_LOOP_CYCLES), interrupt routines take no time.
+// Timers are computed from their live registers (clock select, waveform mode, TOP,
+// power reduction) and their interrupts are taken in vector order whenever SREG_I
+// is set. The firmware only boots once per test program, the scenario steps of a
+// test suite follow each other.
+
+#define SIM_CYCLES_PER_US (F_CPU / 1000000UL)
+
+/*Running the firmware*/
+
+// Starts the firmware main() and runs it up to its first pass of the main loop
+void sim_boot();
+
+// Runs the firmware for the given virtual time
+void sim_run_us(uint64_t us);
+void sim_run_ms(uint64_t ms);
+
+// Virtual time since sim_boot() in CPU cycles and in microseconds
+uint64_t sim_cycles();
+uint64_t sim_now_us();
+
+// Runs action once the given virtual time has passed, between two instructions of
+// the firmware (an input changing, a device failing)
+void sim_schedule_us(uint64_t delay_us, std::function<void()> action);
+
+// Number of times an interrupt routine has run and watchdog timeouts (the watchdog
+// is counted, the firmware is not reset)
+unsigned long sim_isr_count(simVector vector);
+unsigned long sim_watchdog_timeouts();
+
+// Calls watch before (entering 1) and after (entering 0) every interrupt routine, to 
+// check what a routine changes. An empty function stops the calls.
+void sim_watch_interrupts(std::function<void(simVector vector, int entering)> watch);
+
+/*Inputs*/
+
+// Sends the NEC frame of a button of the remote ('0' to '9', 'M', 'R', ...) on the IR
+// input (PH4), after the frames already queued. Returns the virtual time in
+// microseconds at which the frame ends.
+uint64_t sim_ir_button(char button);
+
+// Presses (1) or releases (0) the push button on PE4
+void sim_button(int pressed);
+
+/*TWI bus and MPU-6050*/
+
+// Connects (1) or disconnects (0) the MPU-6050 at address 0x68. It starts asleep
+// (PWR_MGMT SLEEP bit) as after a power up. It is connected at boot unless it was
+// disconnected before sim_boot().
+void sim_mpu_connect(int connected);
+
+// Sets the raw accelerometer (16384 per g) and temperature readings of the MPU
+void sim_mpu_accel(int x, int y, int z);
+void sim_mpu_temperature(int raw);
+
+// Register of the MPU as last written by the firmware
+uint8_t sim_mpu_register(uint8_t address);
+
+// Address frames NACKed from now on, whatever the slave
+void sim_twi_nack(int frames);
+
+// TWI operations ending with a bus error (status 0x00) from now on
+void sim_twi_bus_error(int operations);
+
+// A slave holds SDA low until SCL has been pulsed the given number of times. The TWI
+// module cannot complete anything meanwhile.
+void sim_twi_hold_sda(int pulses);
+int sim_twi_sda_held();
+
+// Clock pulses driven by hand on SCL (bus recovery), stop conditions sent and bytes 
+// sent to the SSD1306
+unsigned long sim_twi_scl_pulses();
+unsigned long sim_twi_stops();
+unsigned long sim_oled_bytes();
+
+/*Outputs*/
+
+// Characters shown on the 4 digits of the 7-segment display (direct drive backend)
+// as last refreshed: '0' to '9', ' ', 'C', 'F', '-' or '?' for any other pattern
+void sim_display_text(char text[5]);
+
+// 1 while a digit is selected (direct drive backend)
+int sim_display_lit();
+
+// Segment pattern (DP,G,F,E,D,C,B,A) last refreshed on a digit
+uint8_t sim_display_segments(int digit);
+
+// 1 while the AM/PM (PH6) or alarm (PB4) LED is lit
+int sim_am_pm_led();
+int sim_alarm_led();
+
+// Characters sent on USART0 (trace dump)
+const char * sim_serial_output();
+
+// Frequency of the alarm tone on OC4C (PH5) in Hz, 0 when it is off
+unsigned long sim_tone_hz();
+
+#endif
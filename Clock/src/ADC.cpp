@@ -1,5 +1,6 @@
 #include <avr/io.h>
 #include "ADC.h"
+#include "power.h"
 
 
 // Initialize the ADC converter to use a reference voltage of VCC 
@@ -9,6 +10,9 @@
 // end of this configuration.
 void initADC(){
 
+    // Turn on the ADC
+    power_request(power_adc);
+
     // Set reference voltage to VCC (5V)
     ADMUX |=  (1 << REFS0);
     ADMUX &= ~(1 << REFS1);
@@ -51,4 +55,4 @@ int digital_read_A15(){
 
     return c;
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,24 +1,109 @@
 #include <avr/io.h>
-// #include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
 #include "I2C.h"
-#include <Arduino.h>
+#include "timer_config.h"
+#include "power.h"
+#include "clock.h"
+#include "boot.h"
+#include "trace.h"
+#include "display.h"
+#include "probe.h"
+#include "shake.h"
 
 #define SLA 0x68 // MPU address when AD0 grounded
 #define PWR_MGMT 0x6B // Power management register address
 #define WAKEUP 0x00 // PWR_MGMT value to wakeup MPU to normal operation mode
+#define PWR_MGMT_2 0x6C // Second power management register address, follows PWR_MGMT
+#define CYCLE 0x20 // PWR_MGMT bit that makes the MPU sleep between accelerometer samples
+#define LP_WAKE_1_25HZ 0x00 // PWR_MGMT_2 LP_WAKE_CTRL value (bits 7:6) for cycle mode samples at 1.25 Hz
+#define STBY_GYRO 0x07 // PWR_MGMT_2 STBY_XG, STBY_YG and STBY_ZG bits that put the gyroscope in standby
 #define SL_MEMA_XAX_HIGH 0x3B // register address for high nibble of X-axis acceleration sensor data 
 #define SL_MEMA_XAX_LOW 0x3C // register address for low nibble of X-axis acceleration sensor data 
 #define SL_MEMA_YAX_HIGH 0x3D // register address for high nibble of Y-axis acceleration sensor data 
 #define SL_MEMA_YAX_LOW 0x3E // register address for low nibble of Y-axis acceleration sensor data 
 #define SL_MEMA_ZAX_HIGH 0x3F // register address for high nibble of Z-axis acceleration sensor data 
 #define SL_MEMA_ZAX_LOW 0x40 // register address for low nibble of Z-axis acceleration sensor data 
+#define SL_TEMP_HIGH 0x41 // register address for high nibble of the die temperature sensor data 
+#define SL_TEMP_LOW 0x42 // register address for low nibble of the die temperature sensor data 
+
+// Bytes read in one burst by check_movement(): the 3 accelerometer axes, then the 
+// temperature (registers 0x3B to 0x42)
+#define MPU_BURST_BYTES 8
+
+// Weight of a new temperature reading in the moving average is 1/MPU_TEMP_SMOOTHING
+#define MPU_TEMP_SMOOTHING 16
+
+// Maximum number of polls of TWCR while waiting for the TWI hardware. One poll takes 
+// about 6 cycles, so 10000 polls is about 4 ms which is well above the 0.9 ms needed 
+// to shift one byte at 10 kHz.
+#define TWI_TIMEOUT 10000
+
+// SCL and SDA pins of the TWI module (PD0 and PD1) used for bus recovery
+#define TWI_SCL PORTD0
+#define TWI_SDA PORTD1
+
+// Delay timer (timer 2) period of 1 us
+typedef ctc_timer<DELAY_TIMER, period_us(1), 0> delay_timer;
+CLAIM_TIMER(DELAY_TIMER);
+
+// Delay before retrying to wake up the MPU after a failure. It doubles after every 
+// failure up to MPU_RETRY_MAX_US.
+#define MPU_RETRY_MIN_US 250000UL
+#define MPU_RETRY_MAX_US 8000000UL
+
+// Failed movement checks in a row after which the MPU is considered gone and is 
+// woken up again by poll_movement()
+#define MPU_MAX_FAILURES 10
+
+// Minutes before the alarm or a countdown goes off when the MPU is brought to full 
+// power, so movement is checked at full rate while it rings
+#define MPU_RAMP_MINUTES 2
+
+// Delay between movement checks in low power mode. The MPU samples at 1.25 Hz then, 
+// so polling faster only reads the same sample again.
+#define MPU_LOW_POWER_POLL_US 800000UL
+
+// Number of clock timer ticks (10 ms) since init_clock() (global variable in clock)
+extern volatile unsigned long clock_ticks;
+
+// 1 once the MPU has been woken up and answers
+volatile char mpu_ready = 0;
+// Power mode the MPU was last set to, mpu_off until it answers
+mpuMode mpu_mode = mpu_off;
+// Seconds spent in each mode since reset, and microseconds not yet counted since the 
+// time (clock_uptime_us()) of the last count
+unsigned long mpu_mode_seconds[mpu_mode_count] = {0, 0, 0};
+unsigned long mpu_mode_since = 0;
+// Time (clock_uptime_us()) of the next movement check in low power mode
+unsigned long mpu_next_poll = 0;
+// Failed movement checks in a row
+unsigned char mpu_failures = 0;
+// Time (clock_uptime_us()) of the next wake up attempt and the current retry delay
+unsigned long mpu_retry_time = 0;
+unsigned long mpu_retry_delay = MPU_RETRY_MIN_US;
+
+// Counters of TWI errors since reset
+volatile i2cErrors i2c_errors = {0, 0, 0, 0};
+
+// Exponential moving average of the MPU die temperature in 1/16 of a tenth of a 
+// degree Celsius, valid once temperature_readings is not 0
+int temperature_average = 0;
+unsigned char temperature_readings = 0;
+
+// 0 shows the temperature in degrees Celsius, 1 in degrees Fahrenheit
+volatile char temperature_unit = 0;
+
+// Digits shown on the display in show_temperature state, filled by 
+// update_temperature_display()
+volatile char temperature_display_digits [4] = {DIGIT_BLANK, DIGIT_BLANK, DIGIT_BLANK, DIGIT_BLANK};
 
 
 // Initializes the I2C module by waking it up and setting bitrate to 10kHz
 void InitI2C(){
 
     // Wake up I2C module on mega 2560
-    PRR0 &= ~(1 << PRTWI);
+    power_request(power_twi);
     
     // Set prescaler power TWPS to 1
     TWSR  |=  (1 << TWPS0);
@@ -29,25 +114,33 @@ void InitI2C(){
     
     // Enable I2C module
     TWCR = (1 << TWINT) | (1 << TWEN);
-    TCCR2A &= ~(1 << WGM10);
-    TCCR2A &= ~(1 << WGM11);
-    TCCR2B |= (1 << WGM12);
-    TCCR2B &= ~(1 << WGM13);
 
 }
 
+// Sets the bitrate of the bus to 100 kHz (fast not 0) or back to the 10 kHz of 
+// InitI2C(). Called between transactions only.
+void set_i2c_fast(char fast){
+
+    // 100 kHz: TWBR = (16 MHz/100kHz - 16) / (2 * 4 ^ 1)
+    TWBR = fast ? 18 : 198;
+}
+
 
 /* This delays the program an amount of microseconds specified by unsigned int delay.
 */
 void delayUs(unsigned int delay){
-    // Use prescaler 1, OCR1A = 15
+    // Turn on timer 2 for the length of the delay
+    power_request(power_timer2);
+
+    // Set timer 2 (delay timer) to CTC mode
+    TCCR2A &= ~(1 << WGM20);
+    TCCR2A |=  (1 << WGM21);
+    TCCR2B &= ~(1 << WGM22);
+
+    // Use prescaler 1, OCR2A = 15
     unsigned int count = 0;
-    TCCR2B |= (1 << CS10);
-    TCCR2B &= ~(1 << CS11);
-    TCCR2B &= ~(1 << CS12);
-    OCR2A = 15;
-    //OCR1AH = 0x00;
-    //OCR1AL = 0x02;
+    TCCR2B = (TCCR2B & ~((1<<CS22) | (1<<CS21) | (1<<CS20))) | delay_timer::cs_bits;
+    OCR2A = delay_timer::top;
     TIFR2 |= (1 << OCF2A);
     TCNT2 = 0;
     
@@ -58,16 +151,52 @@ void delayUs(unsigned int delay){
         }  
     }
     // turn off timer
-    TCCR2B &= ~ ((1<<CS12) | (1<<CS10) | (1<<CS11));
+    TCCR2B &= ~ ((1<<CS22) | (1<<CS20) | (1<<CS21));
+    power_release(power_timer2);
+}
+
+// Wait for the TWI hardware to finish its current operation and check that the 
+// status register holds the expected status code. Counts the error if it doesn't.
+i2cStatus wait_for_status(unsigned char expected){
+
+    // wait for completition, giving up after TWI_TIMEOUT polls
+    unsigned int polls = 0;
+    while(!(TWCR & (1 << TWINT))){
+        polls += 1;
+        if(polls == TWI_TIMEOUT){
+            i2c_errors.timeouts += 1;
+            trace(trace_i2c_error, (i2c_timeout << 8) | TW_STATUS);
+            return i2c_timeout;
+        }
+    }
+
+    unsigned char status = TW_STATUS;
+    if(status == expected)
+        return i2c_ok;
+
+    // a NACK from the slave for the address or data frames
+    if(status == TW_MT_SLA_NACK || status == TW_MT_DATA_NACK || status == TW_MR_SLA_NACK){
+        i2c_errors.nacks += 1;
+        trace(trace_i2c_error, (i2c_nack << 8) | status);
+        return i2c_nack;
+    }
+
+    // illegal start/stop, lost arbitration or any other unexpected state
+    i2c_errors.bus_errors += 1;
+    trace(trace_i2c_error, (i2c_bus_error << 8) | status);
+    return i2c_bus_error;
 }
+
 // Start I2C communication with a start condition and SLA + W address frame
-void StartI2C_Trans(unsigned char sla){
+i2cStatus StartI2C_Trans(unsigned char sla){
 
     // trigger a start
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTA);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    i2cStatus status = wait_for_status(TW_START);
+    if(status != i2c_ok)
+        return status;
 
     // write data SLA + W
     TWDR = (sla << 1) + 0x00;
@@ -76,7 +205,7 @@ void StartI2C_Trans(unsigned char sla){
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    return wait_for_status(TW_MT_SLA_ACK);
 
 }
 
@@ -84,11 +213,16 @@ void StartI2C_Trans(unsigned char sla){
 void StopI2C_Trans(){
     // trigger stop
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+
+    // wait for the stop condition to be sent so the next start is not lost
+    unsigned int polls = 0;
+    while((TWCR & (1 << TWSTO)) && polls < TWI_TIMEOUT)
+        polls += 1;
 }
 
 // write 8-bit data given in parameter data to the I2C data register 
 // to be sent to the I2C bus
-void write(unsigned char data){
+i2cStatus write(unsigned char data){
 
     // Write data in register to be sent to I2C
     TWDR = data;
@@ -97,26 +231,32 @@ void write(unsigned char data){
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    return wait_for_status(TW_MT_DATA_ACK);
 
 }
 
 
 // Read data from slave with address SLA at memory register address MEMADDRESS 
 // through the I2C bus using the read sub-protocol
-void Read_from(unsigned char sla, unsigned char MEMADDRESS){
+i2cStatus Read_from(unsigned char sla, unsigned char MEMADDRESS){
 
     // Start a transmission to the SLA
-    StartI2C_Trans(sla);
+    i2cStatus status = StartI2C_Trans(sla);
+    if(status != i2c_ok)
+        return status;
 
     // write the register being read
-    write(MEMADDRESS);
+    status = write(MEMADDRESS);
+    if(status != i2c_ok)
+        return status;
 
     // trigger a repeated start
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTA);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    status = wait_for_status(TW_REP_START);
+    if(status != i2c_ok)
+        return status;
 
     // SLA + R
     TWDR = (sla << 1) + 0x01;
@@ -125,17 +265,78 @@ void Read_from(unsigned char sla, unsigned char MEMADDRESS){
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    status = wait_for_status(TW_MR_SLA_ACK);
+    if(status != i2c_ok)
+        return status;
     
+    // trigger (no acknowledge as this is the only byte read)
+    TWCR = (1 << TWINT) | (1 << TWEN);
+
+    // wait for completition
+    status = wait_for_status(TW_MR_DATA_NACK);
+    if(status != i2c_ok)
+        return status;
+
+    // trigger a stop
+    StopI2C_Trans();
+
+    return i2c_ok;
+}
+
+// Read count bytes from slave with address SLA starting at memory register address 
+// MEMADDRESS into data in one transaction, the slave incrementing the register address 
+// after each byte. Every byte but the last is acknowledged.
+i2cStatus Read_burst(unsigned char sla, unsigned char MEMADDRESS, unsigned char * data, 
+    unsigned char count){
+
+    // Start a transmission to the SLA
+    i2cStatus status = StartI2C_Trans(sla);
+    if(status != i2c_ok)
+        return status;
+
+    // write the first register being read
+    status = write(MEMADDRESS);
+    if(status != i2c_ok)
+        return status;
+
+    // trigger a repeated start
+    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTA);
+
+    // wait for completition
+    status = wait_for_status(TW_REP_START);
+    if(status != i2c_ok)
+        return status;
+
+    // SLA + R
+    TWDR = (sla << 1) + 0x01;
+
     // trigger
     TWCR = (1 << TWINT) | (1 << TWEN);
 
     // wait for completition
-    while(!(TWCR & (1 << TWINT)));
+    status = wait_for_status(TW_MR_SLA_ACK);
+    if(status != i2c_ok)
+        return status;
+
+    for(unsigned char k = 0; k < count; k++){
+        // trigger, acknowledging all bytes but the last so the slave sends the next one
+        if(k < count - 1){
+            TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWEA);
+            status = wait_for_status(TW_MR_DATA_ACK);
+        }
+        else{
+            TWCR = (1 << TWINT) | (1 << TWEN);
+            status = wait_for_status(TW_MR_DATA_NACK);
+        }
+        if(status != i2c_ok)
+            return status;
+        data[k] = TWDR;
+    }
 
     // trigger a stop
-    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+    StopI2C_Trans();
 
+    return i2c_ok;
 }
 
 // Load 8-bit data from the I2C data register
@@ -143,69 +344,263 @@ unsigned char Read_data(){
     return TWDR;
 }
 
+// Recover the bus from a slave holding SDA low in the middle of a byte. The TWI module 
+// is turned off and SCL is clocked 9 times by hand so the slave can finish shifting out 
+// its byte, then a stop condition is generated and the TWI module is reinitialized.
+// SCL and SDA are driven as open drain: low by making the pin an output (PORT is 0), 
+// high by making it an input and letting the pull-up resistors raise the line.
+void recover_i2c_bus(){
+
+    i2c_errors.recoveries += 1;
+
+    // Turn off the TWI module so SCL and SDA can be used as plain I/O pins
+    TWCR = 0;
+    PORTD &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+    DDRD  &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+
+    // 9 clock pulses at about 50 kHz, stopping early once the slave releases SDA
+    for(int k = 0; k < 9; k++){
+        if(PIND & (1 << TWI_SDA))
+            break;
+        DDRD |= (1 << TWI_SCL);
+        delayUs(10);
+        DDRD &= ~(1 << TWI_SCL);
+        delayUs(10);
+    }
+
+    // Stop condition: SDA rises while SCL is high
+    DDRD |= (1 << TWI_SDA);
+    delayUs(10);
+    DDRD &= ~(1 << TWI_SDA);
+    delayUs(10);
+
+    // InitI2C() requests the TWI module again
+    power_release(power_twi);
+    InitI2C();
+}
+
 
-// Wake up MPU chip by writing WAKEUP value to PWR_MGMT register address
-void InitMPU(){
-    StartI2C_Trans(SLA);
-    write(PWR_MGMT);
-    write(WAKEUP);
+// Wake up MPU chip by writing WAKEUP value to PWR_MGMT register address. 
+// Returns 1 if the MPU acknowledged the write and 0 otherwise.
+int InitMPU(){
+    i2cStatus status = StartI2C_Trans(SLA);
+    if(status == i2c_ok)
+        status = write(PWR_MGMT);
+    if(status == i2c_ok)
+        status = write(WAKEUP);
     StopI2C_Trans();
 
-    // Initialize USB communication to print sensor readings to computer console
-    //  Serial.begin(9600);
+    // A timeout or a bus error can leave the bus stuck, so clear it for the next attempt
+    if(status == i2c_timeout || status == i2c_bus_error)
+        recover_i2c_bus();
+
+    return status == i2c_ok;
 }
 
-// Uses the MPU readings to check for movement
-int check_movement() {
+// Sets the MPU power mode by writing PWR_MGMT and PWR_MGMT_2 in one transaction. In 
+// low power mode only the accelerometer runs, waking up at 1.25 Hz, and the gyroscope 
+// is in standby. Returns 1 if the MPU acknowledged the writes and 0 otherwise.
+int set_mpu_mode(mpuMode mode){
+    unsigned char pwr_mgmt = WAKEUP;
+    unsigned char pwr_mgmt_2 = 0x00;
+    if(mode == mpu_low_power){
+        pwr_mgmt = CYCLE;
+        pwr_mgmt_2 = LP_WAKE_1_25HZ | STBY_GYRO;
+    }
 
-    int x_reading, y_reading, z_reading;
-    
-    // Read MSb half the of the accelerometer value for the x axis
-    Read_from(SLA, SL_MEMA_XAX_HIGH);
-    // Load the data into x_reading
-    x_reading = Read_data();
-    // Read LSb half the of the accelerometer value for the x axis
-    Read_from(SLA, SL_MEMA_XAX_LOW);
-    // Load and concatenate the LSb data with the MSb data into x_reading
-    x_reading = (x_reading << 8) + Read_data();
-
-    // Read MSb half the of the accelerometer value for the y axis
-    Read_from(SLA, SL_MEMA_YAX_HIGH);
-    // Load the data into y_reading
-    y_reading = Read_data();
-    // Read LSb half the of the accelerometer value for the y axis
-    Read_from(SLA, SL_MEMA_YAX_LOW);
-    // Load and concatenate the LSb data with the MSb data into y_reading
-    y_reading = (y_reading << 8) + Read_data();
-
-    // Read MSb half the of the accelerometer value for the z axis
-    Read_from(SLA, SL_MEMA_ZAX_HIGH);
-    // Load the data into z_reading
-    z_reading = Read_data();
-    // Read LSb half the of the accelerometer value for the z axis
-    Read_from(SLA, SL_MEMA_ZAX_LOW);
-    // Load and concatenate the LSb data with the MSb data into z_reading
-    z_reading = (z_reading << 8) + Read_data();
-
-    // stop the I2C transmission
+    i2cStatus status = StartI2C_Trans(SLA);
+    if(status == i2c_ok)
+        status = write(PWR_MGMT);
+    if(status == i2c_ok)
+        status = write(pwr_mgmt);
+    if(status == i2c_ok)
+        status = write(pwr_mgmt_2);
     StopI2C_Trans();
 
-    //Print all three readings to the computer console though the USB
-    // Serial.print("X_READING = ");
-    // Serial.println(x_reading);
-    // Serial.print("Y_READING = ");
-    // Serial.println(y_reading);
-    // Serial.print("Z_READING = ");
-    // Serial.println(z_reading);
-    // Serial.println("");
-    // Serial.flush();
+    if(status == i2c_timeout || status == i2c_bus_error)
+        recover_i2c_bus();
+
+    return status == i2c_ok;
+}
+
+// Counts a failed MPU transaction. After too many failures in a row, the MPU may have 
+// been reset or replaced so it is woken up again and its mode set again.
+static void count_mpu_failure(){
+    mpu_failures += 1;
+    if(mpu_failures == MPU_MAX_FAILURES){
+        mpu_ready = 0;
+        mpu_mode = mpu_off;
+    }
+}
+
+// Adds the time elapsed since the last count to the seconds of the current MPU mode
+static void account_mpu_mode(unsigned long now){
+    unsigned long seconds = (now - mpu_mode_since) / 1000000UL;
+    mpu_mode_seconds[mpu_mode] += seconds;
+    mpu_mode_since += seconds * 1000000UL;
+}
+
+// Returns the number of seconds the MPU has spent in a power mode since reset
+unsigned long get_mpu_mode_time(mpuMode mode){
+    return mpu_mode_seconds[mode];
+}
+
+// Adds a reading of the MPU temperature sensor (raw register value) to the moving 
+// average. The MPU gives raw/340 + 36.53 degrees Celsius, so in tenths of a degree 
+// it is raw/34 + 365.
+void add_temperature_reading(int raw){
+
+    int tenths = raw / 34 + 365;
+
+    // the first reading starts the average
+    if(temperature_readings == 0){
+        temperature_average = tenths * 16;
+        temperature_readings = 1;
+    }
+    else
+        temperature_average += (tenths * 16 - temperature_average) / MPU_TEMP_SMOOTHING;
+}
+
+// Returns the time in milliseconds from the clock ticks, wrapping at 65536 ms. The 
+// product wraps at 2^32, a multiple of 65536, so the time never jumps. The uptime in 
+// microseconds divided by 1000 would jump when the uptime wraps (every 71 minutes).
+static unsigned int tick_ms(){
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long ticks = clock_ticks;
+    SREG = sreg;
+    return (unsigned int)(ticks * TIMER_WHEEL_TICK_MS);
+}
+
+// Feeds the MPU readings to the shake classifier and returns the gesture it finds: 
+// a tap or a shake. A failed transaction is reported as no gesture. The temperature 
+// is read in the same transaction and added to its moving average.
+shakeGesture check_movement() {
+
+    unsigned char data[MPU_BURST_BYTES];
+    i2cStatus status = Read_burst(SLA, SL_MEMA_XAX_HIGH, data, MPU_BURST_BYTES);
+
+    if(status != i2c_ok){
+        // Read_burst() only stops the I2C transmission when it succeeds
+        StopI2C_Trans();
+
+        // clear a stuck bus, a NACK only means the MPU is not there right now
+        if(status != i2c_nack)
+            recover_i2c_bus();
+
+        count_mpu_failure();
+        return shake_none;
+    }
+    mpu_failures = 0;
+
+    // Concatenate the MSb and LSb halves of each value
+    int x_reading = (int)(((unsigned int)data[0] << 8) | data[1]);
+    int y_reading = (int)(((unsigned int)data[2] << 8) | data[3]);
+    add_temperature_reading((int)(((unsigned int)data[6] << 8) | data[7]));
+
     delayUs(1000);
-    // check if any of the sensor data show movement
-    if (-3000 > x_reading || 3000 < x_reading
-        || -3000 > y_reading || 3000 < y_reading){
-        return 1;
+    // tell a tap from a shake over the peaks of the sensor data
+    return shake_feed(x_reading, y_reading, tick_ms());
+}
+
+// Returns the moving average of the MPU die temperature in tenths of a degree Celsius 
+// and 1, or 0 if there is no reading yet.
+int get_temperature(int * tenths){
+
+    if(temperature_readings == 0)
+        return 0;
+    *tenths = temperature_average / 16;
+    return 1;
+}
+
+// Fills temperature_display_digits with the temperature rounded to a degree and 
+// followed by C or F (temperature_unit), or with dashes if there is no reading yet
+void update_temperature_display(){
+
+    int tenths;
+    if(!get_temperature(&tenths)){
+        temperature_display_digits[0] = DIGIT_MINUS;
+        temperature_display_digits[1] = DIGIT_MINUS;
+        temperature_display_digits[2] = DIGIT_MINUS;
+        temperature_display_digits[3] = temperature_unit ? DIGIT_F : DIGIT_C;
+        return;
+    }
+
+    // F = C*9/5 + 32
+    if(temperature_unit)
+        tenths = tenths * 9 / 5 + 320;
+
+    // round to a degree
+    int degrees = (tenths >= 0) ? (tenths + 5) / 10 : (tenths - 5) / 10;
+
+    // hundreds digit (up to 185 F) or minus sign, then blank leading zeros
+    int magnitude = degrees < 0 ? -degrees : degrees;
+    if(degrees < 0)
+        temperature_display_digits[0] = DIGIT_MINUS;
+    else if(magnitude >= 100)
+        temperature_display_digits[0] = (magnitude / 100) % 10;
+    else
+        temperature_display_digits[0] = DIGIT_BLANK;
+
+    if(magnitude >= 10)
+        temperature_display_digits[1] = (magnitude / 10) % 10;
+    else
+        temperature_display_digits[1] = DIGIT_BLANK;
+
+    temperature_display_digits[2] = magnitude % 10;
+    temperature_display_digits[3] = temperature_unit ? DIGIT_F : DIGIT_C;
+}
+
+// Brings up the MPU in the background and checks it for movement once it is up. 
+// Wake up attempts are retried with a growing delay so a missing MPU costs one short 
+// bus transaction every few seconds. The MPU runs in low power mode and is checked 
+// every MPU_LOW_POWER_POLL_US unless the alarm rings or goes off within 
+// MPU_RAMP_MINUTES, then it runs at full power and is checked on every call. 
+// Returns the gesture found by check_movement(), shake_none if none.
+shakeGesture poll_movement(){
+    PROBE_SCOPE(probe_movement);
+
+    unsigned long now = clock_uptime_us();
+    account_mpu_mode(now);
+
+    if(mpu_ready){
+        mpuMode wanted = alarm_imminent(MPU_RAMP_MINUTES) ? mpu_full_power : mpu_low_power;
+        if(wanted != mpu_mode){
+            // on a failure the mode is set again on the next call
+            if(!set_mpu_mode(wanted)){
+                count_mpu_failure();
+                return shake_none;
+            }
+            mpu_mode = wanted;
+            mpu_next_poll = now;
+            // peaks seen at the other rate do not belong to the same gesture
+            shake_reset();
+            trace(trace_mpu_mode, wanted);
+        }
+
+        if(mpu_mode == mpu_low_power){
+            // difference handles the wrap of the uptime
+            if((long)(now - mpu_next_poll) < 0)
+                return shake_none;
+            mpu_next_poll = now + MPU_LOW_POWER_POLL_US;
+        }
+        return check_movement();
+    }
+
+    // wait for the next attempt (difference handles the wrap of the uptime)
+    if((long)(now - mpu_retry_time) < 0)
+        return shake_none;
+
+    if(InitMPU()){
+        mpu_ready = 1;
+        mpu_failures = 0;
+        mpu_retry_delay = MPU_RETRY_MIN_US;
+        record_boot_phase(boot_mpu);
     }
     else{
-        return 0;
+        mpu_retry_time = now + mpu_retry_delay;
+        if(mpu_retry_delay < MPU_RETRY_MAX_US)
+            mpu_retry_delay *= 2;
     }
-}
\ No newline at end of file
+    return shake_none;
+}
@@ -1,13 +1,89 @@
 #ifndef I2C_H
 #define I2C_H 
 
+#include "shake.h"
+
+// Result of a TWI operation. Timeouts and bus errors may leave the bus stuck and call 
+// for recover_i2c_bus(), a NACK means the slave did not answer.
+typedef enum i2cStatus_enum {
+    i2c_ok, i2c_timeout, i2c_nack, i2c_bus_error}
+i2cStatus;
+
+// Power mode of the MPU. In low power mode only the accelerometer runs, sampling at 
+// 1.25 Hz, and the gyroscope is in standby.
+typedef enum mpuMode_enum {
+    mpu_off, mpu_low_power, mpu_full_power, mpu_mode_count}
+mpuMode;
+
+// Counters of TWI errors since reset
+typedef struct i2cErrors_struct {
+    unsigned int timeouts;
+    unsigned int nacks;
+    unsigned int bus_errors;
+    unsigned int recoveries;
+} i2cErrors;
+
+extern volatile i2cErrors i2c_errors;
+
 // Initializes the I2C module by waking it up and setting bitrate to 10kHz
 void InitI2C();
 
-// Wake up MPU chip by writing WAKEUP value to PWR_MGMT register address
-void InitMPU();
+// Sets the bitrate of the bus to 100 kHz (fast not 0) or back to the 10 kHz of 
+// InitI2C(). Called between transactions only.
+void set_i2c_fast(char fast);
+
+// Recover the bus from a slave holding SDA low by clocking out 9 SCL pulses and 
+// sending a stop condition, then reinitialize the I2C module.
+void recover_i2c_bus();
+
+// Start I2C communication with a start condition and SLA + W address frame
+i2cStatus StartI2C_Trans(unsigned char sla);
+
+// stop I2C communications with a stop condition
+void StopI2C_Trans();
+
+// write 8-bit data given in parameter data to the I2C data register 
+// to be sent to the I2C bus
+i2cStatus write(unsigned char data);
+
+// Wake up MPU chip by writing WAKEUP value to PWR_MGMT register address. 
+// Returns 1 if the MPU acknowledged the write and 0 otherwise.
+int InitMPU();
+
+// Sets the MPU power mode by writing PWR_MGMT and PWR_MGMT_2 in one transaction. In 
+// low power mode only the accelerometer runs, waking up at 1.25 Hz, and the gyroscope 
+// is in standby. Returns 1 if the MPU acknowledged the writes and 0 otherwise.
+int set_mpu_mode(mpuMode mode);
+
+// Returns the number of seconds the MPU has spent in a power mode since reset
+unsigned long get_mpu_mode_time(mpuMode mode);
+
+// Feeds the MPU readings to the shake classifier and returns the gesture it finds: 
+// a tap or a shake. A failed transaction is reported as no gesture. The temperature 
+// is read in the same transaction and added to its moving average.
+shakeGesture check_movement();
+
+// 0 shows the temperature in degrees Celsius, 1 in degrees Fahrenheit
+extern volatile char temperature_unit;
+
+// Digits shown on the display in show_temperature state, filled by 
+// update_temperature_display()
+extern volatile char temperature_display_digits [4];
+
+// Returns the moving average of the MPU die temperature in tenths of a degree Celsius 
+// and 1, or 0 if there is no reading yet.
+int get_temperature(int * tenths);
+
+// Fills temperature_display_digits with the temperature rounded to a degree and 
+// followed by C or F (temperature_unit), or with dashes if there is no reading yet
+void update_temperature_display();
 
-// Uses the MPU readings to check for movement
-int check_movement();
+// Brings up the MPU in the background and checks it for movement once it is up. 
+// Wake up attempts are retried with a growing delay so a missing MPU costs one short 
+// bus transaction every few seconds. The MPU runs in low power mode and is checked 
+// every MPU_LOW_POWER_POLL_US unless the alarm rings or goes off within 
+// MPU_RAMP_MINUTES, then it runs at full power and is checked on every call. 
+// Returns the gesture found by check_movement(), shake_none if none.
+shakeGesture poll_movement();
 
-#endif
\ No newline at end of file
+#endif
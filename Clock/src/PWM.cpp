@@ -1,12 +1,50 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include "PWM.h"
+#include "timer_config.h"
+#include "power.h"
+#include "trace.h"
+#include "probe.h"
 
 #define CLKFREQ 16000000
 #define DEFAULT_FREQUENCY 15000
 
-// current alarm frequency
-int alarm_freq = 1000;
+// Alarm tone timer (timer 4) with a prescaler of 1, its TOP sets the tone frequency
+typedef prescaled_timer<PWM_TIMER, 1> pwm_timer;
+CLAIM_TIMER(PWM_TIMER);
+
+// Chirp timer (timer 5) in normal mode with a prescaler of 1, so the compare A 
+// interrupt fires once per 65536 cycles (4.096 ms)
+typedef overflow_timer<CHIRP_TIMER, period_us(4096), 0> chirp_timer;
+CLAIM_TIMER(CHIRP_TIMER);
+
+// TOP of timer 4 (OCR4A) for a tone frequency
+#define TONE_TOP(frequency) (CLKFREQ / pwm_timer::divider / (frequency) - 1)
+
+// Chirp of the alarm: the tone goes up from 1050 Hz to 4000 Hz in 50 Hz steps, one 
+// step per timer 5 interrupt, then starts over. The TOP values are worked out by the 
+// compiler so the interrupt does no division.
+#define CHIRP_STEPS 60
+const uint16_t chirp_tops[CHIRP_STEPS] PROGMEM = {
+    TONE_TOP(1050), TONE_TOP(1100), TONE_TOP(1150), TONE_TOP(1200), TONE_TOP(1250), 
+    TONE_TOP(1300), TONE_TOP(1350), TONE_TOP(1400), TONE_TOP(1450), TONE_TOP(1500), 
+    TONE_TOP(1550), TONE_TOP(1600), TONE_TOP(1650), TONE_TOP(1700), TONE_TOP(1750), 
+    TONE_TOP(1800), TONE_TOP(1850), TONE_TOP(1900), TONE_TOP(1950), TONE_TOP(2000), 
+    TONE_TOP(2050), TONE_TOP(2100), TONE_TOP(2150), TONE_TOP(2200), TONE_TOP(2250), 
+    TONE_TOP(2300), TONE_TOP(2350), TONE_TOP(2400), TONE_TOP(2450), TONE_TOP(2500), 
+    TONE_TOP(2550), TONE_TOP(2600), TONE_TOP(2650), TONE_TOP(2700), TONE_TOP(2750), 
+    TONE_TOP(2800), TONE_TOP(2850), TONE_TOP(2900), TONE_TOP(2950), TONE_TOP(3000), 
+    TONE_TOP(3050), TONE_TOP(3100), TONE_TOP(3150), TONE_TOP(3200), TONE_TOP(3250), 
+    TONE_TOP(3300), TONE_TOP(3350), TONE_TOP(3400), TONE_TOP(3450), TONE_TOP(3500), 
+    TONE_TOP(3550), TONE_TOP(3600), TONE_TOP(3650), TONE_TOP(3700), TONE_TOP(3750), 
+    TONE_TOP(3800), TONE_TOP(3850), TONE_TOP(3900), TONE_TOP(3950), TONE_TOP(4000)};
+
+// current step of the chirp
+unsigned char chirp_step = 0;
+
+// 1 while the alarm timers are running and powered
+char alarm_sounding = 0;
 
 // Initialize (PH5) to be a Fast non-inverting mode PWM 
 // output for timer 4 (OC4C) with a variable TOP (OC4RA) with a prescaler 
@@ -15,35 +53,38 @@ int alarm_freq = 1000;
 // the frequency of the alarm to create a chirping noise.
 void initPWM(){
 
+    // Turn on timers 4 and 5 to configure them
+    power_request(power_timer4);
+    power_request(power_timer5);
+    alarm_sounding = 1;
+
     // Set PH5 be an output pin
     DDRH |= (1 << DDH5);
 
     // Set Timer 4 to Fast PWM 10-bit mode, non-inverting with prescaler of 1
     TCCR4A |= (1 << COM4C1)|(1 << WGM41)|(1 << WGM40);
-    TCCR4B |= (1 << WGM42)|(1 << CS40) | (1 << WGM43);
-
-    // turn off alarm by default
-    turn_off_alarm();
+    TCCR4B |= (1 << WGM42) | (1 << WGM43) | pwm_timer::cs_bits;
 
     // default frequency of 15 kHz with 50% duty cycle
     SetPWMfrequency(DEFAULT_FREQUENCY);
 
-    // Set timer 5 prescaler to 1 in normal mode
-    TCCR5B |= (1 << CS50);
-
     // Enable timer 5 comp A interrupt
     TIMSK5 |= (1 << OCIE5A);
 
     // Set timer 5 compare value to this custom value for chiping noise
     OCR5A = 5000;
 
+    // turn off alarm by default, timer 5 (prescaler 1 in normal mode) is started 
+    // with the alarm. This also turns off the clock of both timers.
+    turn_off_alarm();
+
 }
 
 // Set PWM frequency by changing top of PWM counter (prescaler is 1) based on 
 // frequency given thorugh frequency parameter. Duty cycle is maintained at 50% by 
 // setting PWM toggle counter value to half of TOP (values are rounded).
 void SetPWMfrequency(unsigned int frequency){
-    OCR4A = (int) (CLKFREQ / frequency) - 1;
+    OCR4A = (int) TONE_TOP(frequency);
     OCR4C = (int) (OCR4A/2);
 }
 
@@ -51,28 +92,48 @@ void SetPWMfrequency(unsigned int frequency){
 // turns off alarm by turning off output pin and deactivating timers
 void turn_off_alarm(){
 
+    if(!alarm_sounding)
+        return;
+
     DDRH &= ~(1 << DDH5);
     TCCR4A &= ~(1 << COM4C1);
-    TCCR4B &= ~(1 << CS40);
-    TCCR5B &= ~(1 << CS50);
+    TCCR4B &= ~pwm_timer::cs_bits;
+    TCCR5B &= ~chirp_timer::cs_bits;
+
+    // the timers keep their configuration while their clock is off
+    power_release(power_timer4);
+    power_release(power_timer5);
+    alarm_sounding = 0;
+    trace(trace_alarm_off, 0);
 
 }
 
 // turns on alarm by turning on output pin and activating timers
 void turn_on_alarm(){
 
+    if(alarm_sounding)
+        return;
+
+    power_request(power_timer4);
+    power_request(power_timer5);
+    alarm_sounding = 1;
+    trace(trace_alarm_on, 0);
+
     DDRH |= (1 << DDH5);
     TCCR4A |= (1 << COM4C1);
-    TCCR4B |= (1 << CS40);
-    TCCR5B |= (1 << CS50);
+    TCCR4B |= pwm_timer::cs_bits;
+    TCCR5B |= chirp_timer::cs_bits;
 
 }
 
 // Interrupt routine for timer 5 which handles changing the frequency of the alarm 
-// to create a chirping noise.
+// to create a chirping noise. Reads the next TOP from chirp_tops, with no division.
 ISR(TIMER5_COMPA_vect){
-    alarm_freq += 50;
-    SetPWMfrequency(alarm_freq);
-    if(alarm_freq == 4000)
-        alarm_freq = 1000;
-}
\ No newline at end of file
+    PROBE_SCOPE(probe_chirp_isr);
+    unsigned int top = pgm_read_word(&chirp_tops[chirp_step]);
+    OCR4A = top;
+    OCR4C = top / 2;
+    chirp_step += 1;
+    if(chirp_step == CHIRP_STEPS)
+        chirp_step = 0;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "boot.h"
+#include "clock.h"
+
+// Time in microseconds since init_clock() at which each boot phase was reached
+volatile unsigned long boot_timestamps[boot_phase_count] = {
+    BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, 
+    BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, BOOT_PHASE_PENDING, 
+    BOOT_PHASE_PENDING};
+
+// Records the time (microseconds since init_clock()) at which a boot phase is reached. 
+// Only the first time a phase is reached is kept.
+void record_boot_phase(bootPhase phase){
+
+    // also called from the display timer interrupt (first frame)
+    unsigned char sreg = SREG;
+    cli();
+    if(boot_timestamps[phase] == BOOT_PHASE_PENDING)
+        boot_timestamps[phase] = clock_uptime_us();
+    SREG = sreg;
+}
+
+// Returns the time in microseconds since init_clock() at which a boot phase was 
+// reached, BOOT_PHASE_PENDING if it was not reached yet
+unsigned long get_boot_timestamp(bootPhase phase){
+
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long timestamp = boot_timestamps[phase];
+    SREG = sreg;
+    return timestamp;
+}
@@ -0,0 +1,22 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+// Phases of the boot sequence in the order they are reached. The display and clock 
+// come up first, the MPU is brought up in the background from the main loop.
+typedef enum bootPhase_enum {
+    boot_clock, boot_display, boot_interrupts, boot_first_frame, boot_remote, boot_alarm, 
+    boot_i2c, boot_main_loop, boot_mpu, boot_phase_count}
+bootPhase;
+
+// Timestamp of a phase that has not been reached yet
+#define BOOT_PHASE_PENDING 0xFFFFFFFF
+
+// Records the time (microseconds since init_clock()) at which a boot phase is reached. 
+// Only the first time a phase is reached is kept.
+void record_boot_phase(bootPhase phase);
+
+// Returns the time in microseconds since init_clock() at which a boot phase was 
+// reached, BOOT_PHASE_PENDING if it was not reached yet
+unsigned long get_boot_timestamp(bootPhase phase);
+
+#endif
@@ -0,0 +1,169 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "calendar.h"
+
+// Transition of a DST rule: on the given week (1 to 4, 5 is the last week) and day of 
+// the week of a month, at the given clock hour (local time before the transition). 
+// A month of 0 means no transition.
+typedef struct dstRule_struct {
+    unsigned char month;
+    unsigned char week;
+    weekdayType day;
+    char hour;
+} dstRule;
+
+// DST start (clock moves forward an hour) and end (clock moves back an hour) of a 
+// time zone
+typedef struct dstZone_struct {
+    dstRule start;
+    dstRule end;
+} dstZone;
+
+// DST rules of the time zones selected by DST_ZONE. Only the selected entry is used 
+// and it is read by the compiler, so the table takes no space in the firmware.
+constexpr dstZone dst_zones[] = {
+    // 0: no DST
+    {{0, 0, sunday, 0}, {0, 0, sunday, 0}},
+    // 1: United States and Canada, second Sunday of March 2:00 to first Sunday of 
+    // November 2:00
+    {{3, 2, sunday, 2}, {11, 1, sunday, 2}},
+    // 2: European Union (Central European Time), last Sunday of March 2:00 to last 
+    // Sunday of October 3:00
+    {{3, 5, sunday, 2}, {10, 5, sunday, 3}},
+    // 3: South-eastern Australia, first Sunday of October 2:00 to first Sunday of 
+    // April 3:00
+    {{10, 1, sunday, 2}, {4, 1, sunday, 3}},
+};
+
+static_assert(DST_ZONE < sizeof(dst_zones) / sizeof(dst_zones[0]), "DST_ZONE is not in dst_zones");
+constexpr dstZone dst_zone = dst_zones[DST_ZONE];
+
+// Current date in days since 2000-01-01, advanced by the clock timer interrupt at 
+// day rollover
+volatile unsigned int day_number = days_from_civil(INITIAL_YEAR, INITIAL_MONTH, INITIAL_DAY);
+
+// 1 while daylight saving time is in effect
+volatile char dst_active = 0;
+
+// Clock hour (24hr time) of the DST transition happening today, -1 if there is none, 
+// and the number of hours the clock moves by then
+volatile signed char dst_transition_hour = -1;
+volatile signed char dst_transition_shift = 0;
+
+// Converts a number of days since 2000-01-01 to year, month and day, in constant time. 
+// Years are counted from March so the leap day is at the end of the year.
+civilDate civil_from_days(unsigned int days){
+
+    long shifted_days = days + calendar::epoch_offset;
+    long era = shifted_days / 146097;
+    long day_of_era = shifted_days - era * 146097;
+    long year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - 
+        day_of_era / 146096) / 365;
+    long day_of_year = day_of_era - (year_of_era * 365 + year_of_era / 4 - year_of_era / 100);
+    long shifted_month = (5 * day_of_year + 2) / 153;
+
+    civilDate date;
+    date.day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    date.month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    date.year = year_of_era + era * 400 + (date.month <= 2);
+    return date;
+}
+
+// Day of the week of a number of days since 2000-01-01 (a Saturday)
+weekdayType weekday(unsigned int days){
+    return (weekdayType)((days + saturday) % 7);
+}
+
+// Day (days since 2000-01-01) of the transition of a DST rule in the given year
+static unsigned int transition_day(const dstRule & rule, unsigned int year){
+
+    // last week: go back from the last day of the month to the day of the week
+    if(rule.week == 5){
+        unsigned int last = (rule.month == 12) ? days_from_civil(year + 1, 1, 1) - 1 : 
+            days_from_civil(year, rule.month + 1, 1) - 1;
+        return last - (weekday(last) - rule.day + 7) % 7;
+    }
+
+    // otherwise go forward from the first day of the month to the day of the week
+    unsigned int first = days_from_civil(year, rule.month, 1);
+    return first + (rule.day - weekday(first) + 7) % 7 + (rule.week - 1) * 7;
+}
+
+// Works out if DST is in effect and if a transition happens today, from the current 
+// date and the given clock hour (24hr time)
+static void evaluate_dst(char hours){
+
+    dst_active = 0;
+    dst_transition_hour = -1;
+    if(dst_zone.start.month == 0)
+        return;
+
+    unsigned int today = day_number;
+    unsigned int year = civil_from_days(today).year;
+    unsigned int start = transition_day(dst_zone.start, year);
+    unsigned int end = transition_day(dst_zone.end, year);
+
+    // past the start and before the end of DST this year
+    char after_start = today > start || (today == start && hours >= dst_zone.start.hour + 1);
+    char before_end = today < end || (today == end && hours < dst_zone.end.hour);
+
+    // DST is within a year in the northern hemisphere and spans the new year in the 
+    // southern hemisphere
+    if(start < end)
+        dst_active = after_start && before_end;
+    else
+        dst_active = after_start || before_end;
+
+    if(today == start && !dst_active){
+        dst_transition_hour = dst_zone.start.hour;
+        dst_transition_shift = 1;
+    }
+    else if(today == end && dst_active){
+        dst_transition_hour = dst_zone.end.hour;
+        dst_transition_shift = -1;
+    }
+}
+
+// Evaluates the DST rules for the current date (day_number) and the current clock hour 
+// given in hours (24hr time). Called at startup and by set_date().
+void init_calendar(char hours){
+
+    // the clock timer interrupt changes the date and the DST state at midnight
+    unsigned char sreg = SREG;
+    cli();
+    evaluate_dst(hours);
+    SREG = sreg;
+}
+
+// Sets the date and works out whether daylight saving time is in effect. hours is the 
+// current clock hour in 24hr time.
+void set_date(unsigned int year, unsigned char month, unsigned char day, char hours){
+
+    unsigned char sreg = SREG;
+    cli();
+    day_number = days_from_civil(year, month, day);
+    evaluate_dst(hours);
+    SREG = sreg;
+}
+
+// Moves the date to the next day and evaluates the DST rules for it. Called by the 
+// clock timer interrupt when the clock reaches midnight.
+void calendar_next_day(){
+    day_number += 1;
+    evaluate_dst(0);
+}
+
+// Returns the number of hours (1 or -1) to move the clock by if a DST transition 
+// happens at the given clock hour (24hr time) today, 0 otherwise. Called by the clock 
+// timer interrupt at the start of every hour.
+signed char dst_transition(char hours){
+
+    if(hours != dst_transition_hour)
+        return 0;
+
+    // only once, the clock goes back through the same hour at the end of DST
+    dst_transition_hour = -1;
+    dst_active = (dst_transition_shift > 0);
+    return dst_transition_shift;
+}
@@ -0,0 +1,84 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <stdint.h>
+
+// Date kept as a number of days since 2000-01-01 (day 0, a Saturday) and converted 
+// to year, month and day when needed. The DST rules of the time zone (DST_ZONE in 
+// global_header.h) are evaluated once a day, at day rollover, and the clock is moved 
+// by an hour at the transition.
+
+// Date as year, month (1 to 12) and day of the month (1 to 31)
+typedef struct civilDate_struct {
+    unsigned int year;
+    unsigned char month;
+    unsigned char day;
+} civilDate;
+
+// Days of the week, as returned by weekday()
+typedef enum weekdayType_enum {
+    sunday, monday, tuesday, wednesday, thursday, friday, saturday}
+weekdayType;
+
+namespace calendar {
+
+// Days between 0000-03-01 and 2000-01-01, with years starting in March so the leap 
+// day is the last day of a year
+constexpr long epoch_offset = 730425;
+
+// Years since 0000 counted from March
+constexpr long shifted_year(unsigned int year, unsigned char month){
+    return month <= 2 ? (long)year - 1 : (long)year;
+}
+
+// Day of the year counted from March 1st
+constexpr long day_of_shifted_year(unsigned char month, unsigned char day){
+    return (153L * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+}
+
+// Day of the 400-year era (146097 days) from the year of the era and the day of the year
+constexpr long day_of_era(long year_of_era, long day_of_year){
+    return year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+}
+
+}
+
+// Number of days since 2000-01-01 of a date from 2000-01-01 on. Computed by the 
+// compiler for constant dates.
+constexpr unsigned int days_from_civil(unsigned int year, unsigned char month, unsigned char day){
+    return (unsigned int)(calendar::shifted_year(year, month) / 400 * 146097 + 
+        calendar::day_of_era(calendar::shifted_year(year, month) % 400, 
+            calendar::day_of_shifted_year(month, day)) - calendar::epoch_offset);
+}
+
+// Current date in days since 2000-01-01, advanced by the clock timer interrupt at 
+// day rollover
+extern volatile unsigned int day_number;
+
+// 1 while daylight saving time is in effect
+extern volatile char dst_active;
+
+// Converts a number of days since 2000-01-01 to year, month and day, in constant time
+civilDate civil_from_days(unsigned int days);
+
+// Day of the week of a number of days since 2000-01-01
+weekdayType weekday(unsigned int days);
+
+// Sets the date and works out whether daylight saving time is in effect. hours is the 
+// current clock hour in 24hr time.
+void set_date(unsigned int year, unsigned char month, unsigned char day, char hours);
+
+// Evaluates the DST rules for the current date (day_number) and the current clock hour 
+// given in hours (24hr time). Called at startup and by set_date().
+void init_calendar(char hours);
+
+// Moves the date to the next day and evaluates the DST rules for it. Called by the 
+// clock timer interrupt when the clock reaches midnight.
+void calendar_next_day();
+
+// Returns the number of hours (1 or -1) to move the clock by if a DST transition 
+// happens at the given clock hour (24hr time) today, 0 otherwise. Called by the clock 
+// timer interrupt at the start of every hour.
+signed char dst_transition(char hours);
+
+#endif
@@ -1,7 +1,18 @@
 #include <avr/interrupt.h>
 #include "global_header.h"
 #include "clock.h"
-#include "PWM.h"
+#include "timer_config.h"
+#include "power.h"
+#include "warm_restart.h"
+#include "timer_wheel.h"
+#include "calendar.h"
+#include "probe.h"
+#include "latency.h"
+#include "countdown.h"
+#include "stack.h"
+
+// The clock timer (timer 1, clock_timer in clock.h) belongs to this module
+CLAIM_TIMER(CLOCK_TIMER);
 
 // Current system state (initially idle state) (global variable in main)
 extern volatile stateType state;
@@ -25,24 +36,64 @@ volatile char reference_am_pm;
 // Status of alarm being activated or deactivated (global variable in main)
 extern volatile char alarm_activation; // 1 is activated, 0 is deactivated
 
-// Counter that gets incremented every 4 seconds to signal a full minute has 
-// passed when it reaches 15.
-volatile char counter = 0;
+// Counter that gets incremented every clock tick (10 ms) by the time warp to signal a 
+// full minute has passed when it reaches CLOCK_TICKS_PER_MINUTE.
+volatile unsigned int counter = 0;
+
+#if TIME_WARP_ENABLED
+// Clock minutes per real minute (1 is real time). Only changes the clock time, not the 
+// timer wheel or the countdowns.
+volatile unsigned int time_warp = 1;
+#endif
+
+// Counter of clock ticks within the current second (real time)
+volatile unsigned char second_counter = 0;
+
+// Seconds and minutes counted by the clock timer interrupt that update_clock() has not 
+// handled yet
+volatile unsigned char clock_seconds_pending = 0;
+volatile unsigned int clock_minutes_pending = 0;
+
+// Number of clock timer interrupts since init_clock()
+volatile unsigned long clock_ticks = 0;
+
+// 1 once the clock has reached the activated alarm time, until read by alarm_take_due()
+volatile char alarm_due = 0;
+
+#if GPS_ENABLED
+// Rate correction of the clock timer in 1/65536 timer counts per tick, positive 
+// lengthens the ticks (set_clock_rate())
+volatile long clock_rate_adjust = 0;
+
+// Fraction of a timer count (1/65536) carried over to the next tick
+volatile unsigned int clock_rate_fraction = 0;
+
+// Length in timer counts of the tick in progress (OCR1A + 1)
+volatile unsigned int clock_tick_counts = clock_timer::top + 1;
+
+// Timer counts of the ticks ended since the last clock_timestamp()
+volatile unsigned long clock_counts = 0;
+
+// Timer count (TCNT1) at the last clock_timestamp()
+unsigned int clock_timestamp_count = 0;
+#endif
 
 // Initializes clock timer (timer 1) which triggers the clock timer interrupt 
-// every 4 seconds.
+// every 10 ms.
 void init_clock(){
 
+    // Turn on timer 1
+    power_request(power_timer1);
+
     // Setting timer 1 into CTC mode
     TCCR1B |= ( 1 << WGM12); 
 
-    // Setting compare A register to 62499 = (4*16000000/1024) - 1 to count for 4 seconds 
-    // given a prescaler of 1024. CLOCK_SPEED_FACTOR is a debug constant to accelerate the 
-    // clock. In production, it is set to 1.
-    OCR1A = (int)(62499/CLOCK_SPEED_FACTOR);
+    // Setting compare A register to count for 10 ms (19999 = (0.01*16000000/8) - 1 
+    // with a prescaler of 8)
+    OCR1A = clock_timer::top;
 
-    // Sets timer 1 prescaler to 1024
-    TCCR1B  |= (1 << CS12) | (1 << CS10);
+    // Sets timer 1 prescaler (8)
+    TCCR1B  |= clock_timer::cs_bits;
     
     // Reset clock timer counter to 0 before starting it
     TCNT1 = 0;
@@ -186,19 +237,206 @@ void change_hour_mode () {
 
 
 
-// Clock timer routine executed every 4 seconds
-ISR(TIMER1_COMPA_vect){
+// Returns the time in microseconds since init_clock() (wraps after about 71 minutes). 
+// Must not be called with the clock timer stopped.
+unsigned long clock_uptime_us(){
 
-    // increment counter
-    counter += 1;
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long ticks = clock_ticks;
+    unsigned int count = TCNT1;
+    // a compare match that has not been serviced yet already reset the counter
+    if(TIFR1 & (1 << OCF1A)){
+        ticks += 1;
+        count = TCNT1;
+    }
+    SREG = sreg;
 
-    // If counter has reached 15, 1 minute has passed, so counter gets reset, otherwise 
-    // return
-    if(counter < 15)
-        return;
-    
-    // reset counter
-    counter = 0;
+    // timer counts to microseconds (16 cycles per microsecond)
+    return ticks * ((clock_timer::top + 1UL) * clock_timer::divider / 16) + 
+        (unsigned long)count * clock_timer::divider / 16;
+}
+
+#if TIME_WARP_ENABLED
+// Switches the time warp to the next of 1x, 60x and 3600x and returns it
+unsigned int next_time_warp(){
+
+    unsigned int warp;
+    if(time_warp == 1)
+        warp = 60;
+    else if(time_warp == 60)
+        warp = 3600;
+    else
+        warp = 1;
+
+    // 16-bit store read by the clock timer interrupt
+    unsigned char sreg = SREG;
+    cli();
+    time_warp = warp;
+    SREG = sreg;
+
+    return warp;
+}
+#endif
+
+// Returns the hours of a time given by its digits and AM/PM status in 24hr time
+static char hours_24(const volatile char * digits, char pm){
+
+    char hours = digits[0]*10 + digits[1];
+    if(hour_mode == 0){
+        if(hours == 12)
+            hours = 0;
+        if(pm)
+            hours += 12;
+    }
+    return hours;
+}
+
+// Returns the hours of the clock time in 24hr time
+char clock_hours_24(){
+    return hours_24(time_digits, am_pm);
+}
+
+// Returns the number of minutes from the clock time to the alarm time (0 to 1439, 0 
+// during the minute of the alarm)
+unsigned int minutes_until_alarm(){
+
+    int now = hours_24(time_digits, am_pm) * 60 + time_digits[2] * 10 + time_digits[3];
+    int alarm = hours_24(alarm_time_digits, alarm_am_pm) * 60 + 
+        alarm_time_digits[2] * 10 + alarm_time_digits[3];
+    int minutes = alarm - now;
+    if(minutes < 0)
+        minutes += 24 * 60;
+    return minutes;
+}
+
+// Returns 1 if the alarm is ringing, or if the activated alarm or a countdown goes 
+// off within the given number of minutes
+int alarm_imminent(unsigned char minutes){
+
+    if(state == alarm_on)
+        return 1;
+    if(alarm_activation && minutes_until_alarm() <= minutes)
+        return 1;
+    unsigned long ticks = countdown_ticks_left();
+    return ticks != 0 && ticks <= minutes * (unsigned long)CLOCK_TICKS_PER_MINUTE;
+}
+
+// Sets the hours of the clock time from hours in 24hr time (0 to 23)
+static void set_clock_hours_24(char hours){
+
+    if(hour_mode == 0){
+        am_pm = (hours >= 12);
+        if(hours > 12)
+            hours -= 12;
+        if(hours == 0)
+            hours = 12;
+    }
+    time_digits[0] = hours / 10;
+    time_digits[1] = hours % 10;
+}
+
+// Turns the power manager night mode on between NIGHT_START_HOUR and NIGHT_END_HOUR
+void update_night_mode(){
+
+    // hours in 24hr time
+    char hours = clock_hours_24();
+
+    set_night_mode(hours >= NIGHT_START_HOUR || hours < NIGHT_END_HOUR);
+}
+
+// Returns the clock time as a number of ticks since midnight (24hr time)
+unsigned long clock_day_ticks(){
+
+    // minutes counted by the interrupt but not advanced yet by update_clock() are in
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long ticks = (clock_hours_24() * 60UL + time_digits[2] * 10 + time_digits[3] + 
+        clock_minutes_pending) * CLOCK_TICKS_PER_MINUTE + counter;
+    SREG = sreg;
+    return ticks % (24UL * 60 * CLOCK_TICKS_PER_MINUTE);
+}
+
+// Sets the clock time from a number of ticks since midnight (24hr time). The date 
+// is not changed.
+void set_clock_day_ticks(unsigned long ticks){
+
+    unsigned int minutes = ticks / CLOCK_TICKS_PER_MINUTE;
+
+    unsigned char sreg = SREG;
+    cli();
+    set_clock_hours_24(minutes / 60);
+    time_digits[2] = minutes % 60 / 10;
+    time_digits[3] = minutes % 10;
+    counter = ticks % CLOCK_TICKS_PER_MINUTE;
+    // minutes not advanced yet belong to the time being replaced
+    clock_minutes_pending = 0;
+    SREG = sreg;
+
+    update_night_mode();
+}
+
+// Moves the clock time by ticks (positive is forward). A step back across the start of 
+// a minute is refused (returns 0) so that a minute is never counted twice.
+int step_clock(int ticks){
+
+    int stepped = 1;
+    unsigned char sreg = SREG;
+    cli();
+    if(ticks < 0 && counter < (unsigned int)-ticks)
+        stepped = 0;
+    else
+        counter += ticks;
+    SREG = sreg;
+    return stepped;
+}
+
+#if GPS_ENABLED
+// Sets the rate correction of the clock timer in 1/65536 timer counts per tick 
+// (positive lengthens the ticks). Applied from the next tick.
+void set_clock_rate(long adjust){
+
+    unsigned char sreg = SREG;
+    cli();
+    clock_rate_adjust = adjust;
+    SREG = sreg;
+}
+
+// Takes a timestamp of the current instant for the PPS discipline. Called with 
+// interrupts disabled (PPS edge interrupt).
+void clock_timestamp(clockTimestamp * stamp){
+
+    unsigned int count = TCNT1;
+    unsigned int minute_ticks = counter;
+    unsigned long ticks = clock_ticks;
+    unsigned long counts = clock_counts;
+    clock_counts = 0;
+
+    // a compare match that has not been serviced yet already restarted the counter, 
+    // the tick it ended is counted here and taken off the next count of the interrupt
+    if(TIFR1 & (1 << OCF1A)){
+        count = TCNT1;
+        counts += clock_tick_counts;
+        minute_ticks += 1;
+        ticks += 1;
+        clock_counts = -(unsigned long)clock_tick_counts;
+    }
+
+    stamp->elapsed_counts = counts + count - clock_timestamp_count;
+    stamp->minute_ticks = minute_ticks;
+    stamp->count = count;
+    stamp->tick = ticks;
+    clock_timestamp_count = count;
+}
+#endif
+
+// Advances the clock time by one minute (with hour, 12/24hr and AM/PM rollover), moves 
+// the date at midnight and applies DST transitions, then updates the night mode and 
+// signals the alarm if it is due (alarm_take_due()). Called by update_clock() for every 
+// minute counted by the clock timer interrupt. Touches no registers: the night mode is 
+// a flag applied by the display refresh and the alarm is rung by the interaction loop, 
+// so scenarios (key sequences, a year of minutes) can drive it directly off-target.
+void advance_minute(){
 
     // increment last digit of minutes
     time_digits[3] += 1;
@@ -244,17 +482,122 @@ ISR(TIMER1_COMPA_vect){
             am_pm = !am_pm;
     }
 
-    // Trigger alarm if clock time and alarm time are the same.
-    if((state == show_time) && alarm_activation){
+    // At the start of an hour, move to the next day at midnight and apply a DST 
+    // transition (the DST rules are only evaluated at midnight)
+    if(time_digits[2] == 0 && time_digits[3] == 0){
+        char hours = clock_hours_24();
+        if(hours == 0)
+            calendar_next_day();
+
+        signed char shift = dst_transition(hours);
+        if(shift != 0)
+            set_clock_hours_24(hours + shift);
+    }
+
+    update_night_mode();
+
+    // Signal the alarm if clock time and alarm time are the same. The interaction loop 
+    // rings it through the state machine, which decides in which states it rings.
+    if(alarm_activation){
         if(time_digits[0] == alarm_time_digits[0] &&
             time_digits[1] == alarm_time_digits[1] &&
             time_digits[2] == alarm_time_digits[2] &&
             time_digits[3] == alarm_time_digits[3] &&
             am_pm == alarm_am_pm){
-                turn_on_alarm();
-                state = alarm_on;
+                alarm_due = 1;
             }
     }
+}
+
+// Returns 1 if the clock has reached the alarm time since the last call and 0 otherwise
+char alarm_take_due(){
+
+    unsigned char sreg = SREG;
+    cli();
+    char due = alarm_due;
+    alarm_due = 0;
+    SREG = sreg;
+    return due;
+}
+
+// Clock timer routine executed every 10 ms. Only counts the ticks and expires the 
+// timers, the seconds and minutes are handled by update_clock().
+ISR(TIMER1_COMPA_vect){
+#if PROBE_ENABLED
+    record_isr_entry(&clock_isr_jitter, TCNT1);
+#endif
+    PROBE_SCOPE(probe_clock_isr);
+
+    clock_ticks += 1;
+
+#if GPS_ENABLED
+    // Length of the next tick: nominal plus the rate correction, whole timer counts with 
+    // the fraction carried over. The counter has only just restarted, so the new TOP 
+    // is still ahead of it.
+    clock_counts += clock_tick_counts;
+    long next_counts = (long)clock_rate_fraction + clock_rate_adjust;
+    clock_rate_fraction = next_counts & 0xFFFF;
+    clock_tick_counts = clock_timer::top + 1 + (int)(next_counts >> 16);
+    OCR1A = clock_tick_counts - 1;
+#endif
+
+    // expire countdowns and other timers
+    timer_wheel_tick();
+
+    // a second has passed, its work is done by update_clock()
+    second_counter += 1;
+    if(second_counter == CLOCK_TICKS_PER_SECOND){
+        second_counter = 0;
+        clock_seconds_pending += 1;
+    }
+
+    // increment counter, by the time warp so accelerated minutes stay exact
+#if TIME_WARP_ENABLED
+    counter += time_warp;
+#else
+    counter += 1;
+#endif
+
+    // While counter has reached CLOCK_TICKS_PER_MINUTE, 1 minute has passed, so 
+    // CLOCK_TICKS_PER_MINUTE is taken off the counter, keeping the remainder. The 
+    // minute is advanced by update_clock().
+    while(counter >= CLOCK_TICKS_PER_MINUTE){
+        counter -= CLOCK_TICKS_PER_MINUTE;
+        clock_minutes_pending += 1;
+    }
+}
+
+// Does the once a second and once a minute work counted by the clock timer interrupt: 
+// advances the clock time by the minutes that have passed and checks the stack peak, 
+// then keeps a copy of the time for a warm restart and adds the seconds to the 
+// peripherals on-time. Called from the interaction loop, so this work does not hold up 
+// the other interrupts.
+void update_clock(){
+
+    unsigned char sreg = SREG;
+    cli();
+    unsigned char seconds = clock_seconds_pending;
+    clock_seconds_pending = 0;
+    unsigned int minutes = clock_minutes_pending;
+    clock_minutes_pending = 0;
+    SREG = sreg;
+
+    // Record a deeper stack in the trace, once a minute
+    if(minutes != 0)
+        stack_check();
+
+    while(minutes != 0){
+        advance_minute();
+        minutes -= 1;
+    }
+
+    if(seconds != 0){
+        // Keep a copy of the time for a warm restart
+        save_clock_state();
+
+        // peripherals on-time accounting
+        power_account(seconds);
+    }
 } 
     
 
@@ -2,9 +2,21 @@
 #define CLOCK_H
 
 #include <avr/io.h>
+#include "global_header.h"
+#include "timer_config.h"
+#include "timer_wheel.h"
 
-// Initializes clock timer (timer 0) which triggers the clock timer interrupt 
-// every 4 seconds.
+// Clock timer (timer 1) period of 10 ms, the tick of the clock and the timer wheel
+typedef ctc_timer<CLOCK_TIMER, period_ms(TIMER_WHEEL_TICK_MS), 0> clock_timer;
+
+// Clock ticks per minute of the clock
+#define CLOCK_TICKS_PER_MINUTE (60000 / TIMER_WHEEL_TICK_MS)
+
+// Clock ticks per second
+#define CLOCK_TICKS_PER_SECOND (1000 / TIMER_WHEEL_TICK_MS)
+
+// Initializes clock timer (timer 1) which triggers the clock timer interrupt 
+// every 10 ms.
 void init_clock();
 
 // Loads time given in input_time_digits and input_am_pm to the buffer. 
@@ -25,4 +37,73 @@ int buffer_differs_from_refernce();
 
 //change current time to its corresponding mode
 void change_hour_mode();
+
+// Returns the time in microseconds since init_clock() (wraps after about 71 minutes). 
+// Must not be called with the clock timer stopped.
+unsigned long clock_uptime_us();
+
+#if TIME_WARP_ENABLED
+// Switches the time warp to the next of 1x, 60x and 3600x and returns it
+unsigned int next_time_warp();
+#endif
+
+// Returns the hours of the clock time in 24hr time
+char clock_hours_24();
+
+// Returns the number of minutes from the clock time to the alarm time (0 to 1439, 0 
+// during the minute of the alarm)
+unsigned int minutes_until_alarm();
+
+// Returns 1 if the alarm is ringing, or if the activated alarm or a countdown goes 
+// off within the given number of minutes
+int alarm_imminent(unsigned char minutes);
+
+// Returns the clock time as a number of ticks since midnight (24hr time)
+unsigned long clock_day_ticks();
+
+// Sets the clock time from a number of ticks since midnight (24hr time). The date 
+// is not changed.
+void set_clock_day_ticks(unsigned long ticks);
+
+// Moves the clock time by ticks (positive is forward). A step back across the start of 
+// a minute is refused (returns 0) so that a minute is never counted twice.
+int step_clock(int ticks);
+
+#if GPS_ENABLED
+// Instant taken by clock_timestamp(): timer counts since the previous timestamp, clock 
+// ticks into the current minute of the clock time, timer count (TCNT1) into the current 
+// tick and ticks since init_clock()
+typedef struct clockTimestamp_struct {
+    unsigned long elapsed_counts;
+    unsigned int minute_ticks;
+    unsigned int count;
+    unsigned long tick;
+} clockTimestamp;
+
+// Sets the rate correction of the clock timer in 1/65536 timer counts per tick 
+// (positive lengthens the ticks). Applied from the next tick.
+void set_clock_rate(long adjust);
+
+// Takes a timestamp of the current instant for the PPS discipline. Called with 
+// interrupts disabled (PPS edge interrupt).
+void clock_timestamp(clockTimestamp * stamp);
+#endif
+
+// Advances the clock time by one minute (with hour, 12/24hr and AM/PM rollover), moves 
+// the date at midnight and applies DST transitions, then updates the night mode and 
+// signals the alarm if it is due (alarm_take_due()). Called by update_clock() for every 
+// minute counted by the clock timer interrupt. Touches no registers: the night mode is 
+// a flag applied by the display refresh and the alarm is rung by the interaction loop, 
+// so scenarios (key sequences, a year of minutes) can drive it directly off-target.
+void advance_minute();
+
+// Returns 1 if the clock has reached the alarm time since the last call and 0 otherwise
+char alarm_take_due();
+
+// Does the once a second and once a minute work counted by the clock timer interrupt: 
+// advances the clock time by the minutes that have passed and checks the stack peak, 
+// then keeps a copy of the time for a warm restart and adds the seconds to the 
+// peripherals on-time. Called from the interaction loop, so this work does not hold up 
+// the other interrupts.
+void update_clock();
 #endif
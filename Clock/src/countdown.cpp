@@ -0,0 +1,180 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "countdown.h"
+#include "timer_wheel.h"
+
+
+// Number of clock timer ticks (10 ms) since init_clock() (global variable in clock)
+extern volatile unsigned long clock_ticks;
+
+// Digits shown on the display in show_timer state, filled by update_timer_display()
+volatile char timer_display_digits [4] = {0, 0, 0, 0};
+
+// Timer wheel timers used by the countdowns, TIMER_NONE when not running
+volatile timerId countdowns[COUNTDOWN_TIMERS] = {TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE};
+
+// Countdown length in minutes being typed and its number of digits typed so far
+char countdown_minutes = 0;
+char countdown_digits_typed = 0;
+
+// Stopwatch time accumulated while running before the last stop, in ticks, and tick 
+// at which it was last started
+unsigned long stopwatch_ticks = 0;
+unsigned long stopwatch_start_tick = 0;
+char stopwatch_running = 0;
+
+// 1 once a countdown has expired, until read by countdown_take_expired()
+volatile char countdown_rang = 0;
+
+// Called from the clock timer interrupt when a countdown expires. The alarm is rung 
+// by the interaction loop through the state machine, so the exit action of the 
+// current state runs.
+void countdown_expired(timerId timer){
+
+    for(unsigned char k = 0; k < COUNTDOWN_TIMERS; k++){
+        if(countdowns[k] == timer)
+            countdowns[k] = TIMER_NONE;
+    }
+
+    countdown_rang = 1;
+}
+
+// Returns 1 if a countdown has expired since the last call and 0 otherwise
+char countdown_take_expired(){
+
+    unsigned char sreg = SREG;
+    cli();
+    char rang = countdown_rang;
+    countdown_rang = 0;
+    SREG = sreg;
+    return rang;
+}
+
+// Adds a digit (0 to 9) to the countdown length in minutes being typed (2 digits)
+void countdown_digit(char digit){
+    countdown_minutes = (countdown_minutes % 10) * 10 + digit;
+    countdown_digits_typed += 1;
+}
+
+// Starts a countdown of the given number of minutes in a free countdown slot
+static void start_countdown(unsigned char minutes){
+    for(unsigned char k = 0; k < COUNTDOWN_TIMERS; k++){
+        if(countdowns[k] == TIMER_NONE){
+            countdowns[k] = timer_start(minutes * (60000UL / TIMER_WHEEL_TICK_MS), 
+                countdown_expired);
+            break;
+        }
+    }
+}
+
+// Starts a countdown with the length typed with countdown_digit(). When it expires 
+// the alarm goes off.
+void countdown_start(){
+
+    if(countdown_minutes > 0)
+        start_countdown(countdown_minutes);
+
+    countdown_minutes = 0;
+    countdown_digits_typed = 0;
+}
+
+// Starts a SNOOZE_MINUTES countdown that rings the alarm again, once the ringing 
+// alarm has been turned off. The snooze shows in show_timer like any countdown.
+void snooze_alarm(){
+    start_countdown(SNOOZE_MINUTES);
+}
+
+// Returns the index in countdowns of the countdown that expires first, 
+// COUNTDOWN_TIMERS if none is running
+static unsigned char first_countdown(){
+    unsigned char first = COUNTDOWN_TIMERS;
+    unsigned long first_remaining = 0;
+    for(unsigned char k = 0; k < COUNTDOWN_TIMERS; k++){
+        unsigned long remaining = timer_remaining(countdowns[k]);
+        if(remaining != 0 && (first == COUNTDOWN_TIMERS || remaining < first_remaining)){
+            first = k;
+            first_remaining = remaining;
+        }
+    }
+    return first;
+}
+
+// Returns the number of clock ticks before the first countdown expires, 0 if none 
+// is running
+unsigned long countdown_ticks_left(){
+    unsigned char first = first_countdown();
+    if(first == COUNTDOWN_TIMERS)
+        return 0;
+    return timer_remaining(countdowns[first]);
+}
+
+// Cancels the countdown that expires first
+void countdown_cancel(){
+    unsigned char first = first_countdown();
+    if(first != COUNTDOWN_TIMERS){
+        timer_cancel(countdowns[first]);
+        countdowns[first] = TIMER_NONE;
+    }
+}
+
+// Reads the tick counter of the clock timer interrupt
+static unsigned long current_tick(){
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long tick = clock_ticks;
+    SREG = sreg;
+    return tick;
+}
+
+// Starts the stopwatch if it is stopped and stops it if it is running
+void stopwatch_toggle(){
+    if(stopwatch_running)
+        stopwatch_ticks += current_tick() - stopwatch_start_tick;
+    else
+        stopwatch_start_tick = current_tick();
+    stopwatch_running = !stopwatch_running;
+}
+
+// Stops the stopwatch and sets it back to 0
+void stopwatch_reset(){
+    stopwatch_running = 0;
+    stopwatch_ticks = 0;
+}
+
+// Shows a pair of numbers below 100 on the timer display
+static void show_pair(unsigned int high, unsigned int low){
+    timer_display_digits[0] = high / 10;
+    timer_display_digits[1] = high % 10;
+    timer_display_digits[2] = low / 10;
+    timer_display_digits[3] = low % 10;
+}
+
+// Fills timer_display_digits with the minutes being typed, otherwise with the time left 
+// on the countdown that expires first (MM:SS, HH:MM from 100 minutes), otherwise with 
+// the stopwatch time (MM:SS)
+void update_timer_display(){
+
+    if(countdown_digits_typed){
+        show_pair(countdown_minutes, 0);
+        return;
+    }
+
+    unsigned long seconds;
+    unsigned char first = first_countdown();
+    if(first != COUNTDOWN_TIMERS){
+        // round up so the countdown shows 00:00 only when it expires
+        seconds = (timer_remaining(countdowns[first]) + 99) / 100;
+        if(seconds >= 6000){
+            show_pair(seconds / 3600 % 100, seconds / 60 % 60);
+            return;
+        }
+    }
+    else{
+        unsigned long ticks = stopwatch_ticks;
+        if(stopwatch_running)
+            ticks += current_tick() - stopwatch_start_tick;
+        seconds = ticks / 100;
+    }
+    show_pair(seconds / 60 % 100, seconds % 60);
+}
@@ -0,0 +1,42 @@
+#ifndef COUNTDOWN_H
+#define COUNTDOWN_H
+
+// Number of countdowns (kitchen timer, nap timer) that can run at the same time
+#define COUNTDOWN_TIMERS 4
+
+// Digits shown on the display in show_timer state, filled by update_timer_display()
+extern volatile char timer_display_digits [4];
+
+// Adds a digit (0 to 9) to the countdown length in minutes being typed (2 digits)
+void countdown_digit(char digit);
+
+// Starts a countdown with the length typed with countdown_digit(). When it expires 
+// the alarm goes off.
+void countdown_start();
+
+// Starts a SNOOZE_MINUTES countdown that rings the alarm again, once the ringing 
+// alarm has been turned off. The snooze shows in show_timer like any countdown.
+void snooze_alarm();
+
+// Returns 1 if a countdown has expired since the last call and 0 otherwise
+char countdown_take_expired();
+
+// Returns the number of clock ticks before the first countdown expires, 0 if none 
+// is running
+unsigned long countdown_ticks_left();
+
+// Cancels the countdown that expires first
+void countdown_cancel();
+
+// Starts the stopwatch if it is stopped and stops it if it is running
+void stopwatch_toggle();
+
+// Stops the stopwatch and sets it back to 0
+void stopwatch_reset();
+
+// Fills timer_display_digits with the minutes being typed, otherwise with the time left 
+// on the countdown that expires first (MM:SS, HH:MM from 100 minutes), otherwise with 
+// the stopwatch time (MM:SS)
+void update_timer_display();
+
+#endif
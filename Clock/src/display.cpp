@@ -1,7 +1,40 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include "global_header.h"
 #include "display.h"
+#include "timer_config.h"
+#include "pin_map.h"
+#include "max7219.h"
+#include "ssd1306.h"
+#include "power.h"
+#include "boot.h"
+#include "countdown.h"
+#include "I2C.h"
+#include "probe.h"
+
+// Display timer (timer 0) overflowing at about 4*60 Hz (244 Hz with a prescaler of 256)
+typedef overflow_timer<DISPLAY_TIMER, frequency_hz(4 * 60), 20000> display_timer;
+CLAIM_TIMER(DISPLAY_TIMER);
+
+// Display timer counts a digit stays lit in night mode, half of the 256 counts of a 
+// refresh, which halves the brightness of the direct drive display
+#define NIGHT_ON_COUNTS 128
+
+// Segment pins in segment order A,B,C,D,E,F,G,DP and digit select pins in digit order
+#if DISPLAY_WIRING == 0
+typedef output_pins<
+    pin(port_a, 0), pin(port_a, 1), pin(port_a, 2), pin(port_a, 3),
+    pin(port_a, 4), pin(port_a, 5), pin(port_a, 6), pin(port_a, 7)> segment_pins;
+typedef select_pins<
+    pin(port_c, 0), pin(port_c, 1), pin(port_c, 2), pin(port_c, 3)> digit_pins;
+#else
+typedef output_pins<
+    pin(port_f, 4), pin(port_f, 2), pin(port_l, 7), pin(port_l, 3),
+    pin(port_l, 1), pin(port_f, 3), pin(port_g, 1), pin(port_l, 5)> segment_pins;
+typedef select_pins<
+    pin(port_f, 7), pin(port_f, 6), pin(port_f, 5), pin(port_k, 4)> digit_pins;
+#endif
 
 // Current system state (initially idle state) (global variable in main)
 extern volatile stateType state;
@@ -29,9 +62,12 @@ extern volatile char cursor_digit;
 volatile char cursor_blink = 0;
 // Count to give delay for cusor blink
 volatile char cursor_count = 0;
+// 1 once the first frame has been shown (boot time measurement)
+volatile char first_frame_shown = 0;
 
 // Seven segment display patterns with bit encoding to display segments: 7:0 => DP,G,F,E,D,C,B,A
-unsigned char patterns[11] = {
+// Kept in flash, read with pgm_read_byte.
+const unsigned char patterns[14] PROGMEM = {
     0x3F, // 0:    0b00111111
     0x06, // 1:    0b00000110
     0x5B, // 2:    0b01011011
@@ -42,7 +78,10 @@ unsigned char patterns[11] = {
     0x07, // 7:    0b00000111
     0x7F, // 8:    0b01111111
     0x6F, // 9:    0b01101111
-    0x00  // None: 0b00000000 (DP light only)
+    0x00, // None: 0b00000000 (DP light only)
+    0x39, // C:    0b00111001
+    0x71, // F:    0b01110001
+    0x40  // -:    0b01000000
 };
 
 // Initialize display system including 4-digit 7-segment display, AM/PM 
@@ -52,12 +91,21 @@ unsigned char patterns[11] = {
 // be displayed in its own interrupt routine for a proper sweep.
 void init_display() {
 
-    // Sets PORTF[4:2], PORTL[1,3,5,7], and PORTG1 to be segment outputs to display a digit
-    //DDRF |= (1<< DDF4)|(1<< DDF2) | (1<< DDF3);
-    //DDRL |= (1<< DDL7)|(1<< DDL3)|(1<< DDL1)|(1<< DDL5);
-    //DDRG |= (1<< DDG1);
+    // Turn on timer 0
+    power_request(power_timer0);
 
-    DDRA = 0xFF;
+#if DISPLAY_BACKEND == 0
+    // Sets the segment pins (PORTA, or PORTF[4:2], PORTL[1,3,5,7] and PORTG1 for the 
+    // older wiring) to be segment outputs to display a digit
+    segment_pins::init();
+#elif DISPLAY_BACKEND == 1
+    // Sets up the SPI bus and the MAX7219 which multiplexes the digits by itself
+    init_max7219();
+#else
+    // Marks the whole OLED to be drawn, it is brought up by update_display() once the 
+    // I2C module is initialized
+    init_ssd1306();
+#endif
 
     // Also sets PH6 to be the AM/PM LED output and PB4 to be the alarm output.
     //DDRC = (1 << DDC4) | (1 << DDC5);
@@ -71,68 +119,67 @@ void init_display() {
     // PK7 is left-led input (alarm)
     //DDRK |= (1 << DDK7);
 
-    // Set timer 0 prescaler to 256
-    TCCR0B  |= (1 << CS02);
+    // Set timer 0 prescaler (256)
+    TCCR0B  |= display_timer::cs_bits;
     
+#if DISPLAY_BACKEND == 0
     // Enable timer 0 overflower interrupt
     TIMSK0 |= (1 << TOIE0);
 
+    // Compare A turns the digit off in night mode
+    OCR0A = NIGHT_ON_COUNTS - 1;
+#endif
+
 }
 
 // Displays a number (digit) given in time_digit_value at the digit location 
-// given in time_digit on the 4-digit 7-segment display. PORTF[7:5] and PORTK4 are used to select 
-// which digit position to display the number at. Setting one of these pins to output 
-// makes it a ground which activates the digit position while setting it to input makes it 
-// high impedance which deactivates the digit position. The digit pins are used to send 
-// the digit bit encoding.
+// given in time_digit on the 4-digit 7-segment display. time_digit_value can also 
+// be one of the DIGIT_ values. PORTC[3:0] (PORTF[7:5] and PORTK4 
+// for the older wiring) are used to select which digit position to display the number at. 
+// Setting one of these pins to output makes it a ground which activates the digit position 
+// while setting it to input makes it high impedance which deactivates the digit position. 
+// The segment pins are used to send the digit bit encoding.
 void display_time_digit(unsigned char time_digit, unsigned char time_digit_value){
 
-    // Set PORTA to output the encoding of number time_digit_value
-    unsigned char pattern = patterns[time_digit_value];
-
-    // if a bit in the pattern is 1, set its corresponding pin to 1, otherwise, set it to 0
-    // set_bit_to_pin(pattern, 0, PORTF, PORTF4);
-    // set_bit_to_pin(pattern, 1, PORTF, PORTF2);
-    // set_bit_to_pin(pattern, 2, PORTL, PORTL7);
-    // set_bit_to_pin(pattern, 3, PORTL, PORTL3);
-    // set_bit_to_pin(pattern, 4, PORTL, PORTL1);
-    // set_bit_to_pin(pattern, 5, PORTF, PORTF3);
-    // set_bit_to_pin(pattern, 6, PORTG, PORTG1);
-    // set_bit_to_pin(pattern, 7, PORTL, PORTL5);
-
-    PORTA = patterns[time_digit_value];
-    DDRC = (DDRC & 0xF0) | (1 << time_digit);
+#if DISPLAY_BACKEND == 0
+    // Set the segment pins to output the encoding of number time_digit_value
+    segment_pins::write(pgm_read_byte(&patterns[time_digit_value]));
+
+    // Enable digit position time_digit by setting its pin to output (ground) and others
+    // to input (high impedance)
+    digit_pins::select(time_digit);
+#elif DISPLAY_BACKEND == 1
+    // Send the encoding to the MAX7219 if the digit position shows something else
+    max7219_set_digit(time_digit, pgm_read_byte(&patterns[time_digit_value]));
+#else
+    // Set the glyph of the OLED digit, it is sent by update_display() if it changed
+    ssd1306_set_digit(time_digit, time_digit_value);
+#endif
+
     if (hour_mode) {
         PORTB |= (1<<PORTB0);
     }
     else {
         PORTB &= ~(1<<PORTB0);
     }
-    
-    // Enable digit position time_digit by setting its pin to output (ground) and others
-    // to input (high impedance)
-    // DDRF &= ~((1 << DDF7)|(1 << DDF6)|(1 << DDF5));
-    // DDRK &= ~(1 << DDK4);
-    // switch(time_digit){
-    //     case 0:
-    //         DDRF |= (1 << DDF7);
-    //         break;
-    //     case 1:
-    //         DDRF |= (1 << DDF6);
-    //         break;
-    //     case 2:
-    //         DDRF |= (1 << DDF5);
-    //         break;
-    //     case 3:
-    //         DDRK |= (1 << DDK4);
-    //         break;
-    // }
 }
 
-// Display timer interrupt that triggers at 4*60 Hz rate. Displays one of the 4 digits on 
+// Display refresh that runs at 4*60 Hz rate. Displays one of the 4 digits on 
 // the 4-digit 7-segment display, then changes which digit to display for next time. 
 // Also displays the AM/PM LED status.
-ISR(TIMER0_OVF_vect){
+static inline void refresh_display(){
+
+#if DISPLAY_BACKEND == 0
+    // In night mode the digit is only lit for the first NIGHT_ON_COUNTS of its refresh, 
+    // the display timer compare A interrupt turns it off. The digits still rotate at 
+    // 4*60 Hz and the cursor blinks at the same pace. The flag of the last compare is 
+    // cleared so the interrupt does not run at once.
+    TIFR0 = (1 << OCF0A);
+    if(night_mode)
+        TIMSK0 |= (1 << OCIE0A);
+    else
+        TIMSK0 &= ~(1 << OCIE0A);
+#endif
 
     // Displays one of the 4 digits on the 4-digit 7-segment display and AM/PM status from buffer
     if(state == set_time || state == set_alarm){
@@ -144,7 +191,7 @@ ISR(TIMER0_OVF_vect){
         }
         // selected digit is in blink mode, show empty digit instead (10)
         if(time_digit_select == cursor_digit && cursor_blink){
-            display_time_digit(time_digit_select, 10);
+            display_time_digit(time_digit_select, DIGIT_BLANK);
         }
         else{
             display_time_digit(time_digit_select, buffer_time_digits[(int)time_digit_select]);
@@ -160,6 +207,16 @@ ISR(TIMER0_OVF_vect){
         else
             PORTH &= ~(1 << PORTH6);
     }
+    // Displays one of the 4 digits of the countdown or stopwatch, AM/PM LED off
+    else if(state == show_timer){
+        display_time_digit(time_digit_select, timer_display_digits[(int)time_digit_select]);
+        PORTH &= ~(1 << PORTH6);
+    }
+    // Displays one of the 4 digits of the temperature, AM/PM LED off
+    else if(state == show_temperature){
+        display_time_digit(time_digit_select, temperature_display_digits[(int)time_digit_select]);
+        PORTH &= ~(1 << PORTH6);
+    }
     // Displays one of the 4 digits on the 4-digit 7-segment display from clock and clock 
     // AM/PM
     else{
@@ -176,6 +233,22 @@ ISR(TIMER0_OVF_vect){
             PORTH &= ~(1 << PORTH6);
     }
 
+#if DISPLAY_BACKEND == 2
+    // The OLED shows AM/PM as text (none in 24 hour mode or for the timer and 
+    // temperature), the alarm bell and the state instead of the LEDs
+    char pm = -1;
+    if(hour_mode == 0 && (state == set_time || state == set_alarm))
+        pm = buffer_am_pm;
+    else if(hour_mode == 0 && (state == show_time || state == alarm_on))
+        pm = am_pm;
+    ssd1306_set_status(pm, alarm_activation, state != show_temperature, state);
+#endif
+
+    if(!first_frame_shown && time_digit_select == TIME_DIGITS_NUMBER - 1){
+        first_frame_shown = 1;
+        record_boot_phase(boot_first_frame);
+    }
+
     // changes which digit to display for next time
     time_digit_select += 1;
     if(time_digit_select == TIME_DIGITS_NUMBER) time_digit_select = 0;
@@ -205,6 +278,8 @@ ISR(TIMER0_OVF_vect){
 
     switch(state){
         case show_time:
+        case show_timer:
+        case show_temperature:
             if(alarm_activation)
                 PORTB |= (1 << PORTB4);
             else
@@ -224,4 +299,34 @@ ISR(TIMER0_OVF_vect){
             break;
     }
 
-}
\ No newline at end of file
+}
+
+#if DISPLAY_BACKEND == 0
+// Display timer interrupt that triggers at 4*60 Hz rate and refreshes one digit
+ISR(TIMER0_OVF_vect){
+    PROBE_SCOPE(probe_display_isr);
+    refresh_display();
+}
+
+// Display timer compare interrupt, enabled in night mode only: turns the digit off 
+// NIGHT_ON_COUNTS into its refresh
+ISR(TIMER0_COMPA_vect){
+    digit_pins::select_none();
+}
+#endif
+
+// Refreshes the display from the main loop when the display timer interrupt is not 
+// used (MAX7219 and SSD1306 backends). The display timer still runs and its overflow 
+// flag is polled, so the refresh and cursor blink keep the same pace as the interrupt. 
+// The OLED is then sent the cells that changed.
+void update_display(){
+#if DISPLAY_BACKEND != 0
+    if(TIFR0 & (1 << TOV0)){
+        TIFR0 = (1 << TOV0);
+        refresh_display();
+    }
+#endif
+#if DISPLAY_BACKEND == 2
+    ssd1306_flush();
+#endif
+}
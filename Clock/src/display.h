@@ -1,6 +1,12 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H 
 
+// Display values other than numbers 0 to 9 (see display_time_digit())
+#define DIGIT_BLANK 10
+#define DIGIT_C 11
+#define DIGIT_F 12
+#define DIGIT_MINUS 13
+
 // Initialize display system including 4-digit 7-segment display, AM/PM 
 // LED and alarm LED. Also initializes display timer (timer 0) which triggers 
 // the display timer interrupt about 4*60 times per second. The 4*60 Hz rate for
@@ -9,10 +15,16 @@
 void init_display();
 
 // Displays a number (digit) given in time_digit_value at the digit location 
-// given in time_digit on the 4-digit 7-segment display. PORTC[3:0] is used to select 
+// given in time_digit on the 4-digit 7-segment display. time_digit_value can also 
+// be one of the DIGIT_ values. PORTC[3:0] is used to select 
 // which digit position to display the number at. Setting one of these pins to output 
 // makes it a ground which activates the digit position while setting it to input makes it 
 // high impedance which deactivates the digit position.
 void display_time_digit(unsigned char time_digit, unsigned char time_digit_value);
 
+// Refreshes the display from the main loop when the display timer interrupt is not 
+// used (MAX7219 and SSD1306 backends), and sends the OLED the cells that changed. 
+// Does nothing when the display timer interrupt is used.
+void update_display();
+
 #endif
@@ -3,9 +3,12 @@
 
 /*Debug parameters*/ 
 
-// CLOCK_SPEED_FACTOR is a debug constant to accelerate the clock. 
-// In production, it is set to 1.
-#define CLOCK_SPEED_FACTOR 300
+// TIME_WARP_ENABLED lets the remote accelerate the clock at run time (1x, 60x or 3600x 
+// with / in show_time) to check alarms and rollovers. In production, it is set to 0, 
+// which locks the clock at 1x. Can be set from the build flags (-DTIME_WARP_ENABLED=1).
+#ifndef TIME_WARP_ENABLED
+#define TIME_WARP_ENABLED 0
+#endif
 
 /*Parameters*/ 
 
@@ -21,6 +24,55 @@
 // Initial value for alarm AM/PM
 #define INITIAL_ALARM_AM_PM 0
 
+// Initial value for date
+#define INITIAL_YEAR 2024
+#define INITIAL_MONTH 1
+#define INITIAL_DAY 1
+
+// Daylight saving time rules of the time zone (see dst_zones in calendar.cpp). 0 is no 
+// DST, 1 is United States/Canada, 2 is European Union, 3 is south-eastern Australia.
+#define DST_ZONE 1
+
+// GPS_ENABLED disciplines the clock to a GPS receiver: its 1PPS output on PE5 (INT5) 
+// steers the rate and phase of the clock timer, and the time and date are set from its 
+// NMEA RMC sentences at 9600 baud on USART2 (RXD2, PH0). Can be set from the build 
+// flags (-DGPS_ENABLED=1).
+#ifndef GPS_ENABLED
+#define GPS_ENABLED 0
+#endif
+
+// Offset of the standard time of the time zone from UTC in minutes, used to convert 
+// the GPS time. DST is added by the calendar (DST_ZONE).
+#define UTC_OFFSET_MINUTES (-300)
+
+// Minutes the alarm is snoozed for by a click of the snooze/dismiss button or a tap
+#define SNOOZE_MINUTES 9
+
+// Seconds the clock must be shaken to turn off the ringing alarm (at most 60)
+#define SHAKE_DISMISS_SECONDS 3
+
+// Hours (in 24hr time) at which the power manager night mode starts and ends
+#define NIGHT_START_HOUR 22
+#define NIGHT_END_HOUR 6
+
+// Wiring of the 4-digit 7-segment display. 0 is segments on PORTA and digit selects 
+// on PORTC[3:0]. 1 is the older wiring with segments spread across PORTF/PORTL/PORTG 
+// and digit selects on PORTF[7:5] and PORTK4.
+#define DISPLAY_WIRING 0
+
+// Display backend. 0 is the 4-digit 7-segment display multiplexed by the display timer 
+// interrupt on GPIO pins (DISPLAY_WIRING). 1 is a MAX7219 driver on the SPI bus which 
+// multiplexes the digits by itself, so the display timer interrupt is not used. 2 is a 
+// 128x64 SSD1306 OLED on the I2C bus (with the MPU) which is sent only the digits and 
+// icons that changed, from the interaction loop.
+#define DISPLAY_BACKEND 0
+
+// IR remote input filter. 0 samples the input once per 562.5 us NEC slot. 1 samples it 
+// three times per slot through a 3-sample median filter, which rejects glitches and 
+// dropouts shorter than a sample, and counts a bit once per burst even if jitter 
+// stretches the burst.
+#define REMOTE_FILTER 1
+
 /*Constants*/ 
 #define TIME_DIGITS_NUMBER 4 
 
@@ -28,9 +80,10 @@
 
 // State machine to control general behavior of system. Idle state is show_time.
 // Alarm on is when alarm is triggered. set_time and set_alarm are for setting the time 
-// and alarm time.
+// and alarm time. show_timer shows the countdowns and the stopwatch. show_temperature 
+// shows the MPU die temperature.
 typedef enum stateType_enum {
-    show_time, alarm_on, set_time, set_alarm}
+    show_time, alarm_on, set_time, set_alarm, show_timer, show_temperature}
 stateType;
 
 
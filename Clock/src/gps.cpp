@@ -0,0 +1,460 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "gps.h"
+#include "clock.h"
+#include "calendar.h"
+#include "power.h"
+#include "trace.h"
+
+// Only built with the GPS discipline
+#if GPS_ENABLED
+
+#if TIME_WARP_ENABLED
+#error "The time warp changes the clock minute counter that the GPS discipline steers"
+#endif
+
+// Timer counts in a nominal clock tick and in a second at the nominal crystal frequency
+#define TICK_COUNTS (clock_timer::top + 1L)
+#define PPS_NOMINAL_COUNTS (CLOCK_TICKS_PER_SECOND * TICK_COUNTS)
+
+// Largest crystal frequency error accepted for a PPS interval, in timer counts per
+// second (500 ppm). Longer or shorter intervals are missed or extra edges.
+#define PPS_MAX_ERROR_COUNTS 1000
+
+// Largest rate correction, in 1/65536 timer counts per tick (10 counts is 500 ppm)
+#define RATE_ADJUST_MAX (10L << 16)
+
+// The frequency is the mean of the PPS intervals, then a moving average over this
+// many intervals, which averages out the interrupt latency of the edge timestamps
+#define PPS_FREQUENCY_WEIGHT_MAX 64
+
+// Seconds over which a phase error is taken out
+#define PPS_PHASE_SECONDS 8
+
+// Holdover after this many ticks without a PPS edge
+#define PPS_TIMEOUT_TICKS (5 * CLOCK_TICKS_PER_SECOND / 2)
+
+// Longest NMEA sentence, from $ to the checksum
+#define NMEA_MAX_LENGTH 82
+
+// RMC fields used: UTC time (hhmmss.ss), status (A is a valid fix) and date (ddmmyy)
+#define RMC_FIELD_TIME 1
+#define RMC_FIELD_STATUS 2
+#define RMC_FIELD_DATE 9
+
+// Clock ticks in a day
+#define TICKS_PER_DAY (24UL * 60 * CLOCK_TICKS_PER_MINUTE)
+
+// State of the NMEA parser in the sentence being received
+typedef enum nmeaState_enum {
+    nmea_wait_start, nmea_fields, nmea_checksum_high, nmea_checksum_low}
+nmeaState;
+
+nmeaState nmea_state = nmea_wait_start;
+// Field of the sentence (0 is the sentence type) and character in the field
+unsigned char nmea_field = 0;
+unsigned char nmea_position = 0;
+// Characters received since $, to drop a sentence that never ends
+unsigned char nmea_length = 0;
+// XOR of the characters between $ and *, and checksum received after *
+unsigned char nmea_checksum = 0;
+unsigned char nmea_received_checksum = 0;
+// 1 while the sentence type is RMC, status field of the sentence
+char nmea_is_rmc = 0;
+char nmea_status = 0;
+// Digits of the time (hhmmss) and date (ddmmyy) fields and how many were received
+unsigned char nmea_time[6];
+unsigned char nmea_date[6];
+unsigned char nmea_time_digits = 0;
+unsigned char nmea_date_digits = 0;
+
+// State of the discipline and frequency learned from the PPS in 1/65536 timer counts
+// per clock tick (rate correction of the clock timer)
+volatile gpsState gps_state = gps_free_running;
+volatile long gps_frequency = 0;
+// Number of PPS intervals averaged in gps_frequency, up to PPS_FREQUENCY_WEIGHT_MAX
+unsigned char gps_frequency_weight = 0;
+
+// Rate correction of the clock timer currently applied
+long gps_rate = 0;
+
+// Last PPS edge timestamp and 1 until gps_update() has used it
+volatile clockTimestamp pps_stamp;
+volatile char pps_captured = 0;
+// Tick (clock_ticks) of the last PPS edge, 0 before the first one
+volatile unsigned long pps_tick = 0;
+
+// Last RMC fix, tick at which its sentence started and 1 until gps_update() has used it
+volatile nmeaFix gps_fix;
+volatile unsigned long gps_fix_tick = 0;
+volatile char gps_fix_received = 0;
+// Tick at which the sentence being received started
+unsigned long nmea_start_tick = 0;
+
+// Number of clock timer interrupts since init_clock() (global variable in clock)
+extern volatile unsigned long clock_ticks;
+
+// Current system state (global variable in main)
+extern volatile stateType state;
+
+// Value of a hexadecimal digit, 0xFF if c is not one
+static unsigned char hex_value(char c){
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return 0xFF;
+}
+
+// Stores a character of one of the fields used
+static void nmea_field_character(char c){
+
+    // sentence type: 2 characters of talker (GP, GN...) then RMC
+    if(nmea_field == 0){
+        if(nmea_position < 2)
+            return;
+        if(nmea_position > 4 || c != "RMC"[nmea_position - 2])
+            nmea_is_rmc = 0;
+        return;
+    }
+
+    if(!nmea_is_rmc)
+        return;
+
+    char digit = (c >= '0' && c <= '9');
+    if(nmea_field == RMC_FIELD_TIME && nmea_position < 6){
+        if(digit && nmea_time_digits == nmea_position){
+            nmea_time[nmea_position] = c - '0';
+            nmea_time_digits += 1;
+        }
+    }
+    else if(nmea_field == RMC_FIELD_STATUS && nmea_position == 0){
+        nmea_status = c;
+    }
+    else if(nmea_field == RMC_FIELD_DATE && nmea_position < 6){
+        if(digit && nmea_date_digits == nmea_position){
+            nmea_date[nmea_position] = c - '0';
+            nmea_date_digits += 1;
+        }
+    }
+}
+
+// Converts the fields of a complete RMC sentence. Returns 0 if they are out of range
+// (or a leap second).
+static int nmea_fill_fix(nmeaFix * fix){
+
+    if(nmea_time_digits != 6 || nmea_date_digits != 6 || nmea_status != 'A')
+        return 0;
+
+    fix->hours = nmea_time[0] * 10 + nmea_time[1];
+    fix->minutes = nmea_time[2] * 10 + nmea_time[3];
+    fix->seconds = nmea_time[4] * 10 + nmea_time[5];
+    fix->day = nmea_date[0] * 10 + nmea_date[1];
+    fix->month = nmea_date[2] * 10 + nmea_date[3];
+    fix->year = 2000 + nmea_date[4] * 10 + nmea_date[5];
+
+    return fix->hours < 24 && fix->minutes < 60 && fix->seconds < 60 &&
+        fix->day >= 1 && fix->day <= 31 && fix->month >= 1 && fix->month <= 12;
+}
+
+// Feeds one character received from the GPS to the NMEA parser. Returns 1 and fills
+// fix when it completes an RMC sentence ($GPRMC, $GNRMC...) with a valid fix and
+// checksum, 0 otherwise. Parses as the characters come, with no sentence buffer, and
+// touches no registers so recorded NMEA streams can be replayed through it off-target.
+int nmea_feed(char c, nmeaFix * fix){
+
+    // a $ always starts a new sentence, even in the middle of a broken one
+    if(c == '$'){
+        nmea_state = nmea_fields;
+        nmea_field = 0;
+        nmea_position = 0;
+        nmea_length = 0;
+        nmea_checksum = 0;
+        nmea_is_rmc = 1;
+        nmea_status = 0;
+        nmea_time_digits = 0;
+        nmea_date_digits = 0;
+        return 0;
+    }
+
+    if(nmea_state == nmea_wait_start)
+        return 0;
+
+    nmea_length += 1;
+    if(nmea_length > NMEA_MAX_LENGTH){
+        nmea_state = nmea_wait_start;
+        return 0;
+    }
+
+    if(nmea_state == nmea_fields){
+        if(c == '*'){
+            nmea_state = nmea_checksum_high;
+        }
+        else if(c == '\r' || c == '\n'){
+            // sentence without a checksum
+            nmea_state = nmea_wait_start;
+        }
+        else{
+            nmea_checksum ^= c;
+            if(c == ','){
+                if(nmea_field == 0 && nmea_position != 5)
+                    nmea_is_rmc = 0;
+                nmea_field += 1;
+                nmea_position = 0;
+            }
+            else{
+                nmea_field_character(c);
+                nmea_position += 1;
+            }
+        }
+        return 0;
+    }
+
+    unsigned char value = hex_value(c);
+    if(value == 0xFF){
+        nmea_state = nmea_wait_start;
+        return 0;
+    }
+
+    if(nmea_state == nmea_checksum_high){
+        nmea_received_checksum = value << 4;
+        nmea_state = nmea_checksum_low;
+        return 0;
+    }
+
+    // second checksum digit: the sentence is complete
+    nmea_state = nmea_wait_start;
+    nmea_received_checksum |= value;
+    if(nmea_received_checksum != nmea_checksum || !nmea_is_rmc || nmea_field < RMC_FIELD_DATE)
+        return 0;
+    return nmea_fill_fix(fix);
+}
+
+// Runs the discipline loop for a PPS edge: elapsed_counts timer counts since the
+// previous edge and the edge at phase_counts timer counts after the start of the second
+// of the clock time (negative if before). Returns the rate correction of the clock
+// timer in 1/65536 timer counts per tick. Touches no registers, so simulated PPS
+// sequences can be run through it off-target.
+long discipline_pps(unsigned long elapsed_counts, long phase_counts){
+
+    // The crystal frequency: timer counts in a second of the PPS. An interval that is
+    // too far from a second (first edge, missed or extra edge) is not used.
+    long error = (long)(elapsed_counts - PPS_NOMINAL_COUNTS);
+    if(error >= -PPS_MAX_ERROR_COUNTS && error <= PPS_MAX_ERROR_COUNTS){
+        long measured = error * 65536L / CLOCK_TICKS_PER_SECOND;
+        if(gps_frequency_weight < PPS_FREQUENCY_WEIGHT_MAX)
+            gps_frequency_weight += 1;
+        // rounded, a truncated step would bias the average towards 0
+        long step = measured - gps_frequency;
+        step += (step < 0 ? -gps_frequency_weight : gps_frequency_weight) / 2;
+        gps_frequency += step / gps_frequency_weight;
+    }
+
+    // No frequency yet, keep the nominal rate until the next edge
+    if(gps_frequency_weight == 0)
+        return 0;
+
+    // The phase is at most half a tick once the clock has been stepped, but can be up to
+    // half a second when step_clock() refused the step. A tick of phase already gives
+    // more than RATE_ADJUST_MAX, and more would overflow the product below.
+    if(phase_counts > TICK_COUNTS)
+        phase_counts = TICK_COUNTS;
+    if(phase_counts < -TICK_COUNTS)
+        phase_counts = -TICK_COUNTS;
+
+    // The clock second started phase_counts before the edge: the clock is ahead, so
+    // the ticks are lengthened to take the phase out over PPS_PHASE_SECONDS
+    long adjust = gps_frequency +
+        phase_counts * 65536L / (CLOCK_TICKS_PER_SECOND * PPS_PHASE_SECONDS);
+    if(adjust > RATE_ADJUST_MAX)
+        adjust = RATE_ADJUST_MAX;
+    if(adjust < -RATE_ADJUST_MAX)
+        adjust = -RATE_ADJUST_MAX;
+    return adjust;
+}
+
+// Sets up USART2 to receive NMEA at 9600 baud and the PPS edge interrupt on PE5 (INT5)
+void init_gps(){
+
+    power_request(power_usart2);
+
+    // 9600 baud: UBRR = 16 MHz / (16 * 9600) - 1 = 103 (0.2 % error), 8N1, receive only
+    // with the receive complete interrupt
+    UBRR2 = 103;
+    UCSR2C = (1 << UCSZ21) | (1 << UCSZ20);
+    UCSR2B = (1 << RXEN2) | (1 << RXCIE2);
+
+    // PE5 input without pullup (driven by the receiver), interrupt on the rising edge
+    DDRE &= ~(1 << DDE5);
+    PORTE &= ~(1 << PORTE5);
+    EICRB |= (1 << ISC51) | (1 << ISC50);
+    EIFR = (1 << INTF5);
+    EIMSK |= (1 << INT5);
+}
+
+// Steers the clock from a PPS edge timestamp
+static void discipline_from_stamp(const clockTimestamp * stamp){
+
+    // Position of the edge in the second of the clock time, in timer counts, with the
+    // ticks at the length the rate correction gives them
+    long ticks = stamp->minute_ticks % CLOCK_TICKS_PER_SECOND;
+    long phase = ticks * TICK_COUNTS + stamp->count + (ticks * gps_rate >> 16);
+    long second_counts = PPS_NOMINAL_COUNTS + (CLOCK_TICKS_PER_SECOND * gps_rate >> 16);
+    if(phase > second_counts / 2)
+        phase -= second_counts;
+
+    // More than half a tick off (first lock, time set by hand): step by whole ticks
+    // and only slew the rest
+    int step = (phase + (phase < 0 ? -TICK_COUNTS / 2 : TICK_COUNTS / 2)) / TICK_COUNTS;
+    if(step != 0 && step_clock(-step))
+        phase -= step * TICK_COUNTS;
+
+    gps_rate = discipline_pps(stamp->elapsed_counts, phase);
+    set_clock_rate(gps_rate);
+
+    if(gps_frequency_weight != 0 && gps_state != gps_locked){
+        gps_state = gps_locked;
+        trace(trace_gps, gps_locked);
+    }
+}
+
+// Sets the clock time and date from an RMC fix, taken at the tick of the start of its
+// second, if they differ from the clock by more than tolerance ticks
+static void set_time_from_fix(const nmeaFix * fix, unsigned long fix_tick, unsigned long now,
+    long tolerance){
+
+    // Standard time of the time zone in minutes since midnight and days since 2000
+    long minutes = fix->hours * 60L + fix->minutes + UTC_OFFSET_MINUTES;
+    unsigned int days = days_from_civil(fix->year, fix->month, fix->day);
+
+    // The DST state of the calendar gives the clock time, it is evaluated again once
+    // the date is set and the time recomputed if it changed
+    char dst = dst_active;
+    for(unsigned char pass = 0; pass < 2; pass++){
+        long clock_minutes = minutes + (dst ? 60 : 0);
+        unsigned int clock_days = days;
+        if(clock_minutes < 0){
+            clock_minutes += 24 * 60;
+            clock_days -= 1;
+        }
+        else if(clock_minutes >= 24 * 60){
+            clock_minutes -= 24 * 60;
+            clock_days += 1;
+        }
+
+        unsigned long target = (clock_minutes * 60 + fix->seconds) * CLOCK_TICKS_PER_SECOND +
+            (now - fix_tick);
+        if(target >= TICKS_PER_DAY){
+            target -= TICKS_PER_DAY;
+            clock_days += 1;
+        }
+
+        long difference = (long)(target - clock_day_ticks());
+        if(clock_days == day_number && difference >= -tolerance && difference <= tolerance)
+            return;
+
+        civilDate date = civil_from_days(clock_days);
+        set_date(date.year, date.month, date.day, target / (60UL * CLOCK_TICKS_PER_MINUTE));
+        set_clock_day_ticks(target);
+        if(dst_active == dst)
+            break;
+        dst = dst_active;
+    }
+}
+
+// Steers the clock from the last PPS edge, sets the time and date from the last RMC
+// sentence when they differ from the clock and goes into holdover when the PPS stops.
+// Called from the interaction loop.
+void gps_update(){
+
+    clockTimestamp stamp;
+    nmeaFix fix;
+    char captured, received;
+    unsigned long fix_tick, last_pps_tick, now;
+
+    // copy what the interrupts left with interrupts disabled
+    unsigned char sreg = SREG;
+    cli();
+    captured = pps_captured;
+    pps_captured = 0;
+    stamp.elapsed_counts = pps_stamp.elapsed_counts;
+    stamp.minute_ticks = pps_stamp.minute_ticks;
+    stamp.count = pps_stamp.count;
+    stamp.tick = pps_stamp.tick;
+    received = gps_fix_received;
+    gps_fix_received = 0;
+    fix.hours = gps_fix.hours;
+    fix.minutes = gps_fix.minutes;
+    fix.seconds = gps_fix.seconds;
+    fix.day = gps_fix.day;
+    fix.month = gps_fix.month;
+    fix.year = gps_fix.year;
+    fix_tick = gps_fix_tick;
+    last_pps_tick = pps_tick;
+    now = clock_ticks;
+    SREG = sreg;
+
+    if(captured)
+        discipline_from_stamp(&stamp);
+
+    // No PPS for a while: keep the frequency learned and stop steering the phase
+    if(gps_state == gps_locked && now - last_pps_tick > PPS_TIMEOUT_TICKS){
+        gps_state = gps_holdover;
+        gps_rate = gps_frequency;
+        set_clock_rate(gps_rate);
+        trace(trace_gps, gps_holdover);
+    }
+
+    // The buffer being set by hand is not overwritten
+    if(!received || state == set_time || state == set_alarm)
+        return;
+
+    // Locked, the fix is the time of the PPS edge that started its second (a sentence 
+    // that started before the last edge is from the second before and is skipped) and 
+    // one tick of difference is left to the phase discipline. Without PPS, the time 
+    // the sentence started is only good to about a second.
+    if(gps_state == gps_locked){
+        if(fix_tick - last_pps_tick < CLOCK_TICKS_PER_SECOND)
+            set_time_from_fix(&fix, last_pps_tick, now, 1);
+    }
+    else{
+        set_time_from_fix(&fix, fix_tick, now, CLOCK_TICKS_PER_SECOND);
+    }
+}
+
+// PPS edge interrupt: timestamps the edge against the clock timer. Taken before the
+// timer interrupts pending with it, the timestamp is only as precise as the delay 
+// before this routine runs.
+ISR(INT5_vect){
+    clockTimestamp stamp;
+    clock_timestamp(&stamp);
+    pps_stamp.elapsed_counts = stamp.elapsed_counts;
+    pps_stamp.minute_ticks = stamp.minute_ticks;
+    pps_stamp.count = stamp.count;
+    pps_stamp.tick = stamp.tick;
+    pps_tick = stamp.tick;
+    pps_captured = 1;
+}
+
+// GPS receive interrupt: feeds the character to the NMEA parser and keeps the fix of
+// a complete RMC sentence for gps_update()
+ISR(USART2_RX_vect){
+    char c = UDR2;
+    if(c == '$')
+        nmea_start_tick = clock_ticks;
+
+    nmeaFix fix;
+    if(nmea_feed(c, &fix)){
+        gps_fix.hours = fix.hours;
+        gps_fix.minutes = fix.minutes;
+        gps_fix.seconds = fix.seconds;
+        gps_fix.day = fix.day;
+        gps_fix.month = fix.month;
+        gps_fix.year = fix.year;
+        gps_fix_tick = nmea_start_tick;
+        gps_fix_received = 1;
+    }
+}
+
+#endif
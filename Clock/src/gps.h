@@ -0,0 +1,58 @@
+#ifndef GPS_H
+#define GPS_H
+
+#include "global_header.h"
+
+// Clock discipline from a GPS receiver (GPS_ENABLED in global_header.h). Every 1PPS 
+// edge is timestamped against the clock timer: the timer counts between two edges give 
+// the crystal frequency, which sets the length of the clock ticks, and the position of 
+// the edge in the second of the clock time gives the phase, which is taken out over a 
+// few seconds. Without PPS the clock holds over on the last frequency learned. The time 
+// of day and the date are set from NMEA RMC sentences.
+
+// State of the discipline: free running at the nominal rate (no PPS seen yet), locked 
+// to the PPS, or holding over on the learned frequency since the PPS stopped
+typedef enum gpsState_enum {
+    gps_free_running, gps_locked, gps_holdover}
+gpsState;
+
+// UTC time and date of an NMEA RMC sentence with a valid fix
+typedef struct nmeaFix_struct {
+    unsigned char hours;
+    unsigned char minutes;
+    unsigned char seconds;
+    unsigned char day;
+    unsigned char month;
+    unsigned int year;
+} nmeaFix;
+
+#if GPS_ENABLED
+extern volatile gpsState gps_state;
+
+// Frequency learned from the PPS in 1/65536 timer counts per clock tick (rate 
+// correction of the clock timer)
+extern volatile long gps_frequency;
+
+// Feeds one character received from the GPS to the NMEA parser. Returns 1 and fills 
+// fix when it completes an RMC sentence ($GPRMC, $GNRMC...) with a valid fix and 
+// checksum, 0 otherwise. Parses as the characters come, with no sentence buffer, and 
+// touches no registers so recorded NMEA streams can be replayed through it off-target.
+int nmea_feed(char c, nmeaFix * fix);
+
+// Runs the discipline loop for a PPS edge: elapsed_counts timer counts since the 
+// previous edge and the edge at phase_counts timer counts after the start of the second 
+// of the clock time (negative if before). Returns the rate correction of the clock 
+// timer in 1/65536 timer counts per tick. Touches no registers, so simulated PPS 
+// sequences can be run through it off-target.
+long discipline_pps(unsigned long elapsed_counts, long phase_counts);
+
+// Sets up USART2 to receive NMEA at 9600 baud and the PPS edge interrupt on PE5 (INT5)
+void init_gps();
+
+// Steers the clock from the last PPS edge, sets the time and date from the last RMC 
+// sentence when they differ from the clock and goes into holdover when the PPS stops. 
+// Called from the interaction loop.
+void gps_update();
+#endif
+
+#endif
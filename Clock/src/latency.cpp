@@ -0,0 +1,100 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "latency.h"
+#include "clock.h"
+
+// Time (clock_uptime_us()) at which the last IR frame ended (global variable in remote)
+extern volatile unsigned long remote_frame_time;
+
+// Interaction loop iteration times
+latencyHistogram loop_latency;
+
+// Times from the end of an IR frame to the end of the interaction loop iteration that 
+// handled its button
+latencyHistogram input_latency;
+
+// Jitter of the remote timer interrupt (in cycles) and of the clock timer interrupt 
+// (in 0.5 us counts)
+volatile isrJitter remote_isr_jitter = {0xFFFF, 0};
+volatile isrJitter clock_isr_jitter = {0xFFFF, 0};
+
+// Start time of the current interaction loop iteration, 0 before the first one
+unsigned long loop_start_time = 0;
+
+// Adds a time in microseconds to a histogram
+void record_latency(latencyHistogram * histogram, unsigned long us){
+
+    // bucket is the number of bits of the time
+    unsigned char bucket = 0;
+    while(us >> bucket && bucket < LATENCY_BUCKETS - 1)
+        bucket += 1;
+
+    if(histogram->buckets[bucket] != 0xFFFF)
+        histogram->buckets[bucket] += 1;
+    if(histogram->count != 0xFFFF)
+        histogram->count += 1;
+    if(us > histogram->max_us)
+        histogram->max_us = us;
+}
+
+// Marks the start of an interaction loop iteration and records the time since the 
+// start of the previous one
+void loop_started(){
+
+    unsigned long now = clock_uptime_us();
+    if(loop_start_time != 0)
+        record_latency(&loop_latency, now - loop_start_time);
+    loop_start_time = now;
+}
+
+// Records the time since the end of the IR frame of the button that was just handled
+void input_handled(){
+
+    // written by the remote timer interrupt
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long frame_time = remote_frame_time;
+    SREG = sreg;
+
+    record_latency(&input_latency, clock_uptime_us() - frame_time);
+}
+
+// Returns the lowest time in microseconds under which the given percentage of the 
+// times of a histogram fall (upper bound of the bucket), 0 if it is empty
+unsigned long latency_percentile(const latencyHistogram * histogram, unsigned char percent){
+
+    if(histogram->count == 0)
+        return 0;
+
+    // times needed, rounded up
+    unsigned long needed = ((unsigned long)histogram->count * percent + 99) / 100;
+    unsigned long seen = 0;
+    for(unsigned char bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++){
+        seen += histogram->buckets[bucket];
+        if(seen >= needed)
+            return 1UL << bucket;
+    }
+    return histogram->max_us;
+}
+
+// Empties both histograms and the jitter records
+void reset_latency(){
+
+    unsigned char sreg = SREG;
+    cli();
+    remote_isr_jitter.min_count = 0xFFFF;
+    remote_isr_jitter.max_count = 0;
+    clock_isr_jitter.min_count = 0xFFFF;
+    clock_isr_jitter.max_count = 0;
+    SREG = sreg;
+
+    for(unsigned char bucket = 0; bucket < LATENCY_BUCKETS; bucket++){
+        loop_latency.buckets[bucket] = 0;
+        input_latency.buckets[bucket] = 0;
+    }
+    loop_latency.count = 0;
+    loop_latency.max_us = 0;
+    input_latency.count = 0;
+    input_latency.max_us = 0;
+    loop_start_time = 0;
+}
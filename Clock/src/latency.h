@@ -0,0 +1,63 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+// Histograms of the interaction loop iteration time and of the latency from the end 
+// of an IR frame to the state and display buffer being updated by the interaction 
+// loop. Bucket 0 counts times under 1 us and bucket k (from 1) counts times from 
+// 2^(k-1) us to 2^k us, the last bucket also counting everything longer.
+#define LATENCY_BUCKETS 18
+
+// Histogram of measured times with the longest one. Counters stop at 0xFFFF.
+typedef struct latencyHistogram_struct {
+    unsigned int buckets [LATENCY_BUCKETS];
+    unsigned int count;
+    unsigned long max_us;
+} latencyHistogram;
+
+// Interaction loop iteration times
+extern latencyHistogram loop_latency;
+
+// Times from the end of an IR frame to the end of the interaction loop iteration that 
+// handled its button
+extern latencyHistogram input_latency;
+
+// Spread of the time between the compare match of a timer and the start of its 
+// interrupt routine, read from the timer counter at the start of the routine. 
+// max_count - min_count is the jitter of the routine in timer counts, caused by the 
+// other interrupt routines delaying it. Recorded in the benchmark build (PROBE_ENABLED).
+typedef struct isrJitter_struct {
+    unsigned int min_count;
+    unsigned int max_count;
+} isrJitter;
+
+// Jitter of the remote timer interrupt (in cycles) and of the clock timer interrupt 
+// (in 0.5 us counts)
+extern volatile isrJitter remote_isr_jitter;
+extern volatile isrJitter clock_isr_jitter;
+
+// Records the timer counter read at the start of an interrupt routine
+static inline void record_isr_entry(volatile isrJitter * jitter, unsigned int count){
+    if(count < jitter->min_count)
+        jitter->min_count = count;
+    if(count > jitter->max_count)
+        jitter->max_count = count;
+}
+
+// Adds a time in microseconds to a histogram
+void record_latency(latencyHistogram * histogram, unsigned long us);
+
+// Marks the start of an interaction loop iteration and records the time since the 
+// start of the previous one
+void loop_started();
+
+// Records the time since the end of the IR frame of the button that was just handled
+void input_handled();
+
+// Returns the lowest time in microseconds under which the given percentage of the 
+// times of a histogram fall (upper bound of the bucket), 0 if it is empty
+unsigned long latency_percentile(const latencyHistogram * histogram, unsigned char percent);
+
+// Empties both histograms and the jitter records
+void reset_latency();
+
+#endif
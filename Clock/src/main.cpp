@@ -7,7 +7,18 @@
 #include "remote.h"
 #include "PWM.h"
 #include "I2C.h"
-#include "Arduino.h"
+#include "watchdog.h"
+#include "power.h"
+#include "boot.h"
+#include "warm_restart.h"
+#include "countdown.h"
+#include "trace.h"
+#include "calendar.h"
+#include "probe.h"
+#include "latency.h"
+#include "switch.h"
+#include "ui.h"
+#include "gps.h"
 
 // Current system state (initially idle state) (global variable in main)
 volatile stateType state = show_time;
@@ -30,124 +41,177 @@ volatile char cursor_digit = 0;
 // Status of alarm being activated or deactivated (global variable in main)
 volatile char alarm_activation = 1; // 1 is activated, 0 is deactivated
 
+// In the host simulator (native test environment) the test program has its own main() 
+// and starts this one with sim_boot()
+#if SIM_NATIVE
+#define main firmware_main
+#endif
 
 int main() {
 
-    // Initializes clock timer (timer 0) which triggers the clock timer interrupt 
-    // every 4 seconds.
+    // Stop the clock of every peripheral, each driver turns on what it uses
+    init_power();
+
+    // Benchmark timing probes on PORTF (only with PROBE_ENABLED)
+    PROBE_INIT();
+
+    // Warm restart (watchdog, brown-out or reset line): continue with the time, alarm 
+    // and mode from before the reset if they survived in RAM, instead of the initial 
+    // values from global_header.h. Every init step below still runs, a reset puts all 
+    // the peripheral registers back to their reset values.
+    int warm_restart = restore_clock_state();
+
+    // Work out from the date and time whether daylight saving time is in effect
+    init_calendar(clock_hours_24());
+
+    // Event trace, kept across a warm restart. After a watchdog reset the events that 
+    // led to it are sent on USB for tools/trace_decode.py.
+    init_trace();
+    if(reset_by_watchdog())
+        dump_trace();
+
+    // Timekeeping and display come up first so the time is shown as soon as possible. 
+    // Boot phase timestamps are measured from init_clock().
+
+    // Initializes clock timer (timer 1) which triggers the clock timer interrupt 
+    // every 10 ms.
     init_clock();
+    record_boot_phase(boot_clock);
 
     // Initialize display system including 4-digit 7-segment display, AM/PM 
     // LED and alarm LED along with their display refresh timer.
     init_display();
+    record_boot_phase(boot_display);
+
+    // enable global interrupts (multiple interrupts are used in the program)
+    // so the clock and display run while the other modules are initialized
+    sei();
+    record_boot_phase(boot_interrupts);
 
     // Initialize remote with its timer (timer 3) for receiving IR NEC signals.
     init_remote();
+    record_boot_phase(boot_remote);
 
     // Initialize alarm with its timers (timer 4 and timer 5)
     initPWM();
 
+    // Snooze/dismiss button on PE4, debounced with the timer wheel
+    initSwitchPE4();
+
+#if GPS_ENABLED
+    // GPS receiver: PPS edge on PE5 and NMEA on USART2
+    init_gps();
+#endif
+
+    // An alarm that was ringing before a warm restart keeps ringing
+    if(warm_restart && state == alarm_on)
+        turn_on_alarm();
+    record_boot_phase(boot_alarm);
+
     // Initialize the I2C module
     InitI2C();
 
-    // Initialize the MPU by waking it up
-    InitMPU();
+    // Warm restart after the watchdog fired: the main loop most likely stalled on 
+    // the I2C bus, so clear a slave that may still be holding SDA low.
+    if(reset_by_watchdog())
+        recover_i2c_bus();
+    record_boot_phase(boot_i2c);
 
-    // enable global interrupts (multiple interrupts are used in the program)
-    // interrupts are enabled after initialization procedure
-    sei();
+    // The MPU is woken up in the background by poll_movement() in the interaction 
+    // loop, with retries, so a slow or missing MPU does not hold up the boot.
+
+    // Reset the MCU if the interaction loop stops running for more than a second
+    init_watchdog();
+    record_boot_phase(boot_main_loop);
 
     // button click received from remote
     char button;
+
+    // state at the previous loop, to trace state changes (also made by interrupts)
+    stateType traced_state = state;
     
     // Infinite interaction loop which handles inputs from user through remote
     while (1) {
 
-        // Check if the MPU is detecting movement
-        if(check_movement()){
-            if(state == alarm_on){
-                turn_off_alarm();
-                state = show_time;
-            }
-        }
+        // The loop is still running, restart the watchdog timeout
+        feed_watchdog();
+        PROBE_TOGGLE(probe_main_loop);
 
-        // get inputs from remote
-        button = get_remote_input();
+        // Loop iteration time histogram (latency.h)
+        loop_started();
 
-        if(button == 0)
-            continue;
+        // Advance the clock time by the minutes counted by the clock timer interrupt 
+        // and do its once a second work
+        update_clock();
 
-        // button to activated/deactivate alarm trigger
-        if(button == 'A'){
-            if(state == show_time)
-                alarm_activation = !alarm_activation;
+        if(state != traced_state){
+            traced_state = state;
+            trace(trace_state, traced_state);
         }
 
-        // S is the button to turn off the alarm
-        if(button == 'S'){
-            if(state == alarm_on){
-                turn_off_alarm();
-                state = show_time;
-            }
-        }
+#if GPS_ENABLED
+        // Steer the clock to the GPS and set the time and date from it
+        gps_update();
+#endif
 
-        // M is the button to change mode between show_time, set_time, and set_alarm. 
-        // It also resets the cursor to the first digit and loads/saves buffer time 
-        // to set clock time and alarm time.
-        if(button == 'M'){
-            if(state == show_time){
-                // set buffer time to clock time
-                load_time_to_buffer((char *)time_digits, am_pm);
-                state = set_time;
-            }
-            else if(state == set_time){
-                // save buffer time to clock time
-                save_buffer_to_time((char *)time_digits, (char *)(&am_pm));
-                // set buffer time to alarm time
-                load_time_to_buffer((char *)alarm_time_digits, alarm_am_pm);
-                state = set_alarm;
-            }
-            else if(state == set_alarm){
-                // save buffer time to alarm time
-                save_buffer_to_time((char *)alarm_time_digits, (char *)(&alarm_am_pm));
-                state = show_time;
-            }
-            cursor_digit = 0;
-        }
-        // if Vol- button is pressed, change the current time to the correct mode if needed and change hour_mode id
-        if (button == 'P') {
-            change_hour_mode();
+        // Refresh the display if it is not refreshed by the display timer interrupt
+        update_display();
+
+        // Check the MPU for a tap, which snoozes the ringing alarm, or for shaking, 
+        // which turns it off (brings up the MPU first)
+        shakeGesture gesture = poll_movement();
+        if(gesture != shake_none){
+            trace(trace_motion, (gesture << 8) | state);
+            dispatch_event(shake_event(gesture), 0);
         }
 
-        // These are the controls to set time and set alarm
-        if(state == set_time || state == set_alarm){
-
-            // 0 to 9 are the buttons to change the buffer digit at the cursor. 
-            // Also create a right button click to move cursor.
-            if(button >= '0' && button <= '9'){
-                buffer_time_digits[(int)cursor_digit] = button - '0';
-                button = 'R';
-            }
-            // / is the button to switch between am and pm for the buffer, if in 12hr mode
-            else if(button == '/'){
-                if (hour_mode == 0) {
-                    buffer_am_pm = !buffer_am_pm;
-                }
-            }
-
-            // R and L are the buttons to move the cursor right and left with 
-            // wrapping up at the ends.
-            if(button == 'R'){
-                cursor_digit += 1;
-                if(cursor_digit == 4)
-                    cursor_digit = 0;
-            }
-            else if(button == 'L'){
-                cursor_digit -= 1;
-                if(cursor_digit == -1)
-                    cursor_digit = 3;
-            }
+        // Keep the countdown or stopwatch on the display up to date
+        if(state == show_timer)
+            update_timer_display();
+
+        // Keep the temperature on the display up to date
+        if(state == show_temperature)
+            update_temperature_display();
+
+        // Snooze/dismiss button: a click snoozes the ringing alarm, a long press turns 
+        // it off and a double click activates/deactivates the alarm
+        switchEvent switch_input = get_switch_event();
+        if(switch_input != switch_none){
+            trace(trace_switch, switch_input);
+            dispatch_event(switch_event(switch_input), 0);
         }
+
+        // A countdown or the snooze expired: the alarm rings, leaving the current 
+        // state through its exit action (set_time and set_alarm save their buffer)
+        if(countdown_take_expired())
+            dispatch_event(event_countdown, 0);
+
+        // The clock reached the alarm time: the alarm rings unless the time or the alarm 
+        // is being set
+        if(alarm_take_due())
+            dispatch_event(event_alarm, 0);
+
+        // get inputs from remote
+        button = get_remote_input();
+
+        if(button == 0)
+            continue;
+
+        if(button == 'E')
+            trace(trace_remote_error, button);
+        else
+            trace(trace_button, button);
+
+        // The button is handled by the transition table of the current state (ui.cpp): 
+        // M changes mode between show_time, set_time, set_alarm, show_timer and 
+        // show_temperature, A activates/deactivates the alarm, S turns it off, P 
+        // switches between 12 and 24 hour mode, and 0 to 9, R, L and / set the time 
+        // and alarm, control the countdowns and stopwatch and switch the temperature unit
+        dispatch_event(button_event(button), button);
+
+        // The state and display buffer now reflect the button, record the time since 
+        // the end of its IR frame
+        input_handled();
     }
     return 0;
 
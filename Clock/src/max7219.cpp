@@ -0,0 +1,140 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "max7219.h"
+#include "power.h"
+#include "probe.h"
+
+// Only built for the MAX7219 display backend
+#if DISPLAY_BACKEND == 1
+
+// MAX7219 register addresses
+#define MAX7219_DIGIT0 0x01 // digit registers are 0x01 to 0x08
+#define MAX7219_DECODE_MODE 0x09
+#define MAX7219_INTENSITY 0x0A
+#define MAX7219_SCAN_LIMIT 0x0B
+#define MAX7219_SHUTDOWN 0x0C
+#define MAX7219_DISPLAY_TEST 0x0F
+
+// Number of 16-bit register writes the transmit queue can hold (power of 2)
+#define MAX7219_QUEUE_SIZE 16
+
+// LOAD (chip select) pin of the MAX7219. The data is latched on its rising edge.
+// PB0 (SS) is used by the display as the 24hr mode LED and stays an output, which 
+// keeps the SPI module in master mode.
+#define MAX7219_LOAD PORTB6
+
+// Transmit queue of register writes, high byte is the register address and low byte 
+// is the data. Filled by the main loop and emptied by the SPI interrupt.
+volatile unsigned int spi_queue[MAX7219_QUEUE_SIZE];
+volatile unsigned char spi_queue_head = 0;
+volatile unsigned char spi_queue_tail = 0;
+// 1 while a register write is being shifted out
+volatile unsigned char spi_busy = 0;
+// 1 after the address byte was sent and the data byte is being sent
+volatile unsigned char spi_second_byte = 0;
+
+// Segment patterns last queued for each digit position, used to skip unchanged digits.
+// 0xFF is never queued by the display so it forces the first write.
+unsigned char max7219_frame[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+// Starts shifting out the register write at the head of the queue
+static void start_next_write(){
+    PORTB &= ~(1 << MAX7219_LOAD);
+    spi_busy = 1;
+    spi_second_byte = 0;
+    SPDR = spi_queue[spi_queue_head] >> 8;
+}
+
+// Adds a register write to the transmit queue and starts the transfer if the SPI 
+// module is idle. Returns 0 if the queue is full.
+int max7219_write(unsigned char address, unsigned char data){
+
+    unsigned char next_tail = (spi_queue_tail + 1) & (MAX7219_QUEUE_SIZE - 1);
+    if(next_tail == spi_queue_head)
+        return 0;
+
+    spi_queue[spi_queue_tail] = (address << 8) | data;
+
+    // the SPI interrupt must not see the new entry half way through
+    unsigned char sreg = SREG;
+    cli();
+    spi_queue_tail = next_tail;
+    if(!spi_busy)
+        start_next_write();
+    SREG = sreg;
+
+    return 1;
+}
+
+// Converts a display pattern (7:0 => DP,G,F,E,D,C,B,A) to the MAX7219 no-decode 
+// segment order (7:0 => DP,A,B,C,D,E,F,G)
+static unsigned char to_max7219_segments(unsigned char pattern){
+    unsigned char segments = pattern & 0x80;
+    if(pattern & (1 << 0)) segments |= (1 << 6);
+    if(pattern & (1 << 1)) segments |= (1 << 5);
+    if(pattern & (1 << 2)) segments |= (1 << 4);
+    if(pattern & (1 << 3)) segments |= (1 << 3);
+    if(pattern & (1 << 4)) segments |= (1 << 2);
+    if(pattern & (1 << 5)) segments |= (1 << 1);
+    if(pattern & (1 << 6)) segments |= (1 << 0);
+    return segments;
+}
+
+// Initialize the SPI module as master (PB1 SCK, PB2 MOSI, PB6 LOAD) at 1 MHz with its 
+// transfer complete interrupt, and the MAX7219 to drive 4 digits with raw segment 
+// patterns (no BCD decoding).
+void init_max7219(){
+
+    // Wake up SPI module
+    power_request(power_spi);
+
+    // SCK, MOSI, LOAD and SS are outputs, LOAD idles high
+    PORTB |= (1 << MAX7219_LOAD);
+    DDRB |= (1 << DDB0) | (1 << DDB1) | (1 << DDB2) | (1 << DDB6);
+
+    // Enable SPI as master, MSB first, mode 0, clock 16 MHz / 16 = 1 MHz, with interrupt
+    SPCR = (1 << SPIE) | (1 << SPE) | (1 << MSTR) | (1 << SPR0);
+
+    // Normal operation, raw segments, 4 digits, medium intensity
+    max7219_write(MAX7219_DISPLAY_TEST, 0);
+    max7219_write(MAX7219_DECODE_MODE, 0);
+    max7219_write(MAX7219_SCAN_LIMIT, 3);
+    max7219_write(MAX7219_INTENSITY, 8);
+    max7219_write(MAX7219_SHUTDOWN, 1);
+}
+
+// Queues the segment pattern given in pattern (7:0 => DP,G,F,E,D,C,B,A) for the digit 
+// position given in digit. Nothing is sent if the MAX7219 already shows this pattern.
+void max7219_set_digit(unsigned char digit, unsigned char pattern){
+
+    if(max7219_frame[digit] == pattern)
+        return;
+
+    // only remember the pattern once it is queued, a full queue is retried next refresh
+    if(max7219_write(MAX7219_DIGIT0 + digit, to_max7219_segments(pattern)))
+        max7219_frame[digit] = pattern;
+}
+
+// SPI transfer complete interrupt. Sends the data byte after the address byte, then 
+// latches the write with a rising edge on LOAD and starts the next queued write.
+ISR(SPI_STC_vect){
+    PROBE_SCOPE(probe_spi_isr);
+
+    if(!spi_second_byte){
+        spi_second_byte = 1;
+        SPDR = spi_queue[spi_queue_head] & 0xFF;
+        return;
+    }
+
+    // latch the 16 bits into the MAX7219
+    PORTB |= (1 << MAX7219_LOAD);
+    spi_queue_head = (spi_queue_head + 1) & (MAX7219_QUEUE_SIZE - 1);
+
+    if(spi_queue_head != spi_queue_tail)
+        start_next_write();
+    else
+        spi_busy = 0;
+}
+
+#endif
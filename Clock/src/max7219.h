@@ -0,0 +1,13 @@
+#ifndef MAX7219_H
+#define MAX7219_H
+
+// Initialize the SPI module as master (PB1 SCK, PB2 MOSI, PB6 LOAD) at 1 MHz with its 
+// transfer complete interrupt, and the MAX7219 to drive 4 digits with raw segment 
+// patterns (no BCD decoding).
+void init_max7219();
+
+// Queues the segment pattern given in pattern (7:0 => DP,G,F,E,D,C,B,A) for the digit 
+// position given in digit. Nothing is sent if the MAX7219 already shows this pattern.
+void max7219_set_digit(unsigned char digit, unsigned char pattern);
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef PIN_MAP_H
+#define PIN_MAP_H
+
+#include <avr/io.h>
+#include <stdint.h>
+
+// Compile-time mapping of a group of signals (display segments, digit selects) to 
+// GPIO pins. For every port used by the group the mask of its pins and the way to 
+// move signal bits into port bits are computed by the compiler, so a write turns into 
+// one store or one read-modify-write per port with no loops over the bits:
+//  - a port whose 8 pins all belong to the group is written with a plain store
+//  - signals on consecutive pins in signal order are moved with a single shift
+//  - any other signal costs one bit test and one OR
+
+// GPIO ports of the ATmega2560 (there is no port I)
+typedef enum gpioPort_enum {
+    port_a, port_b, port_c, port_d, port_e, port_f, port_g, port_h, port_j, port_k, port_l, 
+    gpio_port_count}
+gpioPort;
+
+// Encodes a pin as a single number to be used as a template argument
+constexpr uint8_t pin(gpioPort port, uint8_t bit){ return port * 8 + bit; }
+
+namespace pin_map {
+
+constexpr uint8_t port_of(uint8_t pin){ return pin >> 3; }
+constexpr uint8_t bit_of(uint8_t pin){ return pin & 7; }
+
+// PORTx (ddr false) or DDRx (ddr true) register of a port. Always called with 
+// constants so the switch folds into a single I/O address.
+inline volatile uint8_t & gpio_register(uint8_t port, bool ddr) __attribute__((always_inline));
+inline volatile uint8_t & gpio_register(uint8_t port, bool ddr){
+    switch(port){
+        case port_a: return ddr ? DDRA : PORTA;
+        case port_b: return ddr ? DDRB : PORTB;
+        case port_c: return ddr ? DDRC : PORTC;
+        case port_d: return ddr ? DDRD : PORTD;
+        case port_e: return ddr ? DDRE : PORTE;
+        case port_f: return ddr ? DDRF : PORTF;
+        case port_g: return ddr ? DDRG : PORTG;
+        case port_h: return ddr ? DDRH : PORTH;
+        case port_j: return ddr ? DDRJ : PORTJ;
+        case port_k: return ddr ? DDRK : PORTK;
+        default:     return ddr ? DDRL : PORTL;
+    }
+}
+
+// Mask of the pins of the group on a port
+constexpr uint8_t port_mask(uint8_t){ return 0; }
+template <typename... Pins>
+constexpr uint8_t port_mask(uint8_t port, uint8_t pin, Pins... pins){
+    return (port_of(pin) == port ? (1 << bit_of(pin)) : 0) | port_mask(port, pins...);
+}
+
+// Distance between the pin bit and the signal bit of the first signal on a port
+constexpr int first_offset(uint8_t, uint8_t){ return 0; }
+template <typename... Pins>
+constexpr int first_offset(uint8_t port, uint8_t signal, uint8_t pin, Pins... pins){
+    return port_of(pin) == port ? bit_of(pin) - signal : first_offset(port, signal + 1, pins...);
+}
+
+// Checks that every signal on a port sits at the same distance from its pin bit, 
+// so the whole port can be updated with a single shift
+constexpr bool same_offset(uint8_t, int, uint8_t){ return true; }
+template <typename... Pins>
+constexpr bool same_offset(uint8_t port, int offset, uint8_t signal, uint8_t pin, Pins... pins){
+    return (port_of(pin) != port || bit_of(pin) - signal == offset) && 
+        same_offset(port, offset, signal + 1, pins...);
+}
+
+// Moves signal bits to their pin bits on Port one by one (bit test and OR per signal)
+template <uint8_t Port, uint8_t Signal, uint8_t... Pins>
+struct scatter {
+    static inline uint8_t bits(uint8_t){ return 0; }
+};
+
+template <uint8_t Port, uint8_t Signal, uint8_t Pin, uint8_t... Pins>
+struct scatter<Port, Signal, Pin, Pins...> {
+    static inline uint8_t bits(uint8_t value){
+        return ((port_of(Pin) == Port && (value & (1 << Signal))) ? (1 << bit_of(Pin)) : 0) | 
+            scatter<Port, Signal + 1, Pins...>::bits(value);
+    }
+};
+
+// Writes the part of the signal value that belongs to Port into its PORTx or DDRx 
+// register, then moves on to the next port
+template <uint8_t Port, bool Ddr, uint8_t... Pins>
+struct port_writer {
+    static constexpr uint8_t mask = port_mask(Port, Pins...);
+    static constexpr int offset = first_offset(Port, 0, Pins...);
+    static constexpr bool shifted = same_offset(Port, offset, 0, Pins...);
+
+    static inline uint8_t bits(uint8_t value){
+        if(shifted)
+            return (offset >= 0 ? (uint8_t)(value << offset) : (uint8_t)(value >> -offset)) & mask;
+        return scatter<Port, 0, Pins...>::bits(value);
+    }
+
+    static inline void write(uint8_t value) __attribute__((always_inline)){
+        if(mask == 0xFF)
+            gpio_register(Port, Ddr) = bits(value);
+        else if(mask != 0)
+            gpio_register(Port, Ddr) = (gpio_register(Port, Ddr) & ~mask) | bits(value);
+        port_writer<Port + 1, Ddr, Pins...>::write(value);
+    }
+
+    // Sets all pins of the group to outputs
+    static inline void make_outputs() __attribute__((always_inline)){
+        if(mask != 0)
+            gpio_register(Port, true) |= mask;
+        port_writer<Port + 1, Ddr, Pins...>::make_outputs();
+    }
+};
+
+template <bool Ddr, uint8_t... Pins>
+struct port_writer<gpio_port_count, Ddr, Pins...> {
+    static inline void write(uint8_t){}
+    static inline void make_outputs(){}
+};
+
+}
+
+// Group of up to 8 signals driven through PORTx, signal k is bit k of the value 
+// written (display segments: bit 0 is segment A, bit 7 is DP).
+template <uint8_t... Pins>
+struct output_pins {
+    static_assert(sizeof...(Pins) <= 8, "a group holds at most 8 signals");
+
+    static inline void init() __attribute__((always_inline)){
+        pin_map::port_writer<port_a, false, Pins...>::make_outputs();
+    }
+
+    static inline void write(uint8_t value) __attribute__((always_inline)){
+        pin_map::port_writer<port_a, false, Pins...>::write(value);
+    }
+};
+
+// Group of up to 8 select lines of which only one is active at a time (display digit 
+// positions). The active line is made an output (ground, PORTx is left at 0) and the 
+// others inputs (high impedance) through DDRx.
+template <uint8_t... Pins>
+struct select_pins {
+    static_assert(sizeof...(Pins) <= 8, "a group holds at most 8 signals");
+
+    static inline void select(uint8_t line) __attribute__((always_inline)){
+        pin_map::port_writer<port_a, true, Pins...>::write(1 << line);
+    }
+
+    // Makes all lines inactive
+    static inline void select_none() __attribute__((always_inline)){
+        pin_map::port_writer<port_a, true, Pins...>::write(0);
+    }
+};
+
+#endif
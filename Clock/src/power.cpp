@@ -0,0 +1,82 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "power.h"
+
+// Number of drivers using each peripheral
+volatile unsigned char power_users[power_peripheral_count];
+
+// Seconds each peripheral has been on since reset
+volatile unsigned long power_on_seconds[power_peripheral_count];
+
+// Night mode status (1 is on), halves the display refresh
+volatile char night_mode = 0;
+
+// Power reduction register and bit of a peripheral
+static volatile uint8_t & power_register(peripheral device){
+    if(device < 8)
+        return PRR0;
+    else
+        return PRR1;
+}
+
+// Stops the clock of every peripheral. Drivers turn on the peripherals they use with 
+// power_request() during their initialization.
+void init_power(){
+    PRR0 = (1 << PRADC) | (1 << PRUSART0) | (1 << PRSPI) | (1 << PRTIM1) | 
+           (1 << PRTIM0) | (1 << PRTIM2) | (1 << PRTWI);
+    PRR1 = (1 << PRUSART1) | (1 << PRUSART2) | (1 << PRUSART3) | 
+           (1 << PRTIM3) | (1 << PRTIM4) | (1 << PRTIM5);
+}
+
+// Turns on the clock of a peripheral for a driver that needs it. Several drivers can 
+// share a peripheral, it stays on until all of them have released it.
+void power_request(peripheral device){
+
+    // drivers request peripherals from interrupts too (alarm on)
+    unsigned char sreg = SREG;
+    cli();
+    if(power_users[device] == 0)
+        power_register(device) &= ~(1 << (device & 7));
+    power_users[device] += 1;
+    SREG = sreg;
+}
+
+// Releases a peripheral requested with power_request() and stops its clock when no 
+// driver needs it anymore. Register values are kept while the clock is stopped.
+void power_release(peripheral device){
+
+    unsigned char sreg = SREG;
+    cli();
+    if(power_users[device] != 0){
+        power_users[device] -= 1;
+        if(power_users[device] == 0)
+            power_register(device) |= (1 << (device & 7));
+    }
+    SREG = sreg;
+}
+
+// Adds seconds given in seconds to the on-time of every peripheral that is on. 
+// Called once a second from the interaction loop (update_clock()).
+void power_account(unsigned char seconds){
+    for(unsigned char k = 0; k < power_peripheral_count; k++){
+        if(power_users[k])
+            power_on_seconds[k] += seconds;
+    }
+}
+
+// Returns the number of seconds a peripheral has been on since reset
+unsigned long get_power_on_time(peripheral device){
+
+    // 32-bit value, read in one piece
+    unsigned char sreg = SREG;
+    cli();
+    unsigned long seconds = power_on_seconds[device];
+    SREG = sreg;
+    return seconds;
+}
+
+// Turns night mode on (1) or off (0). In night mode the direct drive display is lit 
+// for half of each digit refresh.
+void set_night_mode(char on){
+    night_mode = on;
+}
@@ -0,0 +1,38 @@
+#ifndef POWER_H
+#define POWER_H
+
+// Peripherals with a bit in the power reduction registers. Values 0 to 7 are the 
+// PRR0 bit numbers and values 8 to 15 are the PRR1 bit numbers plus 8.
+typedef enum peripheral_enum {
+    power_adc = 0, power_usart0 = 1, power_spi = 2, power_timer1 = 3, power_timer0 = 5, 
+    power_timer2 = 6, power_twi = 7, power_usart1 = 8, power_usart2 = 9, power_usart3 = 10, 
+    power_timer3 = 11, power_timer4 = 12, power_timer5 = 13, power_peripheral_count = 14}
+peripheral;
+
+// Night mode status (1 is on), halves the display refresh
+extern volatile char night_mode;
+
+// Stops the clock of every peripheral. Drivers turn on the peripherals they use with 
+// power_request() during their initialization.
+void init_power();
+
+// Turns on the clock of a peripheral for a driver that needs it. Several drivers can 
+// share a peripheral, it stays on until all of them have released it.
+void power_request(peripheral device);
+
+// Releases a peripheral requested with power_request() and stops its clock when no 
+// driver needs it anymore. Register values are kept while the clock is stopped.
+void power_release(peripheral device);
+
+// Adds seconds given in seconds to the on-time of every peripheral that is on. 
+// Called once a second from the interaction loop (update_clock()).
+void power_account(unsigned char seconds);
+
+// Returns the number of seconds a peripheral has been on since reset
+unsigned long get_power_on_time(peripheral device);
+
+// Turns night mode on (1) or off (0). In night mode the direct drive display is lit 
+// for half of each digit refresh.
+void set_night_mode(char on);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <avr/io.h>
+#include "global_header.h"
+
+// Timing probes for benchmarks. With PROBE_ENABLED set (build flag -DPROBE_ENABLED=1, 
+// see the megaatmega2560_probe environment) every probe drives its own pin of PORTF 
+// (analog pins A0 to A7) high while the code it measures runs, so the time spent in 
+// each interrupt handler and hot function can be read from a trace of PORTF, taken 
+// by simavr or a logic analyzer, with tools/probe_report.py. A probe costs one SBI and 
+// one CBI instruction (2 cycles each). Without PROBE_ENABLED the probes compile to 
+// nothing.
+
+#ifndef PROBE_ENABLED
+#define PROBE_ENABLED 0
+#endif
+
+// PORTF pin of each probe. Must match PROBES in tools/probe_report.py.
+typedef enum probeChannel_enum {
+    probe_display_isr,    // TIMER0_OVF_vect
+    probe_clock_isr,      // TIMER1_COMPA_vect
+    probe_remote_isr,     // TIMER3_COMPA_vect
+    probe_chirp_isr,      // TIMER5_COMPA_vect
+    probe_spi_isr,        // SPI_STC_vect
+    probe_main_loop,      // toggled once per interaction loop iteration
+    probe_remote_input,   // get_remote_input()
+    probe_movement}       // poll_movement() and check_movement()
+probeChannel;
+
+#if PROBE_ENABLED
+
+#if DISPLAY_WIRING != 0
+#error "The probes use PORTF, which the older display wiring (DISPLAY_WIRING 1) uses"
+#endif
+
+// Drives the pin of a probe high for the lifetime of the object, so every return 
+// path of the measured code ends the measurement
+template <probeChannel Channel>
+struct probe_scope {
+    probe_scope(){ PORTF |= (1 << Channel); }
+    ~probe_scope(){ PORTF &= ~(1 << Channel); }
+};
+
+// Makes the probe pins outputs, all low
+#define PROBE_INIT() do { PORTF = 0; DDRF = 0xFF; } while(0)
+
+// Measures the rest of the enclosing block (function or interrupt handler)
+#define PROBE_SCOPE(channel) probe_scope<channel> probe_guard
+
+// Toggles the pin of a probe (writing 1 to a PINx bit toggles the PORTx bit)
+#define PROBE_TOGGLE(channel) (PINF = (1 << (channel)))
+
+#else
+
+#define PROBE_INIT() do { } while(0)
+#define PROBE_SCOPE(channel) do { } while(0)
+#define PROBE_TOGGLE(channel) do { } while(0)
+
+#endif
+
+#endif
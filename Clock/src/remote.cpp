@@ -1,6 +1,26 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include "global_header.h"
 #include "remote.h"
+#include "timer_config.h"
+#include "power.h"
+#include "probe.h"
+#include "clock.h"
+#include "latency.h"
+
+// Samples of the IR input per 562.5 us slot, the NEC protocol burst length
+#if REMOTE_FILTER
+#define REMOTE_SAMPLES_PER_SLOT 3
+#else
+#define REMOTE_SAMPLES_PER_SLOT 1
+#endif
+
+// Number of ticks (samples) in the given number of slots
+#define SLOTS(slots) ((slots) * REMOTE_SAMPLES_PER_SLOT)
+
+// Remote sampling timer (timer 3) period of one sample (562.5 us or 187.5 us)
+typedef ctc_timer<REMOTE_TIMER, period_ns(562500 / REMOTE_SAMPLES_PER_SLOT), 100> remote_timer;
+CLAIM_TIMER(REMOTE_TIMER);
 
 // State machine for receiving data from remote. wait_burst and wait_space are 
 // used to check for the start of a message (idle states) whereas reading is where 
@@ -13,72 +33,71 @@ volatile receiveState_enum receive_state = wait_burst;
 // counter used to check for repeated high or low inputs from IR remote sensor
 volatile int my_counter = 0;
 
-// message received from remote
-volatile char remote_data[100];
-// end of message received from remote
+// last 16 bits of the message received from remote (button code and flipped button 
+// code), one bit per bit with the latest bit received in bit 0
+volatile uint16_t remote_data = 0;
+// number of bits received from remote
 volatile int remote_data_end = 0;
 // flag for if the remote data is ready
 volatile int remote_data_available = 0;
+// time (clock_uptime_us()) at which the last message ended, for latency measurement
+volatile unsigned long remote_frame_time = 0;
+
+#if REMOTE_FILTER
+// last 3 samples of the IR input, the latest in bit 0
+volatile uint8_t sample_history = 0;
+#endif
 
 // Initialize remote with its timer (timer 3) for receiving IR NEC signals.
 void init_remote(){
 
+    // Turn on timer 3
+    power_request(power_timer3);
+
     // Setting timer 3 into CTC mode
     TCCR3B |= ( 1 << WGM32); 
 
-    // Setting compare A register to 8999 = (562.5*16/1) - 1 to count for 562.5 us.
-    // given a prescaler of 1
-    OCR3A = 8999;
+    // Setting compare A register to count for one sample, 8999 = (562.5*16/1) - 1 for 
+    // 562.5 us or 2999 for 187.5 us given a prescaler of 1
+    OCR3A = remote_timer::top;
 
     DDRH |= (1 << DDH3);
     DDRE |= (1 << DDE3);
     //PORTE |= (1 << PORTE3);
     PORTH |= (1 << PORTH3);
 
-    // Sets timer 3 prescaler to 1024
-    TCCR3B  |= (1 << CS30);
+    // Sets timer 3 prescaler (1)
+    TCCR3B  |= remote_timer::cs_bits;
     
     // Enables interrupt on timer 3 compare A
     TIMSK3 |= (1 << OCIE3A);
 }
 
-// converts binary string given in binary_string to 8-bit int
-uint8_t binary_string_to_uint8_t(const char * binary_string){
-
-    uint8_t value = 0;
-    for(int k = 0; k < 8; k++){
-        if(binary_string[k] == '1')
-            value += (1 << (7-k));
-    }
-    return value;
-}
-
 // Get input data from remote and return the button pressed. 
 // 'E' indicates communication error.
 char get_remote_input(){
+    PROBE_SCOPE(probe_remote_input);
 
     // wait for remote input data to be available
     if(!remote_data_available)
         return 0;
     
-    // select 8 digits of flipped button_code and convert it to a number and remove it 
-    // from remote data.
-    remote_data[remote_data_end] = '\0';
-    const char* button_code_flipped_string = (const char*)(&remote_data[remote_data_end-8]);
-    uint8_t button_code_flipped = binary_string_to_uint8_t(button_code_flipped_string);
-    remote_data_end -= 8;
-
-    // select 8 digits for button code and convert it to a number
-    remote_data[remote_data_end] = '\0';
-    const char* button_code_string = (const char*)(&remote_data[remote_data_end-8]);
-    uint8_t button_code = binary_string_to_uint8_t(button_code_string);
-    remote_data_end -= 8;
+    // last 8 bits are the flipped button_code and the 8 bits before are the button code
+    uint8_t button_code_flipped = remote_data & 0xFF;
+    uint8_t button_code = remote_data >> 8;
+    int bits_received = remote_data_end;
     
     // Flag remote input data as used so it gets fetched again
     remote_data_available = 0;
 
-    // Compare command with its flipped version to check for communication errors
-    if(button_code_flipped != (uint8_t)(~button_code))
+    // Compare command with its flipped version to check for communication errors. 
+    // A message shorter than 16 bits is an error too, and with the input filter a 
+    // message that is not the 32 bits of an NEC frame (a bit lost or added by noise).
+#if REMOTE_FILTER
+    if(bits_received != 32 || button_code_flipped != (uint8_t)(~button_code))
+#else
+    if(bits_received < 16 || button_code_flipped != (uint8_t)(~button_code))
+#endif
         return 'E';
     else
         // return the button corresponding to the command number from the remote
@@ -128,70 +147,64 @@ char button_code_to_button(uint8_t button_code){
     }
 }
 
-// Interrupt to decode data from remote using a state machine. Data from remote is given 
-// following the NEC protocol.
-ISR(TIMER3_COMPA_vect){
-
-    // Don't start decoding messages until previous message has been consumed
-    if(remote_data_available)
-        return;
-
-    // if pin input is low then data input is high and vice versa because the NEC 
-    // protocol has input be high by default.
-    int pin_data;
-    //if(PINF & (1 << PINF0))
-    if(PINH & (1 << PINH4))
-        pin_data = 0;
-    else{
-        pin_data = 1;
-    }
+// Feeds one sample of the IR input (one tick of the remote timer) to the NEC decoder 
+// state machine (pin_data is 1 during a burst). Called by the remote timer interrupt. Touches no registers, so 
+// recorded or synthesized IR traces can be replayed through it off-target.
+void decode_remote_sample(int pin_data){
 
-    // Wait for NEC protocol burst by waiting for at least 200 low ticks then a high tick
+    // Wait for NEC protocol burst by waiting for at least 200 low slots then a high tick
     if(receive_state == wait_burst){
-        // If low ticks reached 200 and a high tick is detected, move to wait_space
-        if(pin_data && my_counter > 200){
+        // If low ticks reached 200 slots and a high tick is detected, move to wait_space
+        if(pin_data && my_counter > SLOTS(200)){
             my_counter = 0;
             receive_state = wait_space;
         }
-        // Count up low ticks (target is above 200)
-        else if ((!pin_data) && (my_counter < 300)){
+        // Count up low ticks (target is above 200 slots)
+        else if ((!pin_data) && (my_counter < SLOTS(300))){
             my_counter += 1;
         }
     }
 
-    // Wait for NEC protocol space by waiting for at least 20 ticks then checking for a high tick 
-    // within the next 20 ticks
+    // Wait for NEC protocol space by waiting for at least 20 slots then checking for a high tick 
+    // within the next 20 slots
     else if(receive_state == wait_space){
 
         my_counter += 1;
-        // Wait for 20 ticks then check for a high tick to move to reading stage (start of message)
-        if(pin_data && my_counter > 20){
+        // Wait for 20 slots then check for a high tick to move to reading stage (start of message)
+        if(pin_data && my_counter > SLOTS(20)){
             my_counter = 0;
             remote_data_end = 0;
             receive_state = reading;
         }
-        // If no high tick after more than 40 ticks, return to wait_burst stage
-        else if((!pin_data) && my_counter > 40){
+        // If no high tick after more than 40 slots, return to wait_burst stage
+        else if((!pin_data) && my_counter > SLOTS(40)){
             my_counter = 0;
             receive_state = wait_burst;
         }
     }
     
-    // Reading stage decodes message from high and low ticks to bits. one high tick 
-    // followed by 1 low tick is a 0 bit. One high tick followed by 3 low ticks is a 1 
-    // bit. The bits are stored in remote_data.
+    // Reading stage decodes message from high and low ticks to bits. one high slot 
+    // followed by 1 low slot is a 0 bit. One high slot followed by 3 low slots is a 1 
+    // bit. The bits are shifted into remote_data.
     else if(receive_state == reading){
         // For each high tick, check how many low ticks were before it.
         if(pin_data){
-            // One low tick before means 0 bit
-            if(my_counter <= 2){
-                remote_data[remote_data_end] = '0';
+#if REMOTE_FILTER
+            // A high tick right after a high tick is the same burst, stretched by jitter 
+            // or sampled more than once
+            if(my_counter == 0)
+                return;
+#endif
+            // One low slot before means 0 bit
+            if(my_counter <= SLOTS(2)){
+                remote_data = remote_data << 1;
             }
-            // Three low ticks before means 1 bit
+            // Three low slots before means 1 bit
             else{
-                remote_data[remote_data_end] = '1';
+                remote_data = (remote_data << 1) | 1;
             }
-            remote_data_end += 1;
+            if(remote_data_end < 100)
+                remote_data_end += 1;
             my_counter = 0;
         }
         // Count low ticks since last high tick
@@ -199,14 +212,46 @@ ISR(TIMER3_COMPA_vect){
             my_counter += 1;
         }
     
-        // After 50 low ticks, message is considered over. Return to wait_burst stage 
+        // After 50 low slots, message is considered over. Return to wait_burst stage 
         // and signal that remote data is available.
-        if(my_counter > 50){
+        if(my_counter > SLOTS(50)){
             my_counter = 0;
             remote_data_available = 1;
             receive_state = wait_burst;
         }
     }
-    
 }
 
+// Interrupt to decode data from remote using a state machine. Data from remote is given 
+// following the NEC protocol. Kept short, the other interrupt routines wait for it 
+// (see the interrupt order in timer_config.h).
+ISR(TIMER3_COMPA_vect){
+#if PROBE_ENABLED
+    record_isr_entry(&remote_isr_jitter, TCNT3);
+#endif
+    PROBE_SCOPE(probe_remote_isr);
+
+    // Don't start decoding messages until previous message has been consumed
+    if(remote_data_available)
+        return;
+
+    // if pin input is low then data input is high and vice versa because the NEC 
+    // protocol has input be high by default.
+    int pin_data;
+    //if(PINF & (1 << PINF0))
+    if(PINH & (1 << PINH4))
+        pin_data = 0;
+    else{
+        pin_data = 1;
+    }
+
+#if REMOTE_FILTER
+    // Median of the last 3 samples, so a glitch or dropout on one sample is ignored
+    sample_history = ((sample_history << 1) | pin_data) & 0x07;
+    pin_data = (sample_history == 0x03 || sample_history >= 0x05);
+#endif
+
+    decode_remote_sample(pin_data);
+    if(remote_data_available)
+        remote_frame_time = clock_uptime_us();
+}
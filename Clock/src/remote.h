@@ -12,5 +12,10 @@ char get_remote_input();
 // in question. '?' indicates unused or unknown button.
 char button_code_to_button(uint8_t button_code);
 
+// Feeds one sample of the IR input (one tick of the remote timer) to the NEC decoder 
+// state machine (pin_data is 1 during a burst). Called by the remote timer interrupt. Touches no registers, so 
+// recorded or synthesized IR traces can be replayed through it off-target.
+void decode_remote_sample(int pin_data);
+
 #endif
 
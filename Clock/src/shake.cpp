@@ -0,0 +1,152 @@
+#include "global_header.h"
+#include "shake.h"
+
+// The classifier turns the accelerometer samples into peak events, then groups peaks
+// closer than SHAKE_GAP_MS into bursts. A burst of at most SHAKE_TAP_PEAKS peaks over
+// at most SHAKE_TAP_MS is a tap (a knock, a double knock or a bump of the nightstand).
+// A burst that goes on for SHAKE_DISMISS_SECONDS with at least SHAKE_DISMISS_PEAKS
+// peaks is a shake, reported as soon as it is reached. Anything in between is ignored
+// so the alarm keeps ringing. The timing windows can be set from the build flags.
+
+// A peak starts when |X| or |Y| goes over SHAKE_THRESHOLD. The next one starts once
+// both are back under SHAKE_RELEASE, or when the reading swings to another direction
+// (shaking back and forth may skip the release between two samples), and only after
+// SHAKE_PEAK_MS so the ringing of a knock gives a single peak. Raw readings are 16384
+// per g (+-2 g range).
+#ifndef SHAKE_THRESHOLD
+#define SHAKE_THRESHOLD 3000
+#endif
+#ifndef SHAKE_RELEASE
+#define SHAKE_RELEASE 2000
+#endif
+#ifndef SHAKE_PEAK_MS
+#define SHAKE_PEAK_MS 60
+#endif
+
+// Longest quiet time between two peaks of the same burst
+#ifndef SHAKE_GAP_MS
+#define SHAKE_GAP_MS 400
+#endif
+
+// Longest burst and most peaks of a tap (two knocks with their rebounds)
+#ifndef SHAKE_TAP_MS
+#define SHAKE_TAP_MS 600
+#endif
+#ifndef SHAKE_TAP_PEAKS
+#define SHAKE_TAP_PEAKS 4
+#endif
+
+// Fewest peaks of a shake, which must also last SHAKE_DISMISS_SECONDS
+#ifndef SHAKE_DISMISS_PEAKS
+#define SHAKE_DISMISS_PEAKS 8
+#endif
+
+// States of the classifier
+typedef enum shakeState_enum {
+    shake_idle,     // no peak within SHAKE_GAP_MS
+    shake_burst,    // peaks closer than SHAKE_GAP_MS
+    shake_settle}   // after a shake, until the movement stops for SHAKE_GAP_MS
+shakeState;
+
+shakeState shake_state = shake_idle;
+
+// Direction (+X, -X, +Y or -Y, numbered 1 to 4) of the peak in progress while the
+// sample is over the threshold, 0 otherwise
+unsigned char shake_above = 0;
+
+// Peaks of the current burst and times of its first and last peak
+unsigned char shake_peaks = 0;
+unsigned int shake_first_ms = 0;
+unsigned int shake_last_ms = 0;
+
+// Starts the classifier over, forgetting the peaks seen so far
+void shake_reset(){
+    shake_state = shake_idle;
+    shake_above = 0;
+    shake_peaks = 0;
+}
+
+// Returns 1 if the sample starts a new peak
+static char detect_peak(int x, int y, unsigned int now_ms){
+
+    // magnitudes in unsigned arithmetic, where -32768 gives 32768 without overflowing
+    unsigned int ax = x < 0 ? 0u - (unsigned int)x : x;
+    unsigned int ay = y < 0 ? 0u - (unsigned int)y : y;
+
+    if(ax < SHAKE_RELEASE && ay < SHAKE_RELEASE){
+        shake_above = 0;
+        return 0;
+    }
+    if(ax <= SHAKE_THRESHOLD && ay <= SHAKE_THRESHOLD)
+        return 0;
+
+    // the axis with the largest reading gives the direction
+    unsigned char direction;
+    if(ax >= ay)
+        direction = x > 0 ? 1 : 2;
+    else
+        direction = y > 0 ? 3 : 4;
+
+    // same peak going on
+    if(direction == shake_above)
+        return 0;
+    shake_above = direction;
+
+    // rebound of the last peak
+    if(shake_state != shake_idle && (unsigned int)(now_ms - shake_last_ms) < SHAKE_PEAK_MS)
+        return 0;
+
+    return 1;
+}
+
+// Feeds one accelerometer sample (raw X and Y readings) taken at time now_ms in
+// milliseconds (wrapping) to the classifier. Returns the gesture that ends with this
+// sample, shake_none otherwise.
+shakeGesture shake_feed(int x, int y, unsigned int now_ms){
+
+    char peak = detect_peak(x, y, now_ms);
+
+    // differences handle the wrap of the time
+    char quiet = (unsigned int)(now_ms - shake_last_ms) > SHAKE_GAP_MS;
+
+    switch(shake_state){
+        case shake_idle:
+            if(peak){
+                shake_state = shake_burst;
+                shake_peaks = 1;
+                shake_first_ms = now_ms;
+                shake_last_ms = now_ms;
+            }
+            return shake_none;
+
+        case shake_burst:
+            if(peak){
+                if(shake_peaks < 255)
+                    shake_peaks += 1;
+                shake_last_ms = now_ms;
+                if(shake_peaks >= SHAKE_DISMISS_PEAKS &&
+                    (unsigned int)(now_ms - shake_first_ms) >= SHAKE_DISMISS_SECONDS * 1000U){
+                    shake_state = shake_settle;
+                    return shake_dismiss;
+                }
+                return shake_none;
+            }
+            if(!quiet)
+                return shake_none;
+
+            // the burst is over
+            shake_state = shake_idle;
+            if(shake_peaks <= SHAKE_TAP_PEAKS &&
+                (unsigned int)(shake_last_ms - shake_first_ms) <= SHAKE_TAP_MS)
+                return shake_tap;
+            return shake_none;
+
+        case shake_settle:
+            if(peak)
+                shake_last_ms = now_ms;
+            else if(quiet)
+                shake_state = shake_idle;
+            return shake_none;
+    }
+    return shake_none;
+}
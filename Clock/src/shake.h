@@ -0,0 +1,19 @@
+#ifndef SHAKE_H
+#define SHAKE_H
+
+// Gestures told apart by the shake classifier, from shake_feed()
+typedef enum shakeGesture_enum {
+    shake_none,     // nothing yet, or movement that is neither a tap nor a shake
+    shake_tap,      // one or two short knocks, snoozes the ringing alarm
+    shake_dismiss}  // vigorous shaking for SHAKE_DISMISS_SECONDS, turns it off
+shakeGesture;
+
+// Starts the classifier over, forgetting the peaks seen so far
+void shake_reset();
+
+// Feeds one accelerometer sample (raw X and Y readings) taken at time now_ms in
+// milliseconds (wrapping) to the classifier. Returns the gesture that ends with this
+// sample, shake_none otherwise.
+shakeGesture shake_feed(int x, int y, unsigned int now_ms);
+
+#endif
@@ -0,0 +1,332 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "global_header.h"
+#include "ssd1306.h"
+#include "display.h"
+#include "I2C.h"
+#include "clock.h"
+
+// Only built for the SSD1306 display backend
+#if DISPLAY_BACKEND == 2
+
+#define SSD1306_SLA 0x3C // OLED address with SA0 grounded
+#define SSD1306_COMMANDS 0x00 // control byte: the rest of the transaction is commands
+#define SSD1306_DATA 0x40 // control byte: the rest of the transaction is display data
+
+// Screen size, a page is a row of 8 pixels high bytes
+#define SSD1306_COLUMNS 128
+#define SSD1306_PAGES 8
+
+// Delay before retrying to bring up the OLED after a failure
+#define SSD1306_RETRY_US 1000000UL
+
+// Display data bytes sent per call of ssd1306_flush(), about 2 ms at 100 kHz
+#define SSD1306_CHUNK_BYTES 16
+
+// Value of oled_sending while nothing is being sent
+#define SSD1306_IDLE 0xFF
+
+// Cells of the screen
+typedef enum oledCell_enum {
+    cell_digit0, cell_digit1, cell_digit2, cell_digit3, cell_colon, cell_am_pm, 
+    cell_alarm, cell_mode, cell_count}
+oledCell;
+
+// Page and column range of a cell
+typedef struct oledArea_struct {
+    unsigned char first_column;
+    unsigned char last_column;
+    unsigned char first_page;
+    unsigned char last_page;
+} oledArea;
+
+// The big digits are the 5x7 glyphs scaled 4 times (20x28 pixels) in 24 column wide 
+// cells on pages 2 to 5, with the colon between the hours and minutes
+const oledArea cell_areas[cell_count] PROGMEM = {
+    {12, 35, 2, 5},     // digit 0
+    {36, 59, 2, 5},     // digit 1
+    {68, 91, 2, 5},     // digit 2
+    {92, 115, 2, 5},    // digit 3
+    {60, 67, 2, 5},     // colon
+    {115, 126, 7, 7},   // AM/PM
+    {120, 127, 0, 0},   // alarm bell
+    {0, 7, 0, 0},       // mode icon
+};
+
+// 5x7 glyphs, one byte per column with the top row in bit 0, in the order of the 
+// digit values of display_time_digit(): 0 to 9, blank, C, F, minus
+const unsigned char digit_glyphs[14][5] PROGMEM = {
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // blank
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // minus
+};
+
+// 5x7 letters of AM/PM
+const unsigned char letter_a[5] PROGMEM = {0x7E, 0x11, 0x11, 0x11, 0x7E};
+const unsigned char letter_p[5] PROGMEM = {0x7F, 0x09, 0x09, 0x09, 0x06};
+const unsigned char letter_m[5] PROGMEM = {0x7F, 0x02, 0x0C, 0x02, 0x7F};
+
+// 8x8 icons of the alarm bell and of each system state (stateType order)
+const unsigned char bell_icon[8] PROGMEM = {0x20, 0x3C, 0x3E, 0xBF, 0xBF, 0x3E, 0x3C, 0x20};
+const unsigned char mode_icons[6][8] PROGMEM = {
+    {0x3C, 0x42, 0x81, 0x9D, 0x91, 0x81, 0x42, 0x3C}, // show_time: clock face
+    {0x81, 0x3C, 0x3E, 0xBF, 0xBF, 0x3E, 0x3C, 0x81}, // alarm_on: ringing bell
+    {0x3C, 0x42, 0x81, 0x9D, 0x91, 0x81, 0x42, 0xBD}, // set_time: underlined clock face
+    {0x20, 0x3C, 0x3E, 0xBF, 0xBF, 0x3E, 0x3C, 0xA0}, // set_alarm: underlined bell
+    {0x81, 0xC3, 0xA5, 0x99, 0x99, 0xA5, 0xC3, 0x81}, // show_timer: hourglass
+    {0x00, 0x60, 0x9E, 0x81, 0x9E, 0x60, 0x00, 0x00}, // show_temperature: thermometer
+};
+
+// What each cell should show and what the OLED shows. 0xFF is never a cell value 
+// so it forces the first write.
+unsigned char oled_cells[cell_count];
+unsigned char oled_shown[cell_count];
+
+// 1 once the OLED answered its setup commands, and pages cleared since then
+char oled_ready = 0;
+unsigned char oled_pages_cleared = 0;
+
+// Cell being sent (cell_count while a page is cleared, SSD1306_IDLE if none), its 
+// area and value, and the display data bytes of it sent so far
+unsigned char oled_sending = SSD1306_IDLE;
+oledArea oled_area;
+unsigned char oled_value = 0;
+unsigned int oled_position = 0;
+// Time (clock_uptime_us()) of the next attempt to bring up the OLED
+unsigned long oled_retry_time = 0;
+
+// Counts the I2C bytes sent to the OLED since reset (benchmark of the partial updates)
+unsigned long ssd1306_bytes_sent = 0;
+
+// Setup commands: display off, clock, multiplex 64, no offset, start line 0, charge 
+// pump on, horizontal addressing, flipped to the usual orientation, COM pins, contrast, 
+// precharge, VCOMH, resume from RAM, normal (not inverted) and display on
+const unsigned char setup_commands[] PROGMEM = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x00, 
+    0xA1, 0xC8, 0xDA, 0x12, 0x81, 0xCF, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6, 0xAF};
+
+// Starts a transaction to the OLED with the given control byte
+static i2cStatus begin_transfer(unsigned char control){
+    i2cStatus status = StartI2C_Trans(SSD1306_SLA);
+    if(status == i2c_ok)
+        status = write(control);
+    ssd1306_bytes_sent += 2;
+    return status;
+}
+
+// Sends a byte of the current transaction
+static i2cStatus send_byte(unsigned char data){
+    ssd1306_bytes_sent += 1;
+    return write(data);
+}
+
+// Ends a transaction. A failure makes the OLED be brought up again later.
+static void end_transfer(i2cStatus status){
+    StopI2C_Trans();
+    if(status != i2c_ok){
+        if(status != i2c_nack)
+            recover_i2c_bus();
+        oled_ready = 0;
+        oled_retry_time = clock_uptime_us() + SSD1306_RETRY_US;
+    }
+}
+
+// Sets the page and column range that the next display data fills (horizontal 
+// addressing wraps from the last column of a page to the first column of the next)
+static i2cStatus set_window(unsigned char first_column, unsigned char last_column, 
+    unsigned char first_page, unsigned char last_page){
+
+    i2cStatus status = begin_transfer(SSD1306_COMMANDS);
+    if(status == i2c_ok) status = send_byte(0x21);
+    if(status == i2c_ok) status = send_byte(first_column);
+    if(status == i2c_ok) status = send_byte(last_column);
+    if(status == i2c_ok) status = send_byte(0x22);
+    if(status == i2c_ok) status = send_byte(first_page);
+    if(status == i2c_ok) status = send_byte(last_page);
+    StopI2C_Trans();
+    return status;
+}
+
+// Byte of a cell at the given page and column (both relative to the cell) for the 
+// given cell value
+static unsigned char render(oledCell cell, unsigned char value, unsigned char page, 
+    unsigned char column){
+
+    if(cell <= cell_digit3){
+        // 20 columns of glyph, 4 of spacing
+        if(column >= 20)
+            return 0;
+        unsigned char glyph = pgm_read_byte(&digit_glyphs[value][column / 4]);
+        // each page holds two glyph rows of 4 pixels
+        unsigned char rows = glyph >> (page * 2);
+        return ((rows & 0x01) ? 0x0F : 0) | ((rows & 0x02) ? 0xF0 : 0);
+    }
+    if(cell == cell_colon){
+        // two 4x4 dots on pages 3 and 4
+        if(!value || column < 2 || column > 5 || (page != 1 && page != 2))
+            return 0;
+        return 0x3C;
+    }
+    if(cell == cell_am_pm){
+        // 2 letters of 5 columns with 1 column between them, on 12 columns
+        if(value == 0 || column == 0 || column == 6 || column > 11)
+            return 0;
+        if(column > 6)
+            return pgm_read_byte(&letter_m[column - 7]);
+        return pgm_read_byte(value == 1 ? &letter_a[column - 1] : &letter_p[column - 1]);
+    }
+    if(cell == cell_alarm)
+        return value ? pgm_read_byte(&bell_icon[column]) : 0;
+    return pgm_read_byte(&mode_icons[value][column]);
+}
+
+// Starts sending a cell, or clearing a page (cell_count): sets its window and 
+// remembers what to send. Returns 0 if the OLED did not take the window.
+static int start_area(unsigned char cell, unsigned char page){
+
+    if(cell == cell_count){
+        oled_area.first_column = 0;
+        oled_area.last_column = SSD1306_COLUMNS - 1;
+        oled_area.first_page = page;
+        oled_area.last_page = page;
+    }
+    else{
+        memcpy_P(&oled_area, &cell_areas[cell], sizeof(oledArea));
+        oled_value = oled_cells[cell];
+    }
+
+    i2cStatus status = set_window(oled_area.first_column, oled_area.last_column, 
+        oled_area.first_page, oled_area.last_page);
+    if(status != i2c_ok){
+        end_transfer(status);
+        return 0;
+    }
+    oled_sending = cell;
+    oled_position = 0;
+    return 1;
+}
+
+// Sends the next SSD1306_CHUNK_BYTES bytes of display data of the area being sent. 
+// The OLED keeps its position in the window between transactions.
+static void send_chunk(){
+
+    unsigned char width = oled_area.last_column - oled_area.first_column + 1;
+    unsigned int size = width * (oled_area.last_page - oled_area.first_page + 1);
+
+    i2cStatus status = begin_transfer(SSD1306_DATA);
+    for(unsigned char k = 0; status == i2c_ok && k < SSD1306_CHUNK_BYTES && 
+        oled_position < size; k++){
+        unsigned char data = 0;
+        if(oled_sending != cell_count)
+            data = render((oledCell)oled_sending, oled_value, oled_position / width, 
+                oled_position % width);
+        status = send_byte(data);
+        oled_position += 1;
+    }
+    end_transfer(status);
+
+    // a failure starts the area over once the OLED is brought up again
+    if(status != i2c_ok){
+        oled_sending = SSD1306_IDLE;
+        return;
+    }
+    if(oled_position < size)
+        return;
+
+    if(oled_sending == cell_count)
+        oled_pages_cleared += 1;
+    else
+        oled_shown[oled_sending] = oled_value;
+    oled_sending = SSD1306_IDLE;
+}
+
+// Sends the setup commands. Returns 1 if the OLED acknowledged them.
+static int setup_oled(){
+
+    i2cStatus status = begin_transfer(SSD1306_COMMANDS);
+    for(unsigned char k = 0; status == i2c_ok && k < sizeof(setup_commands); k++)
+        status = send_byte(pgm_read_byte(&setup_commands[k]));
+    end_transfer(status);
+    return status == i2c_ok;
+}
+
+// Marks every cell as unknown so the screen is cleared and redrawn once the OLED is 
+// brought up. Sends nothing, the I2C module is initialized later in the boot.
+void init_ssd1306(){
+    for(unsigned char k = 0; k < cell_count; k++){
+        oled_cells[k] = 0;
+        oled_shown[k] = 0xFF;
+    }
+}
+
+// Sets the glyph (0 to 9 or a DIGIT_ value from display.h) of the big digit at the 
+// digit position given in digit
+void ssd1306_set_digit(unsigned char digit, unsigned char value){
+    oled_cells[cell_digit0 + digit] = value;
+}
+
+// Sets the status cells: AM/PM (0 is AM, 1 is PM, -1 shows nothing), the alarm bell 
+// (alarm activated or not), the colon and the mode icon (system state)
+void ssd1306_set_status(char pm, char alarm, char colon, unsigned char mode){
+    oled_cells[cell_am_pm] = pm + 1;
+    oled_cells[cell_alarm] = alarm;
+    oled_cells[cell_colon] = colon;
+    oled_cells[cell_mode] = mode;
+}
+
+// Brings up the OLED (with retries), clears it a page at a time, then sends the 
+// changed cells, at most SSD1306_CHUNK_BYTES of display data per call
+static void flush_step(){
+
+    if(!oled_ready){
+        if((long)(clock_uptime_us() - oled_retry_time) < 0)
+            return;
+        if(!setup_oled())
+            return;
+        oled_ready = 1;
+        oled_pages_cleared = 0;
+        oled_sending = SSD1306_IDLE;
+        for(unsigned char k = 0; k < cell_count; k++)
+            oled_shown[k] = 0xFF;
+    }
+
+    if(oled_sending == SSD1306_IDLE){
+        // the cleared screen shows nothing, so blank cells are drawn only when they change
+        if(oled_pages_cleared < SSD1306_PAGES){
+            if(!start_area(cell_count, oled_pages_cleared))
+                return;
+        }
+        else{
+            unsigned char k = 0;
+            while(k < cell_count && oled_cells[k] == oled_shown[k])
+                k++;
+            if(k == cell_count || !start_area(k, 0))
+                return;
+        }
+    }
+
+    send_chunk();
+}
+
+// Brings up the OLED (with retries) and clears it a page at a time, then sends the 
+// changed cells. Called from the interaction loop. The bus runs at 100 kHz while the 
+// OLED is sent to and each call sends at most 16 bytes of display data, so a call 
+// takes about 2 ms (under 3 ms when it also sets the window of a cell).
+void ssd1306_flush(){
+    set_i2c_fast(1);
+    flush_step();
+    set_i2c_fast(0);
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
+// SSD1306 128x64 OLED on the I2C bus (shared with the MPU). The screen is made of 
+// cells: the 4 big digits, the colon, AM/PM, the alarm bell and the mode icon. The 
+// display code sets what each cell shows and only the cells that changed are sent, 
+// a few bytes at a time from the interaction loop.
+
+// Counts the I2C bytes sent to the OLED since reset (benchmark of the partial updates)
+extern unsigned long ssd1306_bytes_sent;
+
+// Marks every cell as unknown so the screen is cleared and redrawn once the OLED is 
+// brought up. Sends nothing, the I2C module is initialized later in the boot.
+void init_ssd1306();
+
+// Sets the glyph (0 to 9 or a DIGIT_ value from display.h) of the big digit at the 
+// digit position given in digit
+void ssd1306_set_digit(unsigned char digit, unsigned char value);
+
+// Sets the status cells: AM/PM (0 is AM, 1 is PM, -1 shows nothing), the alarm bell 
+// (alarm activated or not), the colon and the mode icon (system state)
+void ssd1306_set_status(char pm, char alarm, char colon, unsigned char mode);
+
+// Brings up the OLED (with retries) and clears it a page at a time, then sends the 
+// changed cells. Called from the interaction loop. The bus runs at 100 kHz while the 
+// OLED is sent to and each call sends at most 16 bytes of display data, so a call 
+// takes about 2 ms (under 3 ms when it also sets the window of a cell).
+void ssd1306_flush();
+
+#endif
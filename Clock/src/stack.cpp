@@ -0,0 +1,74 @@
+#include <avr/io.h>
+#include "stack.h"
+#include "trace.h"
+
+// Stack peak last recorded in the trace
+unsigned int stack_traced_peak = 0;
+
+#if SIM_NATIVE
+
+// The host simulator runs the firmware on a host stack and has no AVR RAM to read, 
+// so no stack use is reported
+unsigned int stack_peak_usage(){
+    return 0;
+}
+
+unsigned int stack_free_bytes(){
+    return 0;
+}
+
+#else
+
+// Byte painted over the free RAM at startup
+#define STACK_PAINT 0xC5
+
+// First byte after the variables (.data, .bss and .noinit), set by the linker
+extern unsigned char _end;
+
+// Runs from .init3, after the stack pointer is set and before main() is called, so 
+// nothing is on the stack yet. Paints everything from the end of the variables to 
+// the top of RAM.
+void paint_stack() __attribute__((naked, used, section(".init3")));
+void paint_stack(){
+    unsigned char * p = &_end;
+    while(p <= (unsigned char *)RAMEND){
+        *p = STACK_PAINT;
+        p++;
+    }
+}
+
+// Lowest address the stack has written to since reset
+static unsigned char * stack_low_mark(){
+    unsigned char * p = &_end;
+    while(p <= (unsigned char *)RAMEND && *p == STACK_PAINT)
+        p++;
+    return p;
+}
+
+// Returns the largest number of bytes the stack has used since reset. The free RAM 
+// between the end of the variables and the top of RAM is painted with a known byte at 
+// startup, so the deepest point of the stack is the lowest byte no longer painted.
+unsigned int stack_peak_usage(){
+    return (unsigned char *)RAMEND + 1 - stack_low_mark();
+}
+
+// Returns the number of bytes between the end of the variables and the deepest 
+// point the stack has reached since reset
+unsigned int stack_free_bytes(){
+    return stack_low_mark() - &_end;
+}
+
+#endif
+
+// Records the stack peak and the bytes left free in the event trace when the stack 
+// has gone deeper since the last check, so a dump after a watchdog reset shows how 
+// close it came to the variables. Called once a minute from the interaction loop 
+// (update_clock()), a check reads the free RAM (about 2 ms).
+void stack_check(){
+    unsigned int peak = stack_peak_usage();
+    if(peak <= stack_traced_peak)
+        return;
+    stack_traced_peak = peak;
+    trace(trace_stack_peak, peak);
+    trace(trace_stack_free, stack_free_bytes());
+}
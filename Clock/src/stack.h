@@ -0,0 +1,19 @@
+#ifndef STACK_H
+#define STACK_H
+
+// Returns the largest number of bytes the stack has used since reset. The free RAM 
+// between the end of the variables and the top of RAM is painted with a known byte at 
+// startup, so the deepest point of the stack is the lowest byte no longer painted.
+unsigned int stack_peak_usage();
+
+// Returns the number of bytes between the end of the variables and the deepest 
+// point the stack has reached since reset
+unsigned int stack_free_bytes();
+
+// Records the stack peak and the bytes left free in the event trace when the stack 
+// has gone deeper since the last check, so a dump after a watchdog reset shows how 
+// close it came to the variables. Called once a minute from the interaction loop 
+// (update_clock()), a check reads the free RAM (about 2 ms).
+void stack_check();
+
+#endif
@@ -1,36 +1,158 @@
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include "switch.h"
+#include "timer_wheel.h"
 
-// Sets pin PD0 as an input pin and enables its pullup resistor for stable input.
-// It also enables its interrupt (INT0) with any-edge trigger
-void initSwitchPD0(){
+// The button is on PE4 (INT4, digital pin 2) and connects the pin to ground when 
+// pressed. INT0 is not used because its pin, PD0, is SCL of the I2C bus on the mega 2560.
 
-    // set PD0 direction for input
-    DDRD &= ~(1 << DDD0);
+// Time the input must be left alone to settle after an edge, time held for a long 
+// press and time within which a second click makes a double click, in wheel ticks (10 ms)
+#define SWITCH_DEBOUNCE_TICKS 3
+#define SWITCH_LONG_PRESS_TICKS 80
+#define SWITCH_DOUBLE_CLICK_TICKS 30
 
-    // enable the PD0 pullup resistor for stable input
-    PORTD |= (1 << PORTD0);
+// Number of clock timer ticks (10 ms) since init_clock() (global variable in clock)
+extern volatile unsigned long clock_ticks;
 
-    // enable the interrupt for PD0
-    EIMSK |= (1 << INT0);
+// Last event not read yet by get_switch_event()
+volatile switchEvent switch_event = switch_none;
+
+// The only timer wheel timer the button uses at a time: the debounce delay, then the 
+// wait for a long press or a double click. TIMER_NONE when not running.
+volatile timerId switch_timer = TIMER_NONE;
+
+// Debounced state of the button (1 is pressed), whether the current press already gave 
+// a long press, and number of clicks waiting to become a click or a double click
+volatile char switch_pressed = 0;
+volatile char switch_long_fired = 0;
+volatile char switch_clicks = 0;
+
+// Ticks at which the button was last pressed and last released
+volatile unsigned long switch_press_tick = 0;
+volatile unsigned long switch_release_tick = 0;
+
+// Sets pin PE4 as an input pin and enables its pullup resistor for stable input.
+// It also enables its interrupt (INT4) with any-edge trigger
+void initSwitchPE4(){
+
+    // set PE4 direction for input
+    DDRE &= ~(1 << DDE4);
+
+    // enable the PE4 pullup resistor for stable input
+    PORTE |= (1 << PORTE4);
 
     // set the interrupt to trigger on any edge of the input signal
-    EICRA |=  (1 << ISC00);
-    EICRA &= ~(1 << ISC01);
+    EICRB |=  (1 << ISC40);
+    EICRB &= ~(1 << ISC41);
+
+    // enable the interrupt for PE4, ignoring an edge from setting up the pin
+    EIFR = (1 << INTF4);
+    EIMSK |= (1 << INT4);
 }
 
-// enables the PD0 pin switch interrupt
+// enables the PE4 pin switch interrupt
 void enable_switch_interrupt(){
 
-    // enable the interrupt for PD0
-    EIMSK |=  (1 << INT0);
+    // enable the interrupt for PE4
+    EIMSK |=  (1 << INT4);
 
 }
 
-// disables the PD0 pin switch interrupt
+// disables the PE4 pin switch interrupt
 void disable_switch_interrupt(){
 
-    // disables the interrupt for PD0
-    EIMSK &= ~(1 << INT0);
+    // disables the interrupt for PE4
+    EIMSK &= ~(1 << INT4);
+
+}
+
+// Returns the last button event (click, long press or double click) that has not 
+// been read yet, switch_none if there is none
+switchEvent get_switch_event(){
+
+    unsigned char sreg = SREG;
+    cli();
+    switchEvent event = switch_event;
+    switch_event = switch_none;
+    SREG = sreg;
+    return event;
+}
+
+// Ticks left until the given length has passed since a tick, at least 1
+static unsigned long ticks_left(unsigned long since, unsigned long length){
+    long left = (long)(since + length - clock_ticks);
+    return left < 1 ? 1 : left;
+}
+
+// Called when the button has been held for SWITCH_LONG_PRESS_TICKS
+static void switch_long_press_done(timerId timer){
+    switch_timer = TIMER_NONE;
+    switch_long_fired = 1;
+    switch_clicks = 0;
+    switch_event = switch_long_press;
+}
+
+// Called SWITCH_DOUBLE_CLICK_TICKS after a click that was not followed by another
+static void switch_click_done(timerId timer){
+    switch_timer = TIMER_NONE;
+    switch_clicks = 0;
+    switch_event = switch_click;
+}
+
+// Called SWITCH_DEBOUNCE_TICKS after an edge. Reads the settled input, turns presses 
+// and releases into events and waits for a long press or a double click if needed.
+static void switch_debounce_done(timerId timer){
+
+    switch_timer = TIMER_NONE;
+
+    // listen for the next edge, ignoring the bounces of this one
+    EIFR = (1 << INTF4);
+    enable_switch_interrupt();
+
+    char pressed = !(PINE & (1 << PINE4));
+    if(pressed != switch_pressed){
+        switch_pressed = pressed;
+        if(pressed){
+            switch_press_tick = clock_ticks;
+        }
+        // release that ends a long press
+        else if(switch_long_fired){
+            switch_long_fired = 0;
+            switch_clicks = 0;
+        }
+        // release that ends a click
+        else{
+            switch_clicks += 1;
+            switch_release_tick = clock_ticks;
+            if(switch_clicks == 2){
+                switch_clicks = 0;
+                switch_event = switch_double_click;
+            }
+        }
+    }
+
+    // (re)start the wait that the edge interrupt stopped, even if the edge was a glitch
+    if(switch_pressed && !switch_long_fired)
+        switch_timer = timer_start(ticks_left(switch_press_tick, SWITCH_LONG_PRESS_TICKS), 
+            switch_long_press_done);
+    else if(!switch_pressed && switch_clicks == 1)
+        switch_timer = timer_start(ticks_left(switch_release_tick, SWITCH_DOUBLE_CLICK_TICKS), 
+            switch_click_done);
+}
+
+// Button edge interrupt. Ignores the input until it settles: the interrupt is turned off 
+// and the input is read again by a timer SWITCH_DEBOUNCE_TICKS later, no busy-wait.
+ISR(INT4_vect){
+
+    disable_switch_interrupt();
+
+    // stops a wait for a long press or a double click, restarted after the debounce. 
+    // Timers are only cancelled here and never from a timer callback.
+    timer_cancel(switch_timer);
+    switch_timer = timer_start(SWITCH_DEBOUNCE_TICKS, switch_debounce_done);
 
+    // no timer free, read the input right away rather than lose the button
+    if(switch_timer == TIMER_NONE)
+        switch_debounce_done(TIMER_NONE);
 }
@@ -1,14 +1,23 @@
 #ifndef SWITCH_H
 #define SWITCH_H
 
-// Sets pin PD0 as an input pin and enables its pullup resistor for stable input.
-// It also enables its interrupt (INT0) with any-edge trigger
-void initSwitchPD0();
+// Events of the snooze/dismiss button, from get_switch_event()
+typedef enum switchEvent_enum {
+    switch_none, switch_click, switch_long_press, switch_double_click}
+switchEvent;
 
-// enables the PD0 pin switch interrupt
+// Sets pin PE4 as an input pin and enables its pullup resistor for stable input.
+// It also enables its interrupt (INT4) with any-edge trigger
+void initSwitchPE4();
+
+// enables the PE4 pin switch interrupt
 void enable_switch_interrupt();
 
-// disables the PD0 pin switch interrupt
+// disables the PE4 pin switch interrupt
 void disable_switch_interrupt();
 
+// Returns the last button event (click, long press or double click) that has not 
+// been read yet, switch_none if there is none
+switchEvent get_switch_event();
+
 #endif
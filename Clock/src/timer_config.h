@@ -0,0 +1,161 @@
+#ifndef TIMER_CONFIG_H
+#define TIMER_CONFIG_H
+
+#include <stdint.h>
+
+// Compile-time timer configuration. A module describes the period it wants from its 
+// timer and the prescaler (CSn2:0 bits) and TOP (OCRnA) values are computed by the 
+// compiler, so the register writes are the same constants as before. The build fails 
+// if the period cannot be reached within the allowed error or if two modules use 
+// the same timer.
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+/*Timer assignment*/
+
+// Hardware timer owned by each module. Every timer can only have one owner.
+#define DISPLAY_TIMER 0 // display refresh (overflow interrupt)
+#define CLOCK_TIMER 1   // clock timebase (compare A interrupt, CTC)
+#define DELAY_TIMER 2   // busy-wait microsecond delays (compare A flag, CTC)
+#define REMOTE_TIMER 3  // IR remote sampling (compare A interrupt, CTC)
+#define PWM_TIMER 4     // alarm tone (fast PWM with variable TOP)
+#define CHIRP_TIMER 5   // alarm chirp frequency sweep (compare A interrupt, normal mode)
+
+/*Interrupt order*/
+
+// The AVR has no interrupt priorities. Every interrupt routine runs to the end with 
+// interrupts disabled (no ISR_NOBLOCK, no sei() inside a routine), then the pending 
+// interrupts are taken lowest vector first: button edge (INT4), GPS PPS edge (INT5), 
+// clock timer (timer 1), night dimming (timer 0 compare A), display refresh (timer 0 
+// overflow), remote sampling (timer 3), alarm chirp (timer 5), NMEA character (USART2). 
+// The remote sampling is delayed by up to the longest routine, so routines are kept 
+// short: the clock timer only counts the ticks and expires the timers, the once a 
+// second and once a minute work is done by update_clock() in the main loop with the 
+// other slow work (MPU, SSD1306 flush), and the alarm chirp loads its PWM TOP from a 
+// table in program memory instead of dividing.
+
+// Claims a timer for the module it is used in by defining a symbol named after the 
+// timer. A second module claiming the same timer fails to link with a multiple 
+// definition error.
+#define CLAIM_TIMER(n) CLAIM_TIMER_NUMBER(n)
+#define CLAIM_TIMER_NUMBER(n) extern const uint8_t timer##n##_owner = n
+
+/*Periods in nanoseconds*/
+
+constexpr uint64_t period_s(uint64_t s){ return s * 1000000000ULL; }
+constexpr uint64_t period_ms(uint64_t ms){ return ms * 1000000ULL; }
+constexpr uint64_t period_us(uint64_t us){ return us * 1000ULL; }
+constexpr uint64_t period_ns(uint64_t ns){ return ns; }
+constexpr uint64_t frequency_hz(uint64_t hz){ return (1000000000ULL + hz / 2) / hz; }
+
+namespace timer_config {
+
+// Timers 0 and 2 are 8-bit, all others are 16-bit
+constexpr uint32_t max_top(uint8_t timer){
+    return (timer == 0 || timer == 2) ? 0xFF : 0xFFFF;
+}
+
+// Largest clock select value: timer 2 has 7 prescalers, the others have 5
+constexpr uint8_t max_cs(uint8_t timer){
+    return timer == 2 ? 7 : 5;
+}
+
+// Prescaler divider selected by clock select value cs
+constexpr uint32_t divider(uint8_t timer, uint8_t cs){
+    return timer == 2 ?
+        (cs == 1 ? 1 : cs == 2 ? 8 : cs == 3 ? 32 : cs == 4 ? 64 : cs == 5 ? 128 : cs == 6 ? 256 : 1024) :
+        (cs == 1 ? 1 : cs == 2 ? 8 : cs == 3 ? 64 : cs == 4 ? 256 : 1024);
+}
+
+// Clock select value for a prescaler divider, 0 if the timer has no such prescaler
+constexpr uint8_t cs_for_divider(uint8_t timer, uint32_t div, uint8_t cs = 1){
+    return cs > max_cs(timer) ? 0 :
+        divider(timer, cs) == div ? cs : cs_for_divider(timer, div, cs + 1);
+}
+
+constexpr uint64_t cycles(uint64_t period){
+    return (period * F_CPU + 500000000ULL) / 1000000000ULL;
+}
+
+constexpr uint64_t rounded_ticks(uint64_t cycles, uint32_t div){
+    return (cycles + div / 2) / div;
+}
+
+constexpr uint64_t difference(uint64_t a, uint64_t b){
+    return a > b ? a - b : b - a;
+}
+
+constexpr uint32_t error_ppm(uint64_t wanted, uint64_t actual){
+    return (uint32_t)(difference(wanted, actual) * 1000000ULL / wanted);
+}
+
+// CTC mode: smallest prescaler whose TOP fits the timer, which gives the finest 
+// resolution. 0 if the period is too long for the timer.
+constexpr uint8_t ctc_cs(uint8_t timer, uint64_t cycles, uint8_t cs = 1){
+    return cs > max_cs(timer) ? 0 :
+        rounded_ticks(cycles, divider(timer, cs)) - 1 <= max_top(timer) ? cs : ctc_cs(timer, cycles, cs + 1);
+}
+
+// Overflow mode: the timer always counts to max_top, so pick the prescaler whose 
+// overflow period is closest to the wanted period.
+constexpr uint8_t overflow_cs(uint8_t timer, uint64_t cycles, uint8_t cs = 2, uint8_t best = 1){
+    return cs > max_cs(timer) ? best :
+        overflow_cs(timer, cycles, cs + 1,
+            difference(cycles, (max_top(timer) + 1) * (uint64_t)divider(timer, cs)) <
+            difference(cycles, (max_top(timer) + 1) * (uint64_t)divider(timer, best)) ? cs : best);
+}
+
+constexpr bool distinct_timers(uint8_t){
+    return true;
+}
+
+// Checks that no timer number appears twice in the list
+template <typename... Timers>
+constexpr bool distinct_timers(uint8_t used, uint8_t timer, Timers... timers){
+    return !(used & (1 << timer)) && distinct_timers(used | (1 << timer), timers...);
+}
+
+}
+
+static_assert(timer_config::distinct_timers(0, DISPLAY_TIMER, CLOCK_TIMER, DELAY_TIMER,
+    REMOTE_TIMER, PWM_TIMER, CHIRP_TIMER), "two modules are assigned the same timer");
+
+// Timer running in CTC mode with a period of Period nanoseconds. cs_bits goes into 
+// TCCRnB and top into OCRnA. The build fails if the actual period differs from the 
+// wanted one by more than MaxErrorPpm parts per million.
+template <uint8_t Timer, uint64_t Period, uint32_t MaxErrorPpm>
+struct ctc_timer {
+    static constexpr uint64_t cycles = timer_config::cycles(Period);
+    static constexpr uint8_t cs_bits = timer_config::ctc_cs(Timer, cycles);
+    static constexpr uint32_t divider = timer_config::divider(Timer, cs_bits);
+    static constexpr uint16_t top = (uint16_t)(timer_config::rounded_ticks(cycles, divider) - 1);
+    static constexpr uint32_t error_ppm = timer_config::error_ppm(cycles, (top + 1ULL) * divider);
+
+    static_assert(cs_bits != 0, "period is too long for this timer");
+    static_assert(error_ppm <= MaxErrorPpm, "timer period error exceeds its bound");
+};
+
+// Timer running freely up to its maximum count (normal mode, overflow interrupt) 
+// with a period as close as possible to Period nanoseconds.
+template <uint8_t Timer, uint64_t Period, uint32_t MaxErrorPpm>
+struct overflow_timer {
+    static constexpr uint64_t cycles = timer_config::cycles(Period);
+    static constexpr uint8_t cs_bits = timer_config::overflow_cs(Timer, cycles);
+    static constexpr uint32_t divider = timer_config::divider(Timer, cs_bits);
+    static constexpr uint32_t error_ppm = timer_config::error_ppm(cycles, (timer_config::max_top(Timer) + 1ULL) * divider);
+
+    static_assert(error_ppm <= MaxErrorPpm, "timer period error exceeds its bound");
+};
+
+// Timer with a fixed prescaler whose TOP is set at runtime (PWM)
+template <uint8_t Timer, uint32_t Divider>
+struct prescaled_timer {
+    static constexpr uint8_t cs_bits = timer_config::cs_for_divider(Timer, Divider);
+    static constexpr uint32_t divider = Divider;
+
+    static_assert(cs_bits != 0, "timer has no such prescaler");
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "timer_wheel.h"
+
+// Timers of the wheel. Timers in the same slot form a doubly linked list through 
+// next and previous so cancelling a timer does not search its slot. Free timers form 
+// a singly linked list through next so starting a timer does not search either.
+typedef struct wheelTimer_struct {
+    timerCallback callback; // 0 when the timer is free
+    unsigned long turns;    // full turns of the wheel left before it expires
+    unsigned char slot;
+    timerId next;
+    timerId previous;
+} wheelTimer;
+
+volatile wheelTimer wheel_timers[TIMER_WHEEL_TIMERS];
+
+// First timer of each slot's list, TIMER_NONE for an empty slot
+volatile timerId wheel_slots[TIMER_WHEEL_SLOTS] = {
+    TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE,
+    TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE,
+    TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE,
+    TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE, TIMER_NONE};
+
+// Slot of the current tick
+volatile unsigned char wheel_position = 0;
+
+// First timer of the free list, TIMER_NONE when the list is empty. Timers from 
+// wheel_unused on have never been started and are not in the list, so no setup is 
+// needed at startup.
+volatile timerId wheel_free = TIMER_NONE;
+volatile timerId wheel_unused = 0;
+
+// Removes a timer from its slot list
+static void unlink_timer(timerId timer){
+    timerId next = wheel_timers[timer].next;
+    timerId previous = wheel_timers[timer].previous;
+    if(previous == TIMER_NONE)
+        wheel_slots[wheel_timers[timer].slot] = next;
+    else
+        wheel_timers[previous].next = next;
+    if(next != TIMER_NONE)
+        wheel_timers[next].previous = previous;
+}
+
+// Puts a timer removed from its slot list back in the free list
+static void free_timer(timerId timer){
+    wheel_timers[timer].callback = 0;
+    wheel_timers[timer].next = wheel_free;
+    wheel_free = timer;
+}
+
+// Starts a one-shot timer that calls callback after ticks wheel ticks (at least 1). 
+// Returns the number of the timer or TIMER_NONE if all timers are in use.
+timerId timer_start(unsigned long ticks, timerCallback callback){
+
+    if(ticks == 0)
+        ticks = 1;
+
+    // timers are started from the interaction loop and from interrupts
+    unsigned char sreg = SREG;
+    cli();
+
+    timerId timer = wheel_free;
+    if(timer != TIMER_NONE)
+        wheel_free = wheel_timers[timer].next;
+    else if(wheel_unused < TIMER_WHEEL_TIMERS)
+        timer = wheel_unused++;
+
+    if(timer != TIMER_NONE){
+        // the slot of the current tick has been handled, so a timer due in n ticks goes 
+        // n slots ahead and a full turn is n = TIMER_WHEEL_SLOTS
+        unsigned char slot = (wheel_position + ticks) & (TIMER_WHEEL_SLOTS - 1);
+        wheel_timers[timer].callback = callback;
+        wheel_timers[timer].turns = (ticks - 1) / TIMER_WHEEL_SLOTS;
+        wheel_timers[timer].slot = slot;
+        wheel_timers[timer].previous = TIMER_NONE;
+        wheel_timers[timer].next = wheel_slots[slot];
+        if(wheel_slots[slot] != TIMER_NONE)
+            wheel_timers[wheel_slots[slot]].previous = timer;
+        wheel_slots[slot] = timer;
+    }
+
+    SREG = sreg;
+    return timer;
+}
+
+// Stops a running timer before it expires
+void timer_cancel(timerId timer){
+
+    if(timer >= TIMER_WHEEL_TIMERS)
+        return;
+
+    unsigned char sreg = SREG;
+    cli();
+    if(wheel_timers[timer].callback){
+        unlink_timer(timer);
+        free_timer(timer);
+    }
+    SREG = sreg;
+}
+
+// Returns the number of ticks left before a timer expires, 0 if it is not running
+unsigned long timer_remaining(timerId timer){
+
+    if(timer >= TIMER_WHEEL_TIMERS)
+        return 0;
+
+    unsigned long ticks = 0;
+    unsigned char sreg = SREG;
+    cli();
+    if(wheel_timers[timer].callback){
+        unsigned char ahead = (wheel_timers[timer].slot - wheel_position) & (TIMER_WHEEL_SLOTS - 1);
+        if(ahead == 0)
+            ahead = TIMER_WHEEL_SLOTS;
+        ticks = wheel_timers[timer].turns * TIMER_WHEEL_SLOTS + ahead;
+    }
+    SREG = sreg;
+    return ticks;
+}
+
+// Advances the wheel by one tick and calls the callbacks of the timers that expire. 
+// Called from the clock timer interrupt every 10 ms.
+void timer_wheel_tick(){
+
+    wheel_position = (wheel_position + 1) & (TIMER_WHEEL_SLOTS - 1);
+
+    timerId timer = wheel_slots[wheel_position];
+    while(timer != TIMER_NONE){
+        timerId next = wheel_timers[timer].next;
+        if(wheel_timers[timer].turns == 0){
+            // free the timer before the callback so the callback can start a new one
+            timerCallback callback = wheel_timers[timer].callback;
+            unlink_timer(timer);
+            free_timer(timer);
+            callback(timer);
+        }
+        else{
+            wheel_timers[timer].turns -= 1;
+        }
+        timer = next;
+    }
+}
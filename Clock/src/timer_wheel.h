@@ -0,0 +1,45 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+// Hashed timer wheel driven by the 10 ms clock tick. A timer due in n ticks is put in 
+// slot (current + n) % TIMER_WHEEL_SLOTS with n / TIMER_WHEEL_SLOTS full turns left, 
+// so every tick only looks at one slot whatever the number of running timers.
+
+// Number of wheel slots (power of 2) and of timers that can run at the same time
+#define TIMER_WHEEL_SLOTS 32
+#ifndef TIMER_WHEEL_TIMERS
+#define TIMER_WHEEL_TIMERS 8
+#endif
+
+// Length of a wheel tick in milliseconds
+#define TIMER_WHEEL_TICK_MS 10
+
+// Number of a timer, a byte unless there are more timers than a byte can number. 
+// TIMER_NONE is returned by timer_start() when all timers are in use.
+#if TIMER_WHEEL_TIMERS < 0xFF
+typedef unsigned char timerId;
+#define TIMER_NONE 0xFF
+#else
+typedef unsigned int timerId;
+#define TIMER_NONE 0xFFFF
+#endif
+
+// Function called from the clock timer interrupt when a timer expires, with the 
+// number of the timer that expired
+typedef void (*timerCallback)(timerId timer);
+
+// Starts a one-shot timer that calls callback after ticks wheel ticks (at least 1). 
+// Returns the number of the timer or TIMER_NONE if all timers are in use.
+timerId timer_start(unsigned long ticks, timerCallback callback);
+
+// Stops a running timer before it expires
+void timer_cancel(timerId timer);
+
+// Returns the number of ticks left before a timer expires, 0 if it is not running
+unsigned long timer_remaining(timerId timer);
+
+// Advances the wheel by one tick and calls the callbacks of the timers that expire. 
+// Called from the clock timer interrupt every 10 ms.
+void timer_wheel_tick();
+
+#endif
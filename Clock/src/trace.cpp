@@ -0,0 +1,100 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "trace.h"
+#include "watchdog.h"
+#include "power.h"
+
+// Value of trace_magic when the trace in RAM is valid
+#define TRACE_MAGIC 0x7ACE
+
+// Number of clock timer ticks since init_clock() (global variable in clock)
+extern volatile unsigned long clock_ticks;
+
+// Fixed size trace record (5 bytes)
+typedef struct traceRecord_struct {
+    uint16_t tick;
+    uint8_t event;
+    uint16_t arg;
+} __attribute__((packed)) traceRecord;
+
+// Trace kept in RAM that the C runtime does not clear at startup, so it survives a 
+// warm restart. trace_next is where the next record goes and trace_count the number 
+// of records ever written (saturates).
+traceRecord trace_records[TRACE_RECORDS] __attribute__((section(".noinit")));
+volatile uint8_t trace_next __attribute__((section(".noinit")));
+volatile uint16_t trace_count __attribute__((section(".noinit")));
+uint16_t trace_magic __attribute__((section(".noinit")));
+
+// Sets up the trace. After a warm restart the records from before the reset are kept 
+// so they can be dumped, otherwise the trace starts empty. Records a trace_reset event.
+void init_trace(){
+
+    if((reset_cause & (1 << PORF)) || trace_magic != TRACE_MAGIC || trace_next >= TRACE_RECORDS){
+        trace_next = 0;
+        trace_count = 0;
+        trace_magic = TRACE_MAGIC;
+    }
+
+    trace(trace_reset, reset_cause);
+}
+
+// Appends a record to the trace, overwriting the oldest one when it is full. Safe to 
+// call from interrupts and from the interaction loop.
+void trace(traceEvent event, uint16_t arg){
+
+    // Only the slot is claimed and the tick read with interrupts off (a few cycles), an 
+    // interrupt that comes in while the record is filled in writes its own slot. The 
+    // clock interrupt would change the 4 bytes of clock_ticks while they are read.
+    unsigned char sreg = SREG;
+    cli();
+    uint8_t slot = trace_next;
+    trace_next = (slot + 1) & (TRACE_RECORDS - 1);
+    if(trace_count != 0xFFFF)
+        trace_count += 1;
+    uint16_t tick = clock_ticks;
+    SREG = sreg;
+
+    trace_records[slot].tick = tick;
+    trace_records[slot].event = event;
+    trace_records[slot].arg = arg;
+}
+
+// Sends a byte on USART0 and waits for the transmit buffer to be free
+static void send_byte(uint8_t data){
+    while(!(UCSR0A & (1 << UDRE0)));
+    UDR0 = data;
+}
+
+// Sends the trace oldest record first on USART0 (USB) at 115200 baud for 
+// tools/trace_decode.py. Blocks until it is sent (about 15 ms).
+void dump_trace(){
+
+    power_request(power_usart0);
+
+    // 115200 baud in double speed mode: UBRR = 16 MHz / (8 * 115200) - 1 = 16 (2.1 % error)
+    UCSR0A = (1 << U2X0);
+    UBRR0 = 16;
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+    UCSR0B = (1 << TXEN0);
+
+    // header: "TR", number of records that follow, record size
+    uint8_t records = trace_count < TRACE_RECORDS ? trace_count : TRACE_RECORDS;
+    send_byte('T');
+    send_byte('R');
+    send_byte(records);
+    send_byte(sizeof(traceRecord));
+
+    uint8_t slot = (trace_next - records) & (TRACE_RECORDS - 1);
+    for(uint8_t k = 0; k < records; k++){
+        const uint8_t * bytes = (const uint8_t *)&trace_records[slot];
+        for(uint8_t b = 0; b < sizeof(traceRecord); b++)
+            send_byte(bytes[b]);
+        slot = (slot + 1) & (TRACE_RECORDS - 1);
+    }
+
+    // wait for the last byte to leave before turning off the USART
+    UCSR0A |= (1 << TXC0);
+    while(!(UCSR0A & (1 << TXC0)));
+    UCSR0B = 0;
+    power_release(power_usart0);
+}
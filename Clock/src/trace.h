@@ -0,0 +1,39 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Events recorded in the trace. Each record has the clock tick (10 ms, 16 bits), the 
+// event and a 16-bit argument. tools/trace_decode.py must be kept in sync.
+typedef enum traceEvent_enum {
+    trace_reset,        // arg: MCUSR (reset cause)
+    trace_state,        // arg: new stateType
+    trace_button,       // arg: button from get_remote_input()
+    trace_remote_error, // arg: 'E' from get_remote_input()
+    trace_motion,       // arg: shakeGesture in the high byte, state in the low byte
+    trace_alarm_on,     // arg: 0
+    trace_alarm_off,    // arg: 0
+    trace_i2c_error,    // arg: i2cStatus in the high byte, TWSR status in the low byte
+    trace_switch,       // arg: switchEvent from get_switch_event()
+    trace_gps,          // arg: new gpsState of the GPS discipline
+    trace_mpu_mode,     // arg: new mpuMode of the MPU
+    trace_stack_peak,   // arg: bytes of stack used at the deepest point since reset
+    trace_stack_free}   // arg: bytes left between the variables and that point
+traceEvent;
+
+// Number of records kept (power of 2)
+#define TRACE_RECORDS 32
+
+// Sets up the trace. After a warm restart the records from before the reset are kept 
+// so they can be dumped, otherwise the trace starts empty. Records a trace_reset event.
+void init_trace();
+
+// Appends a record to the trace, overwriting the oldest one when it is full. Safe to 
+// call from interrupts and from the interaction loop.
+void trace(traceEvent event, uint16_t arg);
+
+// Sends the trace oldest record first on USART0 (USB) at 115200 baud for 
+// tools/trace_decode.py. Blocks until it is sent (about 15 ms).
+void dump_trace();
+
+#endif
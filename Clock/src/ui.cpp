@@ -0,0 +1,360 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "global_header.h"
+#include "ui.h"
+#include "clock.h"
+#include "PWM.h"
+#include "I2C.h"
+#include "countdown.h"
+
+// Current system state (global variable in main)
+extern volatile stateType state;
+extern volatile int hour_mode;
+
+// Clock time and alarm time digits and AM/PM status (global variables in main)
+extern volatile char time_digits [TIME_DIGITS_NUMBER];
+extern volatile char am_pm;
+extern volatile char alarm_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char alarm_am_pm;
+
+// Buffer time digits and AM/PM status (global variables in main) used to set times
+extern volatile char buffer_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char buffer_am_pm;
+
+// Current digit selected in set_time and set_alarm states (global variable in main)
+extern volatile char cursor_digit;
+
+// Status of alarm being activated or deactivated (global variable in main)
+extern volatile char alarm_activation;
+
+// Action of a transition or of entering/leaving a state, given the remote button 
+// of the event (0 for other inputs)
+typedef void (*uiAction)(char button);
+
+// Transition of the table: action to run (0 for none) and next state
+typedef struct uiTransition_struct {
+    uiAction action;
+    unsigned char next;
+} uiTransition;
+
+// Entry and exit actions of a state (0 for none)
+typedef struct uiStateActions_struct {
+    uiAction entry;
+    uiAction exit;
+} uiStateActions;
+
+// Activates/deactivates the alarm
+static void toggle_alarm(char button){
+    alarm_activation = !alarm_activation;
+}
+
+#if TIME_WARP_ENABLED
+// Accelerates the clock (1x, 60x, 3600x), to check the alarm and rollovers
+static void warp_time(char button){
+    next_time_warp();
+}
+#endif
+
+// Switches between 12 and 24 hour mode, converting every time
+static void switch_hour_mode(char button){
+    change_hour_mode();
+}
+
+// Types a digit of the length of a countdown in minutes
+static void type_countdown_digit(char button){
+    countdown_digit(button - '0');
+}
+
+// Starts the countdown typed
+static void start_countdown(char button){
+    countdown_start();
+}
+
+// Cancels the countdown that expires first
+static void cancel_countdown(char button){
+    countdown_cancel();
+}
+
+// Starts and stops the stopwatch
+static void toggle_stopwatch(char button){
+    stopwatch_toggle();
+}
+
+// Sets the stopwatch back to 0
+static void reset_stopwatch(char button){
+    stopwatch_reset();
+}
+
+// Switches the temperature between degrees Celsius and Fahrenheit
+static void toggle_temperature_unit(char button){
+    temperature_unit = !temperature_unit;
+}
+
+// Moves the cursor right with wrapping up at the end
+static void cursor_right(char button){
+    cursor_digit += 1;
+    if(cursor_digit == 4)
+        cursor_digit = 0;
+}
+
+// Moves the cursor left with wrapping up at the start
+static void cursor_left(char button){
+    cursor_digit -= 1;
+    if(cursor_digit == -1)
+        cursor_digit = 3;
+}
+
+// Changes the buffer digit at the cursor then moves the cursor right
+static void type_buffer_digit(char button){
+    buffer_time_digits[(int)cursor_digit] = button - '0';
+    cursor_right(button);
+}
+
+// Switches between AM and PM for the buffer, if in 12 hour mode
+static void toggle_buffer_am_pm(char button){
+    if(hour_mode == 0)
+        buffer_am_pm = !buffer_am_pm;
+}
+
+// Rings the alarm again in SNOOZE_MINUTES (the alarm is turned off by leaving alarm_on)
+static void snooze(char button){
+    snooze_alarm();
+}
+
+// Entering set_time: the buffer starts from the clock time, cursor on the first digit
+static void enter_set_time(char button){
+    load_time_to_buffer((char *)time_digits, am_pm);
+    cursor_digit = 0;
+}
+
+// Leaving set_time: the buffer is saved to the clock time
+static void leave_set_time(char button){
+    save_buffer_to_time((char *)time_digits, (char *)(&am_pm));
+}
+
+// Entering set_alarm: the buffer starts from the alarm time, cursor on the first digit
+static void enter_set_alarm(char button){
+    load_time_to_buffer((char *)alarm_time_digits, alarm_am_pm);
+    cursor_digit = 0;
+}
+
+// Leaving set_alarm: the buffer is saved to the alarm time
+static void leave_set_alarm(char button){
+    save_buffer_to_time((char *)alarm_time_digits, (char *)(&alarm_am_pm));
+}
+
+// Entering show_timer or show_temperature: the digits are filled before the first 
+// refresh shows them
+static void enter_show_timer(char button){
+    update_timer_display();
+}
+
+static void enter_show_temperature(char button){
+    update_temperature_display();
+}
+
+// Entering alarm_on from the table (alarm time or a countdown expired): the alarm rings
+static void enter_alarm_on(char button){
+    turn_on_alarm();
+}
+
+// Leaving alarm_on: the alarm stops ringing
+static void leave_alarm_on(char button){
+    turn_off_alarm();
+}
+
+#if TIME_WARP_ENABLED
+#define WARP_TIME warp_time
+#else
+#define WARP_TIME 0
+#endif
+
+// Transitions indexed by state and event, in the order of stateType and uiEvent. A 
+// transition to the same state runs only its action.
+constexpr uiTransition transitions[UI_STATES][event_count] PROGMEM = {
+    // show_time
+    {{0, show_time},                        // digit
+     {0, set_time},                         // M
+     {0, show_time},                        // S
+     {0, show_time},                        // R
+     {0, show_time},                        // L
+     {WARP_TIME, show_time},                // /
+     {toggle_alarm, show_time},             // A
+     {switch_hour_mode, show_time},         // P
+     {0, show_time},                        // other
+     {0, show_time},                        // click
+     {0, show_time},                        // long press
+     {toggle_alarm, show_time},             // double click
+     {0, show_time},                        // tap
+     {0, show_time},                        // shake
+     {0, alarm_on},                         // countdown
+     {0, alarm_on}},                        // alarm
+    // alarm_on
+    {{0, alarm_on},                         // digit
+     {0, alarm_on},                         // M
+     {0, show_time},                        // S
+     {0, alarm_on},                         // R
+     {0, alarm_on},                         // L
+     {0, alarm_on},                         // /
+     {0, alarm_on},                         // A
+     {switch_hour_mode, alarm_on},          // P
+     {0, alarm_on},                         // other
+     {snooze, show_time},                   // click
+     {0, show_time},                        // long press
+     {0, alarm_on},                         // double click
+     {snooze, show_time},                   // tap
+     {0, show_time},                        // shake
+     {0, alarm_on},                         // countdown
+     {0, alarm_on}},                        // alarm
+    // set_time
+    {{type_buffer_digit, set_time},         // digit
+     {0, set_alarm},                        // M
+     {0, set_time},                         // S
+     {cursor_right, set_time},              // R
+     {cursor_left, set_time},               // L
+     {toggle_buffer_am_pm, set_time},       // /
+     {0, set_time},                         // A
+     {switch_hour_mode, set_time},          // P
+     {0, set_time},                         // other
+     {0, set_time},                         // click
+     {0, set_time},                         // long press
+     {0, set_time},                         // double click
+     {0, set_time},                         // tap
+     {0, set_time},                         // shake
+     {0, alarm_on},                         // countdown
+     {0, set_time}},                        // alarm
+    // set_alarm
+    {{type_buffer_digit, set_alarm},        // digit
+     {0, show_timer},                       // M
+     {0, set_alarm},                        // S
+     {cursor_right, set_alarm},             // R
+     {cursor_left, set_alarm},              // L
+     {toggle_buffer_am_pm, set_alarm},      // /
+     {0, set_alarm},                        // A
+     {switch_hour_mode, set_alarm},         // P
+     {0, set_alarm},                        // other
+     {0, set_alarm},                        // click
+     {0, set_alarm},                        // long press
+     {0, set_alarm},                        // double click
+     {0, set_alarm},                        // tap
+     {0, set_alarm},                        // shake
+     {0, alarm_on},                         // countdown
+     {0, set_alarm}},                       // alarm
+    // show_timer
+    {{type_countdown_digit, show_timer},    // digit
+     {0, show_temperature},                 // M
+     {cancel_countdown, show_timer},        // S
+     {toggle_stopwatch, show_timer},        // R
+     {reset_stopwatch, show_timer},         // L
+     {start_countdown, show_timer},         // /
+     {0, show_timer},                       // A
+     {switch_hour_mode, show_timer},        // P
+     {0, show_timer},                       // other
+     {0, show_timer},                       // click
+     {0, show_timer},                       // long press
+     {0, show_timer},                       // double click
+     {0, show_timer},                       // tap
+     {0, show_timer},                       // shake
+     {0, alarm_on},                         // countdown
+     {0, alarm_on}},                        // alarm
+    // show_temperature
+    {{0, show_temperature},                 // digit
+     {0, show_time},                        // M
+     {0, show_temperature},                 // S
+     {0, show_temperature},                 // R
+     {0, show_temperature},                 // L
+     {toggle_temperature_unit, show_temperature}, // /
+     {0, show_temperature},                 // A
+     {switch_hour_mode, show_temperature},  // P
+     {0, show_temperature},                 // other
+     {0, show_temperature},                 // click
+     {0, show_temperature},                 // long press
+     {0, show_temperature},                 // double click
+     {0, show_temperature},                 // tap
+     {0, show_temperature},                 // shake
+     {0, alarm_on},                         // countdown
+     {0, alarm_on}},                        // alarm
+};
+
+// Entry and exit actions of each state, in the order of stateType
+constexpr uiStateActions state_actions[UI_STATES] PROGMEM = {
+    {0, 0},                                 // show_time
+    {enter_alarm_on, leave_alarm_on},       // alarm_on
+    {enter_set_time, leave_set_time},       // set_time
+    {enter_set_alarm, leave_set_alarm},     // set_alarm
+    {enter_show_timer, 0},                  // show_timer
+    {enter_show_temperature, 0},            // show_temperature
+};
+
+// Returns the event of a button from get_remote_input()
+uiEvent button_event(char button){
+    if(button >= '0' && button <= '9')
+        return event_digit;
+    switch(button){
+        case 'M':
+            return event_mode;
+        case 'S':
+            return event_stop;
+        case 'R':
+            return event_right;
+        case 'L':
+            return event_left;
+        case '/':
+            return event_slash;
+        case 'A':
+            return event_alarm_toggle;
+        case 'P':
+            return event_hour_mode;
+        default:
+            return event_other;
+    }
+}
+
+// Returns the event of a snooze/dismiss button event from get_switch_event()
+uiEvent switch_event(switchEvent input){
+    switch(input){
+        case switch_click:
+            return event_click;
+        case switch_long_press:
+            return event_long_press;
+        case switch_double_click:
+            return event_double_click;
+        default:
+            return event_other;
+    }
+}
+
+// Returns the event of a gesture from poll_movement()
+uiEvent shake_event(shakeGesture gesture){
+    if(gesture == shake_tap)
+        return event_tap;
+    if(gesture == shake_dismiss)
+        return event_shake;
+    return event_other;
+}
+
+// Runs the transition of the current state for event. button is the remote button 
+// that caused the event (the digit typed for event_digit), 0 for other inputs.
+void dispatch_event(uiEvent event, char button){
+
+    stateType current = state;
+    uiTransition transition;
+    memcpy_P(&transition, &transitions[current][event], sizeof(uiTransition));
+
+    uiStateActions actions;
+    if(transition.next != current){
+        memcpy_P(&actions, &state_actions[current], sizeof(uiStateActions));
+        if(actions.exit)
+            actions.exit(button);
+    }
+
+    if(transition.action)
+        transition.action(button);
+
+    if(transition.next != current){
+        state = (stateType)transition.next;
+        memcpy_P(&actions, &state_actions[transition.next], sizeof(uiStateActions));
+        if(actions.entry)
+            actions.entry(button);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef UI_H
+#define UI_H
+
+#include "global_header.h"
+#include "switch.h"
+#include "shake.h"
+
+// User interface state machine. Every input (remote button, snooze/dismiss button, 
+// tap or shake) is turned into an event and looked up in a table indexed by the current 
+// state and the event, which gives the action to run and the next state. Changing 
+// state runs the exit action of the old state and the entry action of the new one.
+
+// Number of states of stateType
+#define UI_STATES (show_temperature + 1)
+
+// Events of the state machine
+typedef enum uiEvent_enum {
+    event_digit,        // remote 0 to 9
+    event_mode,         // remote M
+    event_stop,         // remote S
+    event_right,        // remote R
+    event_left,         // remote L
+    event_slash,        // remote /
+    event_alarm_toggle, // remote A
+    event_hour_mode,    // remote P
+    event_other,        // remote error or unused button
+    event_click,        // snooze/dismiss button click
+    event_long_press,   // snooze/dismiss button long press
+    event_double_click, // snooze/dismiss button double click
+    event_tap,          // tap or double tap of the clock (MPU)
+    event_shake,        // shaking of the clock for SHAKE_DISMISS_SECONDS (MPU)
+    event_countdown,    // a countdown or the snooze expired
+    event_alarm,        // the clock reached the time of the activated alarm
+    event_count}
+uiEvent;
+
+// Returns the event of a button from get_remote_input()
+uiEvent button_event(char button);
+
+// Returns the event of a snooze/dismiss button event from get_switch_event()
+uiEvent switch_event(switchEvent input);
+
+// Returns the event of a gesture from poll_movement()
+uiEvent shake_event(shakeGesture gesture);
+
+// Runs the transition of the current state for event. button is the remote button 
+// that caused the event (the digit typed for event_digit), 0 for other inputs.
+void dispatch_event(uiEvent event, char button);
+
+#endif
@@ -0,0 +1,121 @@
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "warm_restart.h"
+#include "watchdog.h"
+
+// Value of the magic field of a saved state
+#define SAVED_STATE_MAGIC 0xC10C
+
+// Current system state (global variable in main)
+extern volatile stateType state;
+
+// Current clock time digits and AM/PM status (global variables in main) 
+extern volatile char time_digits [TIME_DIGITS_NUMBER];
+extern volatile char am_pm; // 0 is AM and 1 is PM
+extern volatile int hour_mode;
+// Alarm time digits and AM/PM status (global variables in main)
+extern volatile char alarm_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char alarm_am_pm;
+
+// Status of alarm being activated or deactivated (global variable in main)
+extern volatile char alarm_activation; // 1 is activated, 0 is deactivated
+
+// Counter of clock ticks within the current minute and minutes counted but not advanced 
+// yet (global variables in clock)
+extern volatile unsigned int counter;
+extern volatile unsigned int clock_minutes_pending;
+
+// Current date in days since 2000-01-01 (global variable in calendar)
+extern volatile unsigned int day_number;
+
+// Copy of the state kept across resets
+typedef struct savedState_struct {
+    unsigned int magic;
+    char time_digits [TIME_DIGITS_NUMBER];
+    char am_pm;
+    char hour_mode;
+    char alarm_time_digits [TIME_DIGITS_NUMBER];
+    char alarm_am_pm;
+    char alarm_activation;
+    char state;
+    unsigned int counter;
+    unsigned int day_number;
+    unsigned char checksum;
+} savedState;
+
+// Saved state in RAM that the C runtime does not clear at startup
+savedState saved_state __attribute__((section(".noinit")));
+
+// Checksum over all fields before the checksum field
+static unsigned char saved_state_checksum(){
+    const unsigned char * bytes = (const unsigned char *)&saved_state;
+    unsigned char sum = 0x5A;
+    for(unsigned char k = 0; k < offsetof(savedState, checksum); k++)
+        sum = (sum << 1 | sum >> 7) ^ bytes[k];
+    return sum;
+}
+
+// Copies the clock time, date, alarm, hour mode and system state to a RAM area that is not 
+// cleared at startup (.noinit), with a magic number and a checksum. Called once a 
+// second from the interaction loop (update_clock()), so a change is kept within a 
+// second.
+void save_clock_state(){
+
+    // the clock timer interrupt moves the counter, and may have counted a minute that 
+    // is not in the time digits yet: the state is saved the next second then
+    unsigned char sreg = SREG;
+    cli();
+    unsigned int ticks = counter;
+    unsigned int minutes = clock_minutes_pending;
+    SREG = sreg;
+    if(minutes != 0)
+        return;
+
+    saved_state.magic = SAVED_STATE_MAGIC;
+    for(unsigned char k = 0; k < TIME_DIGITS_NUMBER; k++){
+        saved_state.time_digits[k] = time_digits[k];
+        saved_state.alarm_time_digits[k] = alarm_time_digits[k];
+    }
+    saved_state.am_pm = am_pm;
+    saved_state.hour_mode = hour_mode;
+    saved_state.alarm_am_pm = alarm_am_pm;
+    saved_state.alarm_activation = alarm_activation;
+    saved_state.state = state;
+    saved_state.counter = ticks;
+    saved_state.day_number = day_number;
+    saved_state.checksum = saved_state_checksum();
+}
+
+// Restores the state saved by save_clock_state() if the last reset kept RAM intact 
+// (watchdog, brown-out or external reset, not power-on) and the saved copy is valid. 
+// Returns 1 if the state was restored and 0 if the initial values are used.
+int restore_clock_state(){
+
+    // RAM content is random after a power-on reset
+    if(reset_cause & (1 << PORF))
+        return 0;
+    if(saved_state.magic != SAVED_STATE_MAGIC || saved_state.checksum != saved_state_checksum())
+        return 0;
+
+    for(unsigned char k = 0; k < TIME_DIGITS_NUMBER; k++){
+        time_digits[k] = saved_state.time_digits[k];
+        alarm_time_digits[k] = saved_state.alarm_time_digits[k];
+    }
+    am_pm = saved_state.am_pm;
+    hour_mode = saved_state.hour_mode;
+    alarm_am_pm = saved_state.alarm_am_pm;
+    alarm_activation = saved_state.alarm_activation;
+    counter = saved_state.counter;
+    day_number = saved_state.day_number;
+
+    // a ringing alarm keeps ringing, the time and alarm being set and the countdowns 
+    // are lost
+    if(saved_state.state == alarm_on)
+        state = alarm_on;
+    else
+        state = show_time;
+
+    return 1;
+}
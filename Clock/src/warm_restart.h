@@ -0,0 +1,15 @@
+#ifndef WARM_RESTART_H
+#define WARM_RESTART_H
+
+// Copies the clock time, date, alarm, hour mode and system state to a RAM area that is not 
+// cleared at startup (.noinit), with a magic number and a checksum. Called once a 
+// second from the interaction loop (update_clock()), so a change is kept within a 
+// second.
+void save_clock_state();
+
+// Restores the state saved by save_clock_state() if the last reset kept RAM intact 
+// (watchdog, brown-out or external reset, not power-on) and the saved copy is valid. 
+// Returns 1 if the state was restored and 0 if the initial values are used.
+int restore_clock_state();
+
+#endif
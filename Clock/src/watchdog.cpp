@@ -0,0 +1,33 @@
+#include <avr/io.h>
+#include <avr/wdt.h>
+#include "watchdog.h"
+
+// Copy of MCUSR taken at startup before it is cleared. Kept in .noinit because it 
+// is written before the C runtime clears .bss.
+unsigned char reset_cause __attribute__((section(".noinit")));
+
+// Runs from .init3, before main() and before .data/.bss are set up. The watchdog 
+// stays enabled after a watchdog reset, so it has to be turned off right away or 
+// the MCU keeps resetting during initialization.
+void save_reset_cause() __attribute__((naked, used, section(".init3")));
+void save_reset_cause(){
+    reset_cause = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+}
+
+// Enables the watchdog with a 1 second timeout. The main loop has to call 
+// feed_watchdog() at least once a second, otherwise the MCU is reset.
+void init_watchdog(){
+    wdt_enable(WDTO_1S);
+}
+
+// Restarts the watchdog timeout
+void feed_watchdog(){
+    wdt_reset();
+}
+
+// Returns 1 if the last reset was caused by the watchdog (main loop stalled)
+int reset_by_watchdog(){
+    return (reset_cause & (1 << WDRF)) != 0;
+}
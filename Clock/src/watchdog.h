@@ -0,0 +1,18 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+// Copy of MCUSR taken at startup before it is cleared. Holds the cause of the last 
+// reset (PORF, EXTRF, BORF, WDRF bits).
+extern unsigned char reset_cause;
+
+// Enables the watchdog with a 1 second timeout. The main loop has to call 
+// feed_watchdog() at least once a second, otherwise the MCU is reset.
+void init_watchdog();
+
+// Restarts the watchdog timeout
+void feed_watchdog();
+
+// Returns 1 if the last reset was caused by the watchdog (main loop stalled)
+int reset_by_watchdog();
+
+#endif
@@ -0,0 +1,316 @@
+#include <unity.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "calendar.h"
+
+// The calendar of the firmware over 2000 to 2099 against a plain reference: dates
+// counted one day after the other, the weekday carried along from 2000-01-01 (a
+// Saturday), and DST transitions found by walking the days of the month.
+
+// The firmware only builds the zone selected by DST_ZONE. calendar.cpp is built again
+// here for each entry of dst_zones, each copy in its own namespace with its own date
+// and DST state.
+#undef DST_ZONE
+#define DST_ZONE 0
+namespace zone0 {
+#include "../../src/calendar.cpp"
+}
+#undef DST_ZONE
+#define DST_ZONE 1
+namespace zone1 {
+#include "../../src/calendar.cpp"
+}
+#undef DST_ZONE
+#define DST_ZONE 2
+namespace zone2 {
+#include "../../src/calendar.cpp"
+}
+#undef DST_ZONE
+#define DST_ZONE 3
+namespace zone3 {
+#include "../../src/calendar.cpp"
+}
+
+#define YEARS 100
+#define FIRST_YEAR 2000
+
+// Transition of a DST rule, as in dst_zones
+typedef struct referenceRule_struct {
+    int month;
+    int week;
+    int day;
+    int hour;
+} referenceRule;
+
+// Rules and entry points of one copy of calendar.cpp
+typedef struct zoneCopy_struct {
+    referenceRule start;
+    referenceRule end;
+    volatile unsigned int * day_number;
+    volatile char * dst_active;
+    void (*init_calendar)(char hours);
+    void (*calendar_next_day)();
+    signed char (*dst_transition)(char hours);
+} zoneCopy;
+
+#define ZONE_RULE(rule) {rule.month, rule.week, rule.day, rule.hour}
+#define ZONE_COPY(zone) {ZONE_RULE(zone::dst_zone.start), ZONE_RULE(zone::dst_zone.end), \
+    &zone::day_number, &zone::dst_active, zone::init_calendar, zone::calendar_next_day, \
+    zone::dst_transition}
+
+static const zoneCopy zones[] = {
+    ZONE_COPY(zone0), ZONE_COPY(zone1), ZONE_COPY(zone2), ZONE_COPY(zone3)};
+
+/*Reference*/
+
+static int leap_year(int year){
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int month_length(int year, int month){
+    static const int lengths[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return lengths[month - 1] + (month == 2 && leap_year(year));
+}
+
+// Date and weekday of every day from 2000-01-01 on
+typedef struct referenceDay_struct {
+    int year;
+    int month;
+    int day;
+    int weekday;
+} referenceDay;
+
+static referenceDay days[YEARS * 366];
+static unsigned int day_count = 0;
+
+// Index of the first day of each year
+static unsigned int year_start[YEARS + 1];
+
+static void build_reference(){
+    if(day_count)
+        return;
+    referenceDay d = {FIRST_YEAR, 1, 1, saturday};
+    while(d.year < FIRST_YEAR + YEARS){
+        if(d.month == 1 && d.day == 1)
+            year_start[d.year - FIRST_YEAR] = day_count;
+        days[day_count++] = d;
+        d.weekday = (d.weekday + 1) % 7;
+        d.day += 1;
+        if(d.day > month_length(d.year, d.month)){
+            d.day = 1;
+            d.month += 1;
+            if(d.month > 12){
+                d.month = 1;
+                d.year += 1;
+            }
+        }
+    }
+    year_start[YEARS] = day_count;
+}
+
+// Day of a DST rule in a year: the n-th (or last) given weekday of the month
+static unsigned int reference_transition(int year, int month, int week, int weekday){
+    unsigned int found[5];
+    int count = 0;
+    for(unsigned int k = year_start[year - FIRST_YEAR]; k < year_start[year - FIRST_YEAR + 1]; k++)
+        if(days[k].month == month && days[k].weekday == weekday)
+            found[count++] = k;
+    return week == 5 ? found[count - 1] : found[week - 1];
+}
+
+// DST in effect at the given day and clock hour. The clock jumps from the start hour
+// to the hour after and goes back through the hour before the end hour, which is
+// given as the second pass here (standard time).
+static int reference_dst(const zoneCopy * zone, unsigned int day, int hours){
+    if(zone->start.month == 0)
+        return 0;
+    int year = days[day].year;
+    unsigned int start = reference_transition(year, zone->start.month, zone->start.week, zone->start.day);
+    unsigned int end = reference_transition(year, zone->end.month, zone->end.week, zone->end.day);
+    long now = (long)day * 24 + hours;
+    long dst_from = (long)start * 24 + zone->start.hour + 1;
+    long dst_to = (long)end * 24 + zone->end.hour;
+    if(start < end)
+        return now >= dst_from && now < dst_to;
+    return now >= dst_from || now < dst_to;
+}
+
+void setUp(){
+    build_reference();
+}
+
+void tearDown(){
+}
+
+/*Dates*/
+
+void test_civil_from_days(){
+    int mismatches = 0;
+    for(unsigned int k = 0; k < day_count; k++){
+        civilDate date = civil_from_days(k);
+        if(date.year != (unsigned int)days[k].year || date.month != days[k].month ||
+            date.day != days[k].day){
+            if(mismatches++ < 5)
+                printf("day %u: %u-%u-%u instead of %d-%d-%d\n", k, date.year, date.month,
+                    date.day, days[k].year, days[k].month, days[k].day);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, mismatches);
+}
+
+void test_days_from_civil(){
+    int mismatches = 0;
+    for(unsigned int k = 0; k < day_count; k++){
+        unsigned int days_since = days_from_civil(days[k].year, days[k].month, days[k].day);
+        if(days_since != k && mismatches++ < 5)
+            printf("%d-%d-%d: day %u instead of %u\n", days[k].year, days[k].month,
+                days[k].day, days_since, k);
+    }
+    TEST_ASSERT_EQUAL(0, mismatches);
+
+    // constant dates are worked out by the compiler
+    static_assert(days_from_civil(2000, 1, 1) == 0, "2000-01-01");
+    static_assert(days_from_civil(2000, 3, 1) == 60, "leap day of 2000");
+    static_assert(days_from_civil(2100, 1, 1) == 36525, "2100-01-01");
+}
+
+void test_weekday(){
+    int mismatches = 0;
+    for(unsigned int k = 0; k < day_count; k++)
+        mismatches += weekday(k) != days[k].weekday;
+    TEST_ASSERT_EQUAL(0, mismatches);
+}
+
+/*DST*/
+
+// DST state at every hour of every day, as set at startup or by set_date()
+static int check_zone_state(const zoneCopy * zone){
+    int mismatches = 0;
+    for(unsigned int k = 0; k < day_count; k++){
+        for(int hours = 0; hours < 24; hours++){
+            *zone->day_number = k;
+            zone->init_calendar(hours);
+            int expected = reference_dst(zone, k, hours);
+            if(*zone->dst_active != expected && mismatches++ < 5)
+                printf("zone %d, %d-%d-%d %d:00: DST %d instead of %d\n", (int)(zone - zones),
+                    days[k].year, days[k].month, days[k].day, hours, *zone->dst_active, expected);
+        }
+    }
+    return mismatches;
+}
+
+// Runs the clock from 2000-01-01 midnight: the date moves at midnight and the
+// transitions are asked for at the start of every hour, as the clock timer interrupt
+// does. Each year must have its start and end transition on the right day and hour.
+static int check_zone_transitions(const zoneCopy * zone){
+    int mismatches = 0;
+    *zone->day_number = 0;
+    zone->init_calendar(0);
+    for(int year = FIRST_YEAR; year < FIRST_YEAR + YEARS; year++){
+        int starts = 0, ends = 0;
+        for(unsigned int k = year_start[year - FIRST_YEAR]; k < year_start[year - FIRST_YEAR + 1]; k++){
+            if(k > 0)
+                zone->calendar_next_day();
+            for(int hours = 0; hours < 24; hours++){
+                signed char shift = zone->dst_transition(hours);
+                if(shift > 0){
+                    starts += 1;
+                    mismatches += k != reference_transition(year, zone->start.month,
+                        zone->start.week, zone->start.day) || hours != zone->start.hour;
+                    // the clock goes on from the next hour
+                    hours += 1;
+                }
+                else if(shift < 0){
+                    ends += 1;
+                    mismatches += k != reference_transition(year, zone->end.month,
+                        zone->end.week, zone->end.day) || hours != zone->end.hour;
+                }
+                // the hour repeated at the end of DST is not told apart by the reference
+                if(ends && hours == zone->end.hour - 1 && k == reference_transition(year,
+                    zone->end.month, zone->end.week, zone->end.day))
+                    continue;
+                mismatches += *zone->dst_active != reference_dst(zone, k, hours);
+            }
+        }
+        int expected = zone->start.month != 0;
+        if(starts != expected || ends != expected){
+            printf("zone %d, %d: %d starts and %d ends\n", (int)(zone - zones), year, starts, ends);
+            mismatches += 1;
+        }
+    }
+    return mismatches;
+}
+
+void test_no_dst(){
+    TEST_ASSERT_EQUAL(0, check_zone_state(&zones[0]));
+    TEST_ASSERT_EQUAL(0, check_zone_transitions(&zones[0]));
+}
+
+void test_dst_united_states(){
+    TEST_ASSERT_EQUAL(0, check_zone_state(&zones[1]));
+    TEST_ASSERT_EQUAL(0, check_zone_transitions(&zones[1]));
+}
+
+void test_dst_european_union(){
+    TEST_ASSERT_EQUAL(0, check_zone_state(&zones[2]));
+    TEST_ASSERT_EQUAL(0, check_zone_transitions(&zones[2]));
+}
+
+// DST spans the new year: the start is later in the year than the end
+void test_dst_australia(){
+    TEST_ASSERT_TRUE(zones[3].start.month > zones[3].end.month);
+    TEST_ASSERT_EQUAL(0, check_zone_state(&zones[3]));
+    TEST_ASSERT_EQUAL(0, check_zone_transitions(&zones[3]));
+}
+
+// Known dates
+void test_dst_dates(){
+    // United States, 2024: March 10 to November 3
+    *zones[1].day_number = days_from_civil(2024, 3, 10);
+    zones[1].init_calendar(0);
+    TEST_ASSERT_EQUAL(0, *zones[1].dst_active);
+    TEST_ASSERT_EQUAL(1, zones[1].dst_transition(2));
+    TEST_ASSERT_EQUAL(1, *zones[1].dst_active);
+    *zones[1].day_number = days_from_civil(2024, 11, 3);
+    zones[1].init_calendar(0);
+    TEST_ASSERT_EQUAL(1, *zones[1].dst_active);
+    TEST_ASSERT_EQUAL(-1, zones[1].dst_transition(2));
+    TEST_ASSERT_EQUAL(0, zones[1].dst_transition(2));
+
+    // European Union, 2024: March 31 to October 27
+    *zones[2].day_number = days_from_civil(2024, 3, 30);
+    zones[2].init_calendar(12);
+    TEST_ASSERT_EQUAL(0, *zones[2].dst_active);
+    *zones[2].day_number = days_from_civil(2024, 10, 27);
+    zones[2].init_calendar(2);
+    TEST_ASSERT_EQUAL(1, *zones[2].dst_active);
+    TEST_ASSERT_EQUAL(-1, zones[2].dst_transition(3));
+
+    // Australia, 2024: April 7 end and October 6 start
+    *zones[3].day_number = days_from_civil(2024, 1, 15);
+    zones[3].init_calendar(12);
+    TEST_ASSERT_EQUAL(1, *zones[3].dst_active);
+    *zones[3].day_number = days_from_civil(2024, 4, 7);
+    zones[3].init_calendar(4);
+    TEST_ASSERT_EQUAL(0, *zones[3].dst_active);
+    *zones[3].day_number = days_from_civil(2024, 10, 6);
+    zones[3].init_calendar(0);
+    TEST_ASSERT_EQUAL(0, *zones[3].dst_active);
+    TEST_ASSERT_EQUAL(1, zones[3].dst_transition(2));
+    TEST_ASSERT_EQUAL(1, *zones[3].dst_active);
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_civil_from_days);
+    RUN_TEST(test_days_from_civil);
+    RUN_TEST(test_weekday);
+    RUN_TEST(test_no_dst);
+    RUN_TEST(test_dst_united_states);
+    RUN_TEST(test_dst_european_union);
+    RUN_TEST(test_dst_australia);
+    RUN_TEST(test_dst_dates);
+    return UNITY_END();
+}
@@ -0,0 +1,236 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// The NMEA parser and the PPS discipline loop of gps.cpp run off-target: recorded and
+// generated NMEA sentences are fed character by character, and a clock with a crystal
+// frequency error is simulated PPS edge after PPS edge, each rate correction changing
+// the length of its ticks until the next edge.
+
+// The firmware is built without GPS_ENABLED for the other tests, gps.cpp is built
+// here with it. The clock timer side (clock_timestamp(), set_clock_rate()) is not
+// used by the parser and the loop.
+#define GPS_ENABLED 1
+#include "../../src/gps.cpp"
+
+void set_clock_rate(long adjust){
+    (void)adjust;
+}
+
+void clock_timestamp(clockTimestamp * stamp){
+    memset(stamp, 0, sizeof(clockTimestamp));
+}
+
+void setUp(){
+    nmea_state = nmea_wait_start;
+    gps_frequency = 0;
+    gps_frequency_weight = 0;
+}
+
+void tearDown(){
+}
+
+/*NMEA*/
+
+// Feeds a string, returns the number of fixes and the last one in fix
+static int feed(const char * text, nmeaFix * fix){
+    int fixes = 0;
+    for(const char * c = text; *c; c++)
+        fixes += nmea_feed(*c, fix);
+    return fixes;
+}
+
+// Builds a sentence with its checksum from the characters between $ and *
+static void sentence(char * out, const char * body){
+    unsigned char checksum = 0;
+    for(const char * c = body; *c; c++)
+        checksum ^= *c;
+    sprintf(out, "$%s*%02X\r\n", body, checksum);
+}
+
+void test_rmc_sentence(){
+    nmeaFix fix;
+    TEST_ASSERT_EQUAL(1, feed("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n", &fix));
+    TEST_ASSERT_EQUAL(12, fix.hours);
+    TEST_ASSERT_EQUAL(35, fix.minutes);
+    TEST_ASSERT_EQUAL(19, fix.seconds);
+    TEST_ASSERT_EQUAL(23, fix.day);
+    TEST_ASSERT_EQUAL(3, fix.month);
+    TEST_ASSERT_EQUAL(2094, fix.year);
+}
+
+void test_rmc_talkers_and_fractions(){
+    char text[100];
+    nmeaFix fix;
+    sentence(text, "GNRMC,235959.00,A,5109.0262,N,11401.8407,W,0.004,133.4,311224,,,D");
+    TEST_ASSERT_EQUAL(1, feed(text, &fix));
+    TEST_ASSERT_EQUAL(23, fix.hours);
+    TEST_ASSERT_EQUAL(59, fix.minutes);
+    TEST_ASSERT_EQUAL(59, fix.seconds);
+    TEST_ASSERT_EQUAL(31, fix.day);
+    TEST_ASSERT_EQUAL(12, fix.month);
+    TEST_ASSERT_EQUAL(2024, fix.year);
+}
+
+void test_rejected_sentences(){
+    char text[200];
+    nmeaFix fix;
+
+    // checksum off by one
+    TEST_ASSERT_EQUAL(0, feed("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6B\r\n", &fix));
+    // no fix
+    sentence(text, "GPRMC,123519,V,,,,,,,230394,,");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    // other sentences
+    sentence(text, "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    sentence(text, "GPRMB,A,0.66,L,003,004,4917.24,N,12309.57,W,001.3,052.5,000.5,V");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    // no checksum
+    TEST_ASSERT_EQUAL(0, feed("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W\r\n", &fix));
+    // time and date missing digits, leap second
+    sentence(text, "GPRMC,1235,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    sentence(text, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,2303,003.1,W");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    sentence(text, "GPRMC,235960,A,4807.038,N,01131.000,E,022.4,084.4,311216,003.1,W");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+    // too long
+    sentence(text, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,"
+        "0000000000000000000000000000000000000000");
+    TEST_ASSERT_EQUAL(0, feed(text, &fix));
+}
+
+// A sentence cut off by the next one, then line noise: the parser starts over at
+// every $ and the next good sentence gets through
+void test_broken_stream(){
+    char text[100];
+    nmeaFix fix;
+    TEST_ASSERT_EQUAL(0, feed("$GPRMC,1235", &fix));
+    sentence(text, "GPRMC,083000,A,4807.038,N,01131.000,E,022.4,084.4,150624,003.1,W");
+    TEST_ASSERT_EQUAL(1, feed(text, &fix));
+    TEST_ASSERT_EQUAL(8, fix.hours);
+    TEST_ASSERT_EQUAL(30, fix.minutes);
+    TEST_ASSERT_EQUAL(0, feed("\x80\xff,*ZZ\r\n$*", &fix));
+    TEST_ASSERT_EQUAL(1, feed(text, &fix));
+}
+
+// A stream of a receiver at 1 Hz: GGA, GSA and RMC each second for a minute
+void test_stream_of_seconds(){
+    char text[100];
+    nmeaFix fix;
+    int fixes = 0;
+    for(int second = 0; second < 60; second++){
+        char body[100];
+        sprintf(body, "GPGGA,1200%02d.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", second);
+        sentence(text, body);
+        fixes += feed(text, &fix);
+        sentence(text, "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1");
+        fixes += feed(text, &fix);
+        sprintf(body, "GPRMC,1200%02d.00,A,4807.038,N,01131.000,E,022.4,084.4,010725,003.1,W", second);
+        sentence(text, body);
+        int got = feed(text, &fix);
+        TEST_ASSERT_EQUAL(1, got);
+        TEST_ASSERT_EQUAL(second, fix.seconds);
+        fixes += got;
+    }
+    TEST_ASSERT_EQUAL(60, fixes);
+}
+
+/*PPS discipline*/
+
+// Simulated clock: the phase of its second (in seconds of the clock time, 0 to 1) and
+// the rate correction of its ticks. The crystal runs fast by ppm, so a second of the
+// PPS is that many more timer counts.
+typedef struct simClock_struct {
+    double phase;
+    long rate;
+    double ppm;
+} simClock;
+
+// Timer counts in a second of the clock time at the rate correction
+static double clock_second_counts(long rate){
+    return PPS_NOMINAL_COUNTS + CLOCK_TICKS_PER_SECOND * rate / 65536.0;
+}
+
+// Runs a second of the PPS and the discipline at its edge. Returns the phase of the
+// edge in timer counts as the discipline saw it.
+static long pps_second(simClock * clock, int first){
+    double pps_counts = PPS_NOMINAL_COUNTS * (1 + clock->ppm * 1e-6);
+    clock->phase += pps_counts / clock_second_counts(clock->rate);
+    clock->phase -= floor(clock->phase);
+
+    // position of the edge in the clock second, the clock second before if over half
+    double second = clock_second_counts(clock->rate);
+    long phase = lround(clock->phase * second);
+    if(phase > second / 2)
+        phase -= lround(second);
+    clock->rate = discipline_pps(first ? 0 : lround(pps_counts), phase);
+    return phase;
+}
+
+// Locks onto a crystal error and takes out the starting phase
+static void check_lock(double ppm, double start_phase){
+    simClock clock = {start_phase, 0, ppm};
+    long phase = 0;
+    for(int second = 0; second < 300; second++)
+        phase = pps_second(&clock, second == 0);
+
+    // frequency within 0.1 ppm, phase within 2 timer counts
+    double expected = ppm * 1e-6 * PPS_NOMINAL_COUNTS * 65536.0 / CLOCK_TICKS_PER_SECOND;
+    TEST_ASSERT_TRUE(fabs(gps_frequency - expected) <= 0.1e-6 * PPS_NOMINAL_COUNTS * 65536.0 / CLOCK_TICKS_PER_SECOND);
+    TEST_ASSERT_TRUE(labs(phase) <= 2);
+}
+
+void test_lock_fast_crystal(){
+    check_lock(40, 0.0);
+}
+
+void test_lock_slow_crystal_with_phase(){
+    // an edge a third of a tick after the start of the clock second
+    check_lock(-120, 1.0 / (3 * CLOCK_TICKS_PER_SECOND));
+}
+
+void test_lock_clock_ahead(){
+    check_lock(5, 1.0 - 1.0 / (3 * CLOCK_TICKS_PER_SECOND));
+}
+
+// Missed and extra edges give intervals far from a second, they are not averaged in
+void test_missed_edges(){
+    simClock clock = {0, 0, 25};
+    for(int second = 0; second < 100; second++)
+        pps_second(&clock, second == 0);
+    long frequency = gps_frequency;
+    discipline_pps(2 * PPS_NOMINAL_COUNTS, 0);
+    discipline_pps(PPS_NOMINAL_COUNTS / 3, 0);
+    TEST_ASSERT_EQUAL(frequency, gps_frequency);
+}
+
+// With the clock up to half a second off (step_clock() refused to step it), the rate
+// correction is the largest one towards the PPS, not an overflowed product
+void test_large_phase(){
+    for(long phase = TICK_COUNTS; phase < PPS_NOMINAL_COUNTS / 2; phase += TICK_COUNTS / 4){
+        setUp();
+        discipline_pps(PPS_NOMINAL_COUNTS, phase);
+        TEST_ASSERT_EQUAL(RATE_ADJUST_MAX, discipline_pps(PPS_NOMINAL_COUNTS, phase));
+        TEST_ASSERT_EQUAL(-RATE_ADJUST_MAX, discipline_pps(PPS_NOMINAL_COUNTS, -phase));
+    }
+    // the product is done in 32 bits on the target
+    TEST_ASSERT_TRUE(TICK_COUNTS * 65536.0 <= 2147483647.0);
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_rmc_sentence);
+    RUN_TEST(test_rmc_talkers_and_fractions);
+    RUN_TEST(test_rejected_sentences);
+    RUN_TEST(test_broken_stream);
+    RUN_TEST(test_stream_of_seconds);
+    RUN_TEST(test_lock_fast_crystal);
+    RUN_TEST(test_lock_slow_crystal_with_phase);
+    RUN_TEST(test_lock_clock_ahead);
+    RUN_TEST(test_missed_edges);
+    RUN_TEST(test_large_phase);
+    return UNITY_END();
+}
@@ -0,0 +1,211 @@
+#include <unity.h>
+#include "sim.h"
+#include "global_header.h"
+#include "I2C.h"
+
+// Error paths of the TWI driver (I2C.cpp) on the host simulator: the simulated bus
+// NACKs address frames, ends operations with a bus error or has a slave holding SDA
+// low, and the status codes, the i2c_errors counters, the time spent waiting and the
+// bus recovery are checked. The driver functions are called between two passes of
+// the firmware main loop, the bus is idle then. The firmware boots once, each test
+// goes on from where the previous one left the bus.
+
+// 1 once the MPU has been woken up and answers (global variable in I2C)
+extern volatile char mpu_ready;
+
+// Reads of the driver (functions in I2C)
+i2cStatus Read_from(unsigned char sla, unsigned char MEMADDRESS);
+i2cStatus Read_burst(unsigned char sla, unsigned char MEMADDRESS, unsigned char * data,
+    unsigned char count);
+unsigned char Read_data();
+
+#define MPU_ADDRESS 0x68
+// No slave answers at this address
+#define ABSENT_ADDRESS 0x50
+
+// Longest wait for the TWI hardware: TWI_TIMEOUT polls of about 6 cycles
+#define TIMEOUT_MAX_US 4000
+
+static i2cErrors errors_before;
+
+void setUp(){
+    sim_boot();
+    errors_before.timeouts = i2c_errors.timeouts;
+    errors_before.nacks = i2c_errors.nacks;
+    errors_before.bus_errors = i2c_errors.bus_errors;
+    errors_before.recoveries = i2c_errors.recoveries;
+}
+
+void tearDown(){
+}
+
+// Checks the counters moved by the given amounts since setUp()
+static void check_errors(unsigned int timeouts, unsigned int nacks, unsigned int bus_errors,
+    unsigned int recoveries){
+    TEST_ASSERT_EQUAL(timeouts, i2c_errors.timeouts - errors_before.timeouts);
+    TEST_ASSERT_EQUAL(nacks, i2c_errors.nacks - errors_before.nacks);
+    TEST_ASSERT_EQUAL(bus_errors, i2c_errors.bus_errors - errors_before.bus_errors);
+    TEST_ASSERT_EQUAL(recoveries, i2c_errors.recoveries - errors_before.recoveries);
+}
+
+void test_transactions_succeed(){
+    sim_run_ms(100);
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+
+    TEST_ASSERT_EQUAL(i2c_ok, Read_from(MPU_ADDRESS, 0x75));
+    TEST_ASSERT_EQUAL(MPU_ADDRESS, Read_data());
+    check_errors(0, 0, 0, 0);
+}
+
+// A movement check is one transaction ended by a single stop, also when it fails
+void test_movement_check_sends_one_stop(){
+    unsigned long stops = sim_twi_stops();
+    check_movement();
+    TEST_ASSERT_EQUAL(1, sim_twi_stops() - stops);
+
+    sim_twi_nack(1);
+    check_movement();
+    TEST_ASSERT_EQUAL(2, sim_twi_stops() - stops);
+    check_errors(0, 1, 0, 0);
+}
+
+// The address frame is NACKed: reported at once, the bus needs no recovery
+void test_address_nack(){
+    sim_twi_nack(1);
+    TEST_ASSERT_EQUAL(i2c_nack, StartI2C_Trans(MPU_ADDRESS));
+    StopI2C_Trans();
+    check_errors(0, 1, 0, 0);
+
+    // the next transaction goes through
+    TEST_ASSERT_EQUAL(i2c_ok, Read_from(MPU_ADDRESS, 0x75));
+    check_errors(0, 1, 0, 0);
+}
+
+// A read from a slave that is not there stops at the address frame
+void test_absent_slave(){
+    TEST_ASSERT_EQUAL(i2c_nack, Read_from(ABSENT_ADDRESS, 0x00));
+    StopI2C_Trans();
+    unsigned char data[6];
+    TEST_ASSERT_EQUAL(i2c_nack, Read_burst(ABSENT_ADDRESS, 0x00, data, 6));
+    StopI2C_Trans();
+    check_errors(0, 2, 0, 0);
+}
+
+// The start of a read ends with a bus error (status 0x00)
+void test_bus_error(){
+    sim_twi_bus_error(1);
+    TEST_ASSERT_EQUAL(i2c_bus_error, Read_from(MPU_ADDRESS, 0x75));
+    StopI2C_Trans();
+    check_errors(0, 0, 1, 0);
+
+    TEST_ASSERT_EQUAL(i2c_ok, Read_from(MPU_ADDRESS, 0x75));
+}
+
+// InitMPU() clears the bus after a bus error, not after a NACK
+void test_init_mpu_recovers_after_bus_error(){
+    sim_twi_nack(1);
+    TEST_ASSERT_EQUAL(0, InitMPU());
+    check_errors(0, 1, 0, 0);
+
+    sim_twi_bus_error(1);
+    TEST_ASSERT_EQUAL(0, InitMPU());
+    check_errors(0, 1, 1, 1);
+
+    TEST_ASSERT_EQUAL(1, InitMPU());
+}
+
+// A slave holding SDA low: the start never completes and the wait gives up after
+// TWI_TIMEOUT polls instead of hanging
+void test_stuck_bus_times_out(){
+    sim_twi_hold_sda(5);
+    uint64_t start = sim_now_us();
+    TEST_ASSERT_EQUAL(i2c_timeout, StartI2C_Trans(MPU_ADDRESS));
+    uint64_t waited = sim_now_us() - start;
+    StopI2C_Trans();
+
+    TEST_ASSERT_TRUE(waited >= TIMEOUT_MAX_US / 2);
+    TEST_ASSERT_LESS_OR_EQUAL(TIMEOUT_MAX_US, waited);
+    check_errors(1, 0, 0, 0);
+    TEST_ASSERT_EQUAL(1, sim_twi_sda_held());
+}
+
+// The recovery clocks SCL until the slave lets go of SDA, then the bus works again
+void test_recovery_releases_sda(){
+    unsigned long pulses = sim_twi_scl_pulses();
+    recover_i2c_bus();
+    TEST_ASSERT_EQUAL(0, sim_twi_sda_held());
+    TEST_ASSERT_EQUAL(5, sim_twi_scl_pulses() - pulses);
+    check_errors(0, 0, 0, 1);
+
+    TEST_ASSERT_EQUAL(i2c_ok, Read_from(MPU_ADDRESS, 0x75));
+    TEST_ASSERT_EQUAL(MPU_ADDRESS, Read_data());
+}
+
+// A slave needing more than the 9 pulses of a recovery: InitMPU() times out and
+// recovers on each attempt until SDA is released
+void test_recovery_is_bounded(){
+    sim_twi_hold_sda(20);
+    unsigned long pulses = sim_twi_scl_pulses();
+    int attempts = 0;
+    while(sim_twi_sda_held() && attempts < 5){
+        TEST_ASSERT_EQUAL(0, InitMPU());
+        attempts += 1;
+    }
+    TEST_ASSERT_EQUAL(0, sim_twi_sda_held());
+    TEST_ASSERT_EQUAL(3, attempts);
+    TEST_ASSERT_EQUAL(20, sim_twi_scl_pulses() - pulses);
+    check_errors(3, 0, 0, 3);
+
+    TEST_ASSERT_EQUAL(1, InitMPU());
+}
+
+// The bus gets stuck while the firmware runs: the movement checks time out and clear
+// the bus, the MPU is used again and the watchdog is fed all along
+void test_firmware_survives_stuck_bus(){
+    sim_run_ms(100);
+    sim_twi_hold_sda(12);
+    sim_run_ms(30000);
+
+    TEST_ASSERT_EQUAL(0, sim_twi_sda_held());
+    TEST_ASSERT_TRUE(i2c_errors.timeouts > errors_before.timeouts);
+    TEST_ASSERT_TRUE(i2c_errors.recoveries > errors_before.recoveries);
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+
+    // movement checks go through again
+    unsigned int timeouts = i2c_errors.timeouts;
+    sim_run_ms(5000);
+    TEST_ASSERT_EQUAL(timeouts, i2c_errors.timeouts);
+}
+
+// NACKs while the firmware runs (the MPU unplugged for a moment) count as errors but
+// do not pulse SCL
+void test_firmware_survives_nacks(){
+    unsigned long pulses = sim_twi_scl_pulses();
+    sim_mpu_connect(0);
+    sim_run_ms(10000);
+    sim_mpu_connect(1);
+    sim_run_ms(20000);
+
+    TEST_ASSERT_TRUE(i2c_errors.nacks > errors_before.nacks);
+    TEST_ASSERT_EQUAL(errors_before.recoveries, i2c_errors.recoveries);
+    TEST_ASSERT_EQUAL(pulses, sim_twi_scl_pulses());
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_transactions_succeed);
+    RUN_TEST(test_movement_check_sends_one_stop);
+    RUN_TEST(test_address_nack);
+    RUN_TEST(test_absent_slave);
+    RUN_TEST(test_bus_error);
+    RUN_TEST(test_init_mpu_recovers_after_bus_error);
+    RUN_TEST(test_stuck_bus_times_out);
+    RUN_TEST(test_recovery_releases_sda);
+    RUN_TEST(test_recovery_is_bounded);
+    RUN_TEST(test_firmware_survives_stuck_bus);
+    RUN_TEST(test_firmware_survives_nacks);
+    return UNITY_END();
+}
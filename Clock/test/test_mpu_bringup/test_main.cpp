@@ -0,0 +1,141 @@
+#include <unity.h>
+#include "sim.h"
+#include "global_header.h"
+#include "I2C.h"
+#include "boot.h"
+
+// Background bring-up of the MPU (poll_movement() in I2C.cpp) on the host simulator:
+// the clock boots with no MPU on the bus, the wake up attempts are checked to back off
+// from MPU_RETRY_MIN_US to MPU_RETRY_MAX_US, then the MPU is plugged in late, lost
+// and plugged in again. The firmware boots once, each test goes on from where the
+// previous one left the bus.
+
+// 1 once the MPU has been woken up and answers, delay before the next wake up attempt
+// (global variables in I2C)
+extern volatile char mpu_ready;
+extern unsigned long mpu_retry_delay;
+
+// Retry delays of the wake up attempts, as in I2C.cpp
+#define MPU_RETRY_MIN_US 250000UL
+#define MPU_RETRY_MAX_US 8000000UL
+
+// Slack on an interval between two attempts: main loop passes and TWI polls
+#define RETRY_SLACK_US 20000
+
+#define MPU_PWR_MGMT_1 0x6B
+// SLEEP bit of PWR_MGMT_1, set at power up
+#define MPU_SLEEP 0x40
+
+void setUp(){
+}
+
+void tearDown(){
+}
+
+static void check_display(const char * expected){
+    char text[5];
+    sim_display_text(text);
+    TEST_ASSERT_EQUAL_STRING(expected, text);
+}
+
+// Runs the firmware for the given time in 5 ms steps and stores the times of the wake
+// up attempts, each one NACKed once by the missing MPU. Returns the number of attempts.
+static int record_attempts(uint64_t ms, uint64_t * times, int max_times){
+    int attempts = 0;
+    unsigned int nacks = i2c_errors.nacks;
+    for(uint64_t t = 0; t < ms; t += 5){
+        sim_run_ms(5);
+        if(i2c_errors.nacks != nacks){
+            TEST_ASSERT_EQUAL(nacks + 1, i2c_errors.nacks);
+            nacks = i2c_errors.nacks;
+            if(attempts < max_times)
+                times[attempts] = sim_now_us();
+            attempts += 1;
+        }
+    }
+    return attempts;
+}
+
+// The clock comes up without waiting for the missing MPU
+void test_boot_without_mpu(){
+    sim_mpu_connect(0);
+    sim_boot();
+    sim_run_ms(100);
+
+    check_display("1200");
+    TEST_ASSERT_EQUAL(0, mpu_ready);
+    TEST_ASSERT_EQUAL(BOOT_PHASE_PENDING, get_boot_timestamp(boot_mpu));
+    TEST_ASSERT_TRUE(get_boot_timestamp(boot_main_loop) != BOOT_PHASE_PENDING);
+    TEST_ASSERT_TRUE(i2c_errors.nacks > 0);
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+}
+
+// The delay between attempts doubles from MPU_RETRY_MIN_US up to MPU_RETRY_MAX_US and
+// stays there, the bus errors need no recovery and the main loop keeps running
+void test_retries_back_off(){
+    uint64_t times[12];
+    unsigned int recoveries = i2c_errors.recoveries;
+    int attempts = record_attempts(60000, times, 12);
+    TEST_ASSERT_EQUAL(0, mpu_ready);
+
+    // 0.25, 0.5, 1, 2, 4 then 8 s apart: 7.75 s to reach the cap, then 8 s each
+    TEST_ASSERT_TRUE(attempts >= 11 && attempts <= 12);
+    unsigned long expected = MPU_RETRY_MIN_US * 2;
+    for(int k = 1; k < attempts; k++){
+        uint64_t interval = times[k] - times[k - 1];
+        TEST_ASSERT_TRUE(interval >= expected);
+        TEST_ASSERT_LESS_OR_EQUAL(expected + RETRY_SLACK_US, interval);
+        if(expected < MPU_RETRY_MAX_US)
+            expected *= 2;
+    }
+    TEST_ASSERT_EQUAL(MPU_RETRY_MAX_US, mpu_retry_delay);
+    TEST_ASSERT_EQUAL(recoveries, i2c_errors.recoveries);
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+    check_display("1201");
+}
+
+// Plugged in late, the MPU is woken up on the next attempt, at most MPU_RETRY_MAX_US
+// later, and the delay starts again from MPU_RETRY_MIN_US
+void test_late_mpu_is_brought_up(){
+    sim_mpu_connect(1);
+    TEST_ASSERT_EQUAL(MPU_SLEEP, sim_mpu_register(MPU_PWR_MGMT_1) & MPU_SLEEP);
+    uint64_t plugged = sim_now_us();
+    while(!mpu_ready && sim_now_us() - plugged < MPU_RETRY_MAX_US + RETRY_SLACK_US)
+        sim_run_ms(5);
+
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+    TEST_ASSERT_EQUAL(0, sim_mpu_register(MPU_PWR_MGMT_1) & MPU_SLEEP);
+    TEST_ASSERT_EQUAL(MPU_RETRY_MIN_US, mpu_retry_delay);
+    TEST_ASSERT_TRUE(get_boot_timestamp(boot_mpu) != BOOT_PHASE_PENDING);
+
+    // movement checks go through
+    unsigned int nacks = i2c_errors.nacks;
+    sim_run_ms(5000);
+    TEST_ASSERT_EQUAL(nacks, i2c_errors.nacks);
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+}
+
+// Lost, the MPU is given up after MPU_MAX_FAILURES failed checks, then the attempts
+// start again MPU_RETRY_MIN_US apart and bring it back once it answers
+void test_lost_mpu_is_brought_up_again(){
+    sim_mpu_connect(0);
+    sim_run_ms(20000);
+    TEST_ASSERT_EQUAL(0, mpu_ready);
+
+    sim_mpu_connect(1);
+    uint64_t plugged = sim_now_us();
+    while(!mpu_ready && sim_now_us() - plugged < MPU_RETRY_MAX_US + RETRY_SLACK_US)
+        sim_run_ms(5);
+    TEST_ASSERT_EQUAL(1, mpu_ready);
+    TEST_ASSERT_EQUAL(MPU_RETRY_MIN_US, mpu_retry_delay);
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_without_mpu);
+    RUN_TEST(test_retries_back_off);
+    RUN_TEST(test_late_mpu_is_brought_up);
+    RUN_TEST(test_lost_mpu_is_brought_up_again);
+    return UNITY_END();
+}
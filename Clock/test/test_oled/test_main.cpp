@@ -0,0 +1,132 @@
+#include <unity.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "sim.h"
+#include "global_header.h"
+#include "display.h"
+#include "I2C.h"
+#include "clock.h"
+
+// Partial updates of the SSD1306 OLED (ssd1306.cpp) on the host simulator: the bytes
+// the OLED receives (sim_oled_bytes()) for a minute change, a state change and an alarm
+// icon toggle, each against a full 1 KB frame sent the same way (8 page windows of 128
+// columns, in chunks of SSD1306_CHUNK_BYTES). The OLED is sent to between two passes of
+// the firmware main loop, the bus is idle then.
+
+// The firmware builds the display backend selected by DISPLAY_BACKEND in
+// global_header.h. ssd1306.cpp is built again here for the OLED backend, in its own
+// namespace, and driven through the calls display.cpp makes.
+#undef DISPLAY_BACKEND
+#define DISPLAY_BACKEND 2
+namespace oled {
+#include "../../src/ssd1306.cpp"
+}
+
+// Calls of ssd1306_flush() before giving up on the OLED getting up to date
+#define FLUSH_CALLS_MAX 1000
+
+// Full frame: 128 columns on 8 pages
+#define FRAME_BYTES (SSD1306_COLUMNS * SSD1306_PAGES)
+
+// Bytes received by the OLED for a full frame, measured by the first test
+static unsigned long frame_bytes = 0;
+
+void setUp(){
+    sim_boot();
+}
+
+void tearDown(){
+}
+
+// 1 once the OLED is cleared and shows every cell as set
+static int oled_up_to_date(){
+    if(!oled::oled_ready || oled::oled_pages_cleared < SSD1306_PAGES ||
+        oled::oled_sending != SSD1306_IDLE)
+        return 0;
+    for(int k = 0; k < oled::cell_count; k++)
+        if(oled::oled_cells[k] != oled::oled_shown[k])
+            return 0;
+    return 1;
+}
+
+// Flushes the OLED, one call per main loop pass as the firmware does, until it is up
+// to date. Returns the bytes the OLED received.
+static unsigned long flush_all(){
+    unsigned long bytes = sim_oled_bytes();
+    int calls = 0;
+    while(!oled_up_to_date() && calls < FLUSH_CALLS_MAX){
+        sim_run_ms(1);
+        oled::ssd1306_flush();
+        calls += 1;
+    }
+    TEST_ASSERT_TRUE(oled_up_to_date());
+    return sim_oled_bytes() - bytes;
+}
+
+// Sets the 4 digit cells to the given time, blank for a leading zero
+static void show_digits(const char digits[TIME_DIGITS_NUMBER]){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++)
+        oled::ssd1306_set_digit(k, k == 0 && digits[0] == 0 ? DIGIT_BLANK : digits[k]);
+}
+
+static void report(const char * change, unsigned long bytes){
+    printf("%s: %lu bytes, full frame %lu bytes\n", change, bytes, frame_bytes);
+    TEST_ASSERT_TRUE(bytes > 0);
+    TEST_ASSERT_TRUE(bytes < frame_bytes);
+}
+
+// Brings the OLED up showing 9:59 AM, then measures a full frame: the 8 pages cleared
+// again, which sends every byte of the screen
+void test_full_frame(){
+    const char time[TIME_DIGITS_NUMBER] = {0, 9, 5, 9};
+    oled::init_ssd1306();
+    show_digits(time);
+    oled::ssd1306_set_status(0, 1, 1, show_time);
+    flush_all();
+
+    oled::oled_pages_cleared = 0;
+    frame_bytes = flush_all();
+    printf("full frame: %lu bytes (%d bytes of display data)\n", frame_bytes, FRAME_BYTES);
+    TEST_ASSERT_TRUE(frame_bytes >= FRAME_BYTES);
+
+    // the cleared screen is drawn again
+    for(int k = 0; k < oled::cell_count; k++)
+        oled::oled_shown[k] = 0xFF;
+    flush_all();
+}
+
+// 9:59 to 10:00 changes all 4 digits, 10:00 to 10:01 only the last one
+void test_minute_change(){
+    const char ten[TIME_DIGITS_NUMBER] = {1, 0, 0, 0};
+    const char ten_one[TIME_DIGITS_NUMBER] = {1, 0, 0, 1};
+    show_digits(ten);
+    report("minute change, 4 digits", flush_all());
+    show_digits(ten_one);
+    report("minute change, 1 digit", flush_all());
+}
+
+// Setting the time: the mode icon changes
+void test_state_change(){
+    oled::ssd1306_set_status(0, 1, 1, set_time);
+    report("state change", flush_all());
+    oled::ssd1306_set_status(0, 1, 1, show_time);
+    flush_all();
+}
+
+// Turning the alarm off then on: the bell is cleared then drawn again
+void test_alarm_icon_toggle(){
+    oled::ssd1306_set_status(0, 0, 1, show_time);
+    report("alarm icon off", flush_all());
+    oled::ssd1306_set_status(0, 1, 1, show_time);
+    report("alarm icon on", flush_all());
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_full_frame);
+    RUN_TEST(test_minute_change);
+    RUN_TEST(test_state_change);
+    RUN_TEST(test_alarm_icon_toggle);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <stdio.h>
+#include <random>
+#include "pin_map.h"
+
+// The pin groups of pin_map.h against a plain reference: for every value, from random
+// register contents, each signal is set or cleared on its own pin one at a time and
+// every other bit of every port is left alone. Both display wirings (DISPLAY_WIRING 0
+// and 1, as in display.cpp and sim.cpp) are checked, then groups made to go through
+// each way of writing a port (plain store, left and right shifts, bit by bit).
+
+// Pin lists of the groups, signal order
+#define SEGMENTS_0 pin(port_a, 0), pin(port_a, 1), pin(port_a, 2), pin(port_a, 3), \
+    pin(port_a, 4), pin(port_a, 5), pin(port_a, 6), pin(port_a, 7)
+#define DIGITS_0 pin(port_c, 0), pin(port_c, 1), pin(port_c, 2), pin(port_c, 3)
+#define SEGMENTS_1 pin(port_f, 4), pin(port_f, 2), pin(port_l, 7), pin(port_l, 3), \
+    pin(port_l, 1), pin(port_f, 3), pin(port_g, 1), pin(port_l, 5)
+#define DIGITS_1 pin(port_f, 7), pin(port_f, 6), pin(port_f, 5), pin(port_k, 4)
+
+// a run of consecutive pins moved right (signal 2 on bit 0), signals alone on a port
+#define SHIFTED_RIGHT pin(port_j, 7), pin(port_e, 3), pin(port_b, 0), pin(port_b, 1), \
+    pin(port_b, 2)
+// pins out of signal order on a port, mixed with a run moved left
+#define SCATTERED pin(port_d, 6), pin(port_d, 2), pin(port_h, 3), pin(port_h, 4), \
+    pin(port_d, 0), pin(port_e, 7), pin(port_h, 5)
+
+/*Reference*/
+
+typedef struct gpioState_struct {
+    uint8_t port[gpio_port_count];
+    uint8_t ddr[gpio_port_count];
+} gpioState;
+
+static void read_registers(gpioState * s){
+    for(uint8_t p = 0; p < gpio_port_count; p++){
+        s->port[p] = pin_map::gpio_register(p, false);
+        s->ddr[p] = pin_map::gpio_register(p, true);
+    }
+}
+
+static void write_registers(const gpioState * s){
+    for(uint8_t p = 0; p < gpio_port_count; p++){
+        pin_map::gpio_register(p, false) = s->port[p];
+        pin_map::gpio_register(p, true) = s->ddr[p];
+    }
+}
+
+// Sets signal k of value on pins[k] in PORTx (ddr 0) or DDRx (ddr 1)
+static void reference_write(gpioState * s, const uint8_t * pins, int count, uint8_t value, int ddr){
+    for(int k = 0; k < count; k++){
+        uint8_t * reg = ddr ? &s->ddr[pin_map::port_of(pins[k])] : &s->port[pin_map::port_of(pins[k])];
+        if(value & (1 << k))
+            *reg |= 1 << pin_map::bit_of(pins[k]);
+        else
+            *reg &= ~(1 << pin_map::bit_of(pins[k]));
+    }
+}
+
+// Sets pins[k] as outputs in DDRx
+static void reference_outputs(gpioState * s, const uint8_t * pins, int count){
+    for(int k = 0; k < count; k++)
+        s->ddr[pin_map::port_of(pins[k])] |= 1 << pin_map::bit_of(pins[k]);
+}
+
+static std::mt19937 rng(1);
+
+static void randomize(gpioState * s){
+    for(uint8_t p = 0; p < gpio_port_count; p++){
+        s->port[p] = rng();
+        s->ddr[p] = rng();
+    }
+    write_registers(s);
+}
+
+static int compare(const gpioState * expected, const char * what, unsigned int value){
+    gpioState actual;
+    read_registers(&actual);
+    for(uint8_t p = 0; p < gpio_port_count; p++){
+        if(actual.port[p] != expected->port[p] || actual.ddr[p] != expected->ddr[p]){
+            printf("%s %u: port %c PORT %02X DDR %02X instead of %02X %02X\n", what, value,
+                'A' + p + (p >= port_j), actual.port[p], actual.ddr[p], expected->port[p],
+                expected->ddr[p]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*Checks*/
+
+// Every value written to an output group, and its init()
+template <uint8_t... Pins>
+static int check_output_pins(){
+    static const uint8_t pins[] = {Pins...};
+    const int count = sizeof...(Pins);
+    int mismatches = 0;
+    gpioState s;
+    for(unsigned int value = 0; value < (1U << count); value++){
+        for(int round = 0; round < 4; round++){
+            randomize(&s);
+            output_pins<Pins...>::write(value);
+            reference_write(&s, pins, count, value, 0);
+            mismatches += compare(&s, "write", value);
+        }
+    }
+    randomize(&s);
+    output_pins<Pins...>::init();
+    reference_outputs(&s, pins, count);
+    mismatches += compare(&s, "init", 0);
+    return mismatches;
+}
+
+// Every line selected, then none: only the selected line is an output, PORTx is not
+// touched
+template <uint8_t... Pins>
+static int check_select_pins(){
+    static const uint8_t pins[] = {Pins...};
+    const int count = sizeof...(Pins);
+    int mismatches = 0;
+    gpioState s;
+    for(uint8_t line = 0; line < count; line++){
+        randomize(&s);
+        select_pins<Pins...>::select(line);
+        reference_write(&s, pins, count, 1 << line, 1);
+        mismatches += compare(&s, "select", line);
+    }
+    randomize(&s);
+    select_pins<Pins...>::select_none();
+    reference_write(&s, pins, count, 0, 1);
+    mismatches += compare(&s, "select none", 0);
+    return mismatches;
+}
+
+void setUp(){
+}
+
+void tearDown(){
+}
+
+void test_wiring_0(){
+    TEST_ASSERT_EQUAL(0, check_output_pins<SEGMENTS_0>());
+    TEST_ASSERT_EQUAL(0, check_select_pins<DIGITS_0>());
+}
+
+void test_wiring_1(){
+    TEST_ASSERT_EQUAL(0, check_output_pins<SEGMENTS_1>());
+    TEST_ASSERT_EQUAL(0, check_select_pins<DIGITS_1>());
+}
+
+void test_shifted_and_scattered_groups(){
+    TEST_ASSERT_EQUAL(0, check_output_pins<SHIFTED_RIGHT>());
+    TEST_ASSERT_EQUAL(0, check_select_pins<SHIFTED_RIGHT>());
+    TEST_ASSERT_EQUAL(0, check_output_pins<SCATTERED>());
+    TEST_ASSERT_EQUAL(0, check_select_pins<SCATTERED>());
+}
+
+// The way each port is written, as worked out by the compiler (checked when building)
+void test_port_write_kinds(){
+    using namespace pin_map;
+    // wiring 0: one full port, one run in order
+    static_assert(port_writer<port_a, false, SEGMENTS_0>::mask == 0xFF, "plain store");
+    static_assert(port_writer<port_c, true, DIGITS_0>::shifted, "single shift");
+    static_assert(port_writer<port_c, true, DIGITS_0>::offset == 0, "no shift");
+    // wiring 1: segments scattered over ports F, G and L, digits reversed on port F
+    static_assert(port_writer<port_f, false, SEGMENTS_1>::mask == 0x1C, "port F segments");
+    static_assert(!port_writer<port_f, false, SEGMENTS_1>::shifted, "bit by bit");
+    static_assert(port_writer<port_l, false, SEGMENTS_1>::mask == 0xAA, "port L segments");
+    static_assert(port_writer<port_g, false, SEGMENTS_1>::shifted, "single signal");
+    static_assert(!port_writer<port_f, true, DIGITS_1>::shifted, "reversed digits");
+    static_assert(port_writer<port_k, true, DIGITS_1>::offset == 1, "digit 4 on PK4");
+    // the other groups
+    static_assert(port_writer<port_b, false, SHIFTED_RIGHT>::offset == -2, "right shift");
+    static_assert(port_writer<port_b, false, SHIFTED_RIGHT>::shifted, "right shift");
+    static_assert(port_writer<port_h, false, SCATTERED>::offset == 1, "left shift");
+    static_assert(!port_writer<port_h, false, SCATTERED>::shifted, "left shift broken by PH5");
+    static_assert(!port_writer<port_d, false, SCATTERED>::shifted, "out of order");
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_wiring_0);
+    RUN_TEST(test_wiring_1);
+    RUN_TEST(test_shifted_and_scattered_groups);
+    RUN_TEST(test_port_write_kinds);
+    return UNITY_END();
+}
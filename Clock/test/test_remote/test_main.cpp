@@ -0,0 +1,254 @@
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global_header.h"
+#include "timer_config.h"
+#include "power.h"
+#include "probe.h"
+#include "clock.h"
+#include "latency.h"
+#include "remote.h"
+
+// Noise benchmark of the NEC decoder: synthetic frames of every button with timing
+// jitter, dropouts in the bursts (carrier lost) and spurious pulses (fluorescent
+// lighting) are sampled on the remote timer grid and fed to the remote timer interrupt
+// routine through PINH4. The decoder is built both ways, REMOTE_FILTER 0 (a sample
+// per slot, the original decoder) and 1 (three samples per slot through the median
+// filter), and both are given the same waveforms. Rates are printed for comparison,
+// with the samples per frame and the host time spent in the interrupt routine per frame.
+// The decoder touches no timed register, so the virtual time of the simulator does not
+// move while it runs: the cost on the AVR is the samples per frame times the cycles per
+// call of probe_remote_isr (tools/probe_report.py).
+
+#undef REMOTE_FILTER
+#define REMOTE_FILTER 0
+namespace single_sample {
+#include "../../src/remote.cpp"
+}
+#undef REMOTE_FILTER
+#undef REMOTE_SAMPLES_PER_SLOT
+#undef SLOTS
+#define REMOTE_FILTER 1
+namespace median_filter {
+#include "../../src/remote.cpp"
+}
+
+// One build of the decoder: its interrupt routine, the result, its sampling period
+typedef struct decoder_struct {
+    const char * name;
+    void (*isr)();
+    char (*get_remote_input)();
+    double sample_us;
+} decoder;
+
+static const decoder decoders[] = {
+    {"single sample", single_sample::TIMER3_COMPA_vect_handler, single_sample::get_remote_input, 562.5},
+    {"median filter", median_filter::TIMER3_COMPA_vect_handler, median_filter::get_remote_input, 562.5 / 3},
+};
+
+// Noise of the frames: standard deviation of the burst and space lengths (fraction of
+// their length), chance of a dropout per burst, spurious pulses per millisecond
+typedef struct noise_struct {
+    double jitter;
+    double dropout;
+    double spurious_per_ms;
+} noise;
+
+// Outcome of a run of frames, in frames
+typedef struct outcome_struct {
+    int decoded;        // right button
+    int errors;         // 'E'
+    int missed;         // nothing decoded
+    int false_accepts;  // another button
+    long samples;       // interrupt routine calls
+    double isr_ns;      // host time in the interrupt routine
+} outcome;
+
+// Burst (IR carrier on) from start to end in microseconds
+typedef struct burst_struct {
+    double start;
+    double end;
+} burst;
+
+#define FRAMES 500
+
+// Button codes of the remote
+static const uint8_t codes[] = {0x68, 0x30, 0x18, 0x7A, 0x10, 0x38, 0x5A, 0x42, 0x4A,
+    0x52, 0x62, 0xE2, 0xC2, 0x02, 0x98, 0xA2, 0xA8};
+#define CODE_COUNT (sizeof(codes) / sizeof(codes[0]))
+
+// NEC frame of a button code: 9 ms burst, 4.5 ms space, 32 bits (a 562.5 us burst then
+// a 562.5 us space for 0 or 1687.5 us for 1) and a final burst, preceded by 130 ms and
+// followed by 60 ms of silence. Returns the length of the waveform.
+static double nec_frame(uint8_t code, const noise * n, std::mt19937 & rng, std::vector<burst> & bursts){
+    std::normal_distribution<double> normal(0, 1);
+    std::uniform_real_distribution<double> uniform(0, 1);
+
+    int bits[32];
+    for(int k = 0; k < 8; k++){
+        bits[k] = 0;
+        bits[8 + k] = 1;
+        bits[16 + k] = (code >> (7 - k)) & 1;
+        bits[24 + k] = ((uint8_t)~code >> (7 - k)) & 1;
+    }
+
+    bursts.clear();
+    double t = 130000;
+    auto mark = [&](double length){
+        double actual = length * (1 + n->jitter * normal(rng));
+        if(uniform(rng) < n->dropout){
+            // 100 to 250 us of carrier lost somewhere in the burst
+            double lost = 100 + 150 * uniform(rng);
+            double at = t + uniform(rng) * fmax(actual - lost, 0);
+            bursts.push_back({t, at});
+            bursts.push_back({at + lost, fmax(t + actual, at + lost)});
+        }
+        else{
+            bursts.push_back({t, t + actual});
+        }
+        t += length;
+    };
+    mark(9000);
+    t += 4500;
+    for(int k = 0; k < 32; k++){
+        mark(562.5);
+        t += bits[k] ? 1687.5 : 562.5;
+    }
+    mark(562.5);
+    double end = t + 60000;
+
+    // 30 to 150 us pulses at random times
+    if(n->spurious_per_ms > 0){
+        std::exponential_distribution<double> gap(n->spurious_per_ms / 1000);
+        for(double s = gap(rng); s < end; s += gap(rng))
+            bursts.push_back({s, s + 30 + 120 * uniform(rng)});
+    }
+    return end;
+}
+
+// Samples the waveform on the sampling grid of the decoder from the given phase, then
+// runs its interrupt routine for each sample. The host time of the calls is added to
+// isr_ns. Returns the number of samples.
+static long play(const decoder * d, const std::vector<burst> & bursts, double end, double phase,
+    double * isr_ns){
+    static std::vector<uint8_t> pins;
+    pins.clear();
+    for(double t = phase; t < end; t += d->sample_us){
+        bool on = false;
+        for(const burst & b : bursts)
+            if(t >= b.start && t < b.end){
+                on = true;
+                break;
+            }
+        // the receiver output is low during a burst
+        pins.push_back(on ? 0 : (1 << PINH4));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint8_t pin : pins){
+        PINH = pin;
+        d->isr();
+    }
+    *isr_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return pins.size();
+}
+
+static void run(const noise * n, outcome results[2]){
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<burst> bursts;
+    for(int d = 0; d < 2; d++)
+        results[d] = outcome{0, 0, 0, 0, 0, 0};
+
+    for(int frame = 0; frame < FRAMES; frame++){
+        uint8_t code = codes[frame % CODE_COUNT];
+        double end = nec_frame(code, n, rng, bursts);
+        double phase = uniform(rng);
+        for(int d = 0; d < 2; d++){
+            results[d].samples += play(&decoders[d], bursts, end, phase * decoders[d].sample_us,
+                &results[d].isr_ns);
+            char button = decoders[d].get_remote_input();
+            if(button == button_code_to_button(code))
+                results[d].decoded += 1;
+            else if(button == 'E')
+                results[d].errors += 1;
+            else if(button == 0)
+                results[d].missed += 1;
+            else
+                results[d].false_accepts += 1;
+        }
+    }
+
+    for(int d = 0; d < 2; d++)
+        printf("jitter %.2f dropout %.2f spurious %.2f/ms, %s: decoded %.1f%% E %.1f%% "
+            "missed %.1f%% false %.1f%%, %ld samples and %.1f us (host) per frame\n",
+            n->jitter, n->dropout, n->spurious_per_ms, decoders[d].name,
+            100.0 * results[d].decoded / FRAMES, 100.0 * results[d].errors / FRAMES,
+            100.0 * results[d].missed / FRAMES, 100.0 * results[d].false_accepts / FRAMES,
+            results[d].samples / FRAMES, results[d].isr_ns / 1000 / FRAMES);
+}
+
+void setUp(){
+}
+
+void tearDown(){
+}
+
+void test_clean_frames(){
+    noise n = {0, 0, 0};
+    outcome results[2];
+    run(&n, results);
+    TEST_ASSERT_EQUAL(FRAMES, results[0].decoded);
+    TEST_ASSERT_EQUAL(FRAMES, results[1].decoded);
+    // three samples per slot
+    TEST_ASSERT_TRUE(results[1].samples >= 3 * results[0].samples - 3);
+}
+
+void test_timing_jitter(){
+    noise n = {0.1, 0, 0};
+    outcome results[2];
+    run(&n, results);
+    TEST_ASSERT_GREATER_OR_EQUAL(FRAMES * 95 / 100, results[1].decoded);
+    TEST_ASSERT_GREATER_OR_EQUAL(results[0].decoded, results[1].decoded);
+    TEST_ASSERT_EQUAL(0, results[1].false_accepts);
+}
+
+void test_dropouts(){
+    noise n = {0, 0.1, 0};
+    outcome results[2];
+    run(&n, results);
+    TEST_ASSERT_GREATER_OR_EQUAL(results[0].decoded, results[1].decoded);
+    TEST_ASSERT_LESS_OR_EQUAL(results[0].false_accepts, results[1].false_accepts);
+}
+
+// A pulse can still land where a burst of another bit pattern would be
+void test_spurious_pulses(){
+    noise n = {0, 0, 0.2};
+    outcome results[2];
+    run(&n, results);
+    TEST_ASSERT_GREATER_OR_EQUAL(results[0].decoded, results[1].decoded);
+    TEST_ASSERT_LESS_OR_EQUAL(results[0].false_accepts, results[1].false_accepts);
+}
+
+void test_all_noise(){
+    noise n = {0.05, 0.05, 0.1};
+    outcome results[2];
+    run(&n, results);
+    TEST_ASSERT_GREATER_OR_EQUAL(results[0].decoded, results[1].decoded);
+    TEST_ASSERT_LESS_OR_EQUAL(results[0].false_accepts, results[1].false_accepts);
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_frames);
+    RUN_TEST(test_timing_jitter);
+    RUN_TEST(test_dropouts);
+    RUN_TEST(test_spurious_pulses);
+    RUN_TEST(test_all_noise);
+    return UNITY_END();
+}
@@ -0,0 +1,291 @@
+#include <unity.h>
+#include <math.h>
+#include "sim.h"
+#include "global_header.h"
+#include "clock.h"
+#include "calendar.h"
+#include "countdown.h"
+#include "power.h"
+
+// Scripted scenarios run on the host simulator (sim/sim.h) against the whole firmware:
+// remote keys, button presses and accelerometer traces go in, the 7-segment display,
+// the LEDs and the alarm tone are checked. The firmware boots once, each test goes on
+// from where the previous one left the clock.
+
+// Current system state and clock (global variables in main)
+extern volatile stateType state;
+extern volatile char time_digits [TIME_DIGITS_NUMBER];
+extern volatile char am_pm;
+extern volatile char alarm_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char alarm_activation;
+
+void setUp(){
+}
+
+void tearDown(){
+}
+
+// Sends the keys of the remote one after the other and runs the firmware until the
+// last frame has been decoded and handled
+static void press_keys(const char * keys){
+    uint64_t end = 0;
+    for(const char * key = keys; *key; key++)
+        end = sim_ir_button(*key);
+    sim_run_us(end - sim_now_us() + 50000);
+}
+
+static void check_display(const char * expected){
+    char text[5];
+    sim_display_text(text);
+    TEST_ASSERT_EQUAL_STRING(expected, text);
+}
+
+// Shakes the clock along X at the given rate for the given time, one accelerometer
+// sample every 5 ms
+static void shake(double hz, uint64_t ms){
+    for(uint64_t t = 0; t < ms; t += 5){
+        int x = (int)(12000 * sin(2 * M_PI * hz * t / 1000.0));
+        sim_schedule_us(t * 1000, [x](){ sim_mpu_accel(x, 0, 16384); });
+    }
+    sim_schedule_us(ms * 1000, [](){ sim_mpu_accel(0, 0, 16384); });
+}
+
+void test_boot_shows_initial_time(){
+    sim_boot();
+    sim_run_ms(100);
+
+    check_display("1200");
+    TEST_ASSERT_EQUAL(0, sim_am_pm_led());
+    // the alarm is on
+    TEST_ASSERT_EQUAL(1, sim_alarm_led());
+    TEST_ASSERT_EQUAL(0, sim_tone_hz());
+    TEST_ASSERT_EQUAL(show_time, state);
+}
+
+void test_remote_sets_alarm(){
+    // set_time, set_alarm, 12:01, then show_timer, show_temperature and back
+    press_keys("MM");
+    TEST_ASSERT_EQUAL(set_alarm, state);
+    press_keys("1201");
+    press_keys("MMM");
+    TEST_ASSERT_EQUAL(show_time, state);
+
+    TEST_ASSERT_EQUAL(1, alarm_time_digits[0]);
+    TEST_ASSERT_EQUAL(2, alarm_time_digits[1]);
+    TEST_ASSERT_EQUAL(0, alarm_time_digits[2]);
+    TEST_ASSERT_EQUAL(1, alarm_time_digits[3]);
+    check_display("1200");
+}
+
+void test_alarm_rings_at_alarm_time(){
+    // the keys took a few seconds, 12:01 AM comes within the minute
+    sim_run_ms(61000 - sim_now_us() / 1000);
+
+    TEST_ASSERT_EQUAL(alarm_on, state);
+    check_display("1201");
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, sim_tone_hz());
+    TEST_ASSERT_LESS_OR_EQUAL(4000, sim_tone_hz());
+
+    // the chirp sweeps the tone
+    unsigned long tone = sim_tone_hz();
+    sim_run_ms(30);
+    TEST_ASSERT_NOT_EQUAL(tone, sim_tone_hz());
+}
+
+// The chirp goes up in 50 Hz steps, one per timer 5 interrupt, from 1050 Hz to
+// 4000 Hz then starts over. The tone is read back from the TOP of timer 4 after each
+// run of the routine, rounded down to whole hertz.
+void test_chirp_sweeps_in_steps(){
+    static int previous;
+    static int steps;
+    static int wrong;
+    previous = 0;
+    steps = 0;
+    wrong = 0;
+    sim_watch_interrupts([](simVector vector, int entering){
+        if(vector != sim_TIMER5_COMPA_vect || entering)
+            return;
+        int step = (sim_tone_hz() + 1) / 50 * 50;
+        if(step - (int)sim_tone_hz() > 1 || step < 1050 || step > 4000)
+            wrong += 1;
+        else if(previous != 0 && step != (previous == 4000 ? 1050 : previous + 50))
+            wrong += 1;
+        previous = step;
+        steps += 1;
+    });
+    sim_run_ms(400);
+    sim_watch_interrupts(nullptr);
+
+    // 400 ms is at least 97 interrupts of 4.096 ms, more than a sweep
+    TEST_ASSERT_GREATER_OR_EQUAL(97, steps);
+    TEST_ASSERT_EQUAL(0, wrong);
+}
+
+void test_shake_dismisses_alarm(){
+    shake(4, 4000);
+    sim_run_ms(4500);
+
+    TEST_ASSERT_EQUAL(show_time, state);
+    TEST_ASSERT_EQUAL(0, sim_tone_hz());
+    check_display("1201");
+}
+
+void test_double_click_turns_alarm_off(){
+    sim_button(1);
+    sim_run_ms(100);
+    sim_button(0);
+    sim_run_ms(100);
+    sim_button(1);
+    sim_run_ms(100);
+    sim_button(0);
+    sim_run_ms(1000);
+
+    TEST_ASSERT_EQUAL(0, alarm_activation);
+    TEST_ASSERT_EQUAL(0, sim_alarm_led());
+}
+
+void test_year_of_minutes(){
+    // A year at full simulation speed would take hours, so the clock is moved on
+    // minute by minute as the clock interrupt does, then the display is refreshed
+    unsigned int first_day = day_number;
+    char first_dst = dst_active;
+    for(long minute = 0; minute < 366L * 24 * 60; minute++){
+        advance_minute();
+        int hours = time_digits[0] * 10 + time_digits[1];
+        int minutes = time_digits[2] * 10 + time_digits[3];
+        TEST_ASSERT_TRUE(hours >= 1 && hours <= 12);
+        TEST_ASSERT_TRUE(minutes < 60);
+    }
+
+    // 2024 is a leap year, and DST came and went
+    TEST_ASSERT_EQUAL(first_day + 366, day_number);
+    civilDate date = civil_from_days(day_number);
+    TEST_ASSERT_EQUAL(2025, date.year);
+    TEST_ASSERT_EQUAL(1, date.month);
+    TEST_ASSERT_EQUAL(1, date.day);
+    TEST_ASSERT_EQUAL(first_dst, dst_active);
+
+    sim_run_ms(100);
+    check_display("1201");
+    TEST_ASSERT_EQUAL(show_time, state);
+    TEST_ASSERT_EQUAL(0, sim_tone_hz());
+}
+
+// Share of the time a digit is lit, sampled every 37 us over a second, and the number
+// of times the display lit up again after being dark
+static int lit_edges;
+
+static double lit_share(){
+    static int lit, samples, previous;
+    lit = 0;
+    samples = 0;
+    previous = 1;
+    lit_edges = 0;
+    for(uint64_t t = 0; t < 1000000; t += 37)
+        sim_schedule_us(t, [](){
+            int now = sim_display_lit();
+            lit += now;
+            lit_edges += now && !previous;
+            previous = now;
+            samples += 1;
+        });
+    sim_run_ms(1000);
+    return (double)lit / samples;
+}
+
+// Night mode halves the on-time of each digit, the digits still rotate at 4*60 Hz.
+// The clock is a minute past midnight, in night mode.
+void test_night_mode_dims_display(){
+    TEST_ASSERT_EQUAL(1, night_mode);
+    set_night_mode(0);
+    double day = lit_share();
+
+    set_night_mode(1);
+    double night = lit_share();
+
+    TEST_ASSERT_TRUE(day > 0.95);
+    TEST_ASSERT_TRUE(fabs(night - day / 2) < 0.02);
+    // a digit lit by each of the 244 refreshes a second, none skipped
+    TEST_ASSERT_TRUE(lit_edges >= 243 && lit_edges <= 246);
+    char text[5];
+    sim_display_text(text);
+    for(int digit = 0; digit < 4; digit++)
+        TEST_ASSERT_EQUAL('0' + time_digits[digit], text[digit]);
+}
+
+// A countdown expiring while the time is being set rings the alarm, and the time
+// typed so far is kept as when leaving set_time with M
+void test_countdown_rings_in_set_time(){
+    press_keys("MMM");
+    TEST_ASSERT_EQUAL(show_timer, state);
+    press_keys("01/MM");
+    TEST_ASSERT_EQUAL(show_time, state);
+
+    // 12:0x becomes 02:0x
+    press_keys("M0");
+    TEST_ASSERT_EQUAL(set_time, state);
+    sim_run_ms(61000);
+
+    TEST_ASSERT_EQUAL(alarm_on, state);
+    TEST_ASSERT_TRUE(sim_tone_hz() > 0);
+    TEST_ASSERT_EQUAL(0, time_digits[0]);
+    TEST_ASSERT_EQUAL(2, time_digits[1]);
+
+    press_keys("S");
+    TEST_ASSERT_EQUAL(show_time, state);
+    TEST_ASSERT_EQUAL(0, sim_tone_hz());
+}
+
+// The clock timer interrupt only counts ticks and expires timers: the once a second
+// and once a minute work (state copy, minute advance, calendar) is done by the
+// interaction loop, so it never holds up the remote sampling for long. The clock time
+// and date are checked not to change within any run of the routine over midnight.
+void test_clock_interrupt_stays_short(){
+    static char digits[TIME_DIGITS_NUMBER];
+    static unsigned int day;
+    static int changes;
+    changes = 0;
+    sim_watch_interrupts([](simVector vector, int entering){
+        if(vector != sim_TIMER1_COMPA_vect)
+            return;
+        if(entering){
+            for(int k = 0; k < TIME_DIGITS_NUMBER; k++)
+                digits[k] = time_digits[k];
+            day = day_number;
+            return;
+        }
+        for(int k = 0; k < TIME_DIGITS_NUMBER; k++)
+            changes += digits[k] != time_digits[k];
+        changes += day != day_number;
+    });
+
+    set_clock_day_ticks(24UL * 60 * CLOCK_TICKS_PER_MINUTE - 150);
+    unsigned int first_day = day_number;
+    sim_run_ms(3000);
+    sim_watch_interrupts(nullptr);
+
+    TEST_ASSERT_EQUAL(first_day + 1, day_number);
+    check_display("1200");
+    TEST_ASSERT_EQUAL(0, changes);
+}
+
+void test_watchdog_was_fed(){
+    TEST_ASSERT_EQUAL(0, sim_watchdog_timeouts());
+    TEST_ASSERT_GREATER_THAN(0, sim_isr_count(sim_TIMER3_COMPA_vect));
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_shows_initial_time);
+    RUN_TEST(test_remote_sets_alarm);
+    RUN_TEST(test_alarm_rings_at_alarm_time);
+    RUN_TEST(test_chirp_sweeps_in_steps);
+    RUN_TEST(test_shake_dismisses_alarm);
+    RUN_TEST(test_double_click_turns_alarm_off);
+    RUN_TEST(test_year_of_minutes);
+    RUN_TEST(test_night_mode_dims_display);
+    RUN_TEST(test_countdown_rings_in_set_time);
+    RUN_TEST(test_clock_interrupt_stays_short);
+    RUN_TEST(test_watchdog_was_fed);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include <unity.h>
+#include "global_header.h"
+#include "shake.h"
+#include "traces.h"
+
+// Replay of the labelled traces (traces.h) through the shake classifier, as 
+// check_movement() feeds it at the full power rate, every other sample (a slower 
+// poll) and across the wrap of the millisecond time.
+
+void setUp(){
+    shake_reset();
+}
+
+void tearDown(){
+}
+
+// Feeds every step-th sample of the trace with its time offset by base_ms and 
+// returns the number of gestures, stored in gestures. The time of the first shake 
+// is stored in dismiss_ms.
+static int replay(const shakeTrace * trace, unsigned int step, unsigned int base_ms, 
+    shakeGesture gestures[4], unsigned int * dismiss_ms){
+
+    int count = 0;
+    shake_reset();
+    for(unsigned int k = 0; k < trace->count; k += step){
+        const shakeSample * sample = &trace->samples[k];
+        shakeGesture gesture = shake_feed(sample->x, sample->y, 
+            base_ms + sample->ms);
+        if(gesture == shake_none)
+            continue;
+        if(gesture == shake_dismiss && dismiss_ms)
+            *dismiss_ms = sample->ms;
+        if(count < 4)
+            gestures[count] = gesture;
+        count += 1;
+    }
+    // quiet afterwards so a burst in progress ends
+    unsigned int end = trace->samples[trace->count - 1].ms;
+    for(unsigned int ms = end + 10; ms < end + 1000; ms += 10){
+        shakeGesture gesture = shake_feed(0, 0, base_ms + ms);
+        if(gesture != shake_none){
+            if(count < 4)
+                gestures[count] = gesture;
+            count += 1;
+        }
+    }
+    return count;
+}
+
+static void check_trace(const shakeTrace * trace, unsigned int base_ms){
+    shakeGesture gestures[4];
+    int count = replay(trace, 1, base_ms, gestures, 0);
+    TEST_ASSERT_EQUAL_MESSAGE(trace->expected_count, count, trace->name);
+    for(int k = 0; k < count; k++)
+        TEST_ASSERT_EQUAL_MESSAGE(trace->expected[k], gestures[k], trace->name);
+}
+
+void test_traces(){
+    for(unsigned int k = 0; k < TRACE_COUNT; k++)
+        check_trace(&traces[k], 0);
+}
+
+// The time wraps in the middle of the traces (unsigned int: 16 bits on the AVR, where
+// it wraps every 65536 ms, 32 bits on the host)
+void test_traces_across_time_wrap(){
+    for(unsigned int k = 0; k < TRACE_COUNT; k++)
+        check_trace(&traces[k], 0U - 1500);
+}
+
+// Shaking is told as soon as it has lasted SHAKE_DISMISS_SECONDS
+void test_dismiss_delay(){
+    for(unsigned int k = 0; k < TRACE_COUNT; k++){
+        const shakeTrace * trace = &traces[k];
+        if(trace->expected[0] != shake_dismiss)
+            continue;
+        shakeGesture gestures[4];
+        unsigned int dismiss_ms = 0;
+        replay(trace, 1, 0, gestures, &dismiss_ms);
+        // the shaking starts 500 ms into the trace
+        TEST_ASSERT_GREATER_OR_EQUAL(500 + SHAKE_DISMISS_SECONDS * 1000, dismiss_ms);
+        TEST_ASSERT_LESS_OR_EQUAL(500 + SHAKE_DISMISS_SECONDS * 1000 + 250, dismiss_ms);
+    }
+}
+
+// At about 20 ms per sample a short knock can fall between two samples and be missed, 
+// but shakes are still told and nothing is ever taken for a shake
+void test_traces_at_half_rate(){
+    for(unsigned int k = 0; k < TRACE_COUNT; k++){
+        const shakeTrace * trace = &traces[k];
+        shakeGesture gestures[4];
+        int count = replay(trace, 2, 0, gestures, 0);
+        if(trace->expected[0] == shake_dismiss){
+            TEST_ASSERT_EQUAL_MESSAGE(1, count, trace->name);
+            TEST_ASSERT_EQUAL_MESSAGE(shake_dismiss, gestures[0], trace->name);
+            continue;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(trace->expected_count, count);
+        for(int g = 0; g < count && g < 4; g++)
+            TEST_ASSERT_EQUAL_MESSAGE(shake_tap, gestures[g], trace->name);
+    }
+}
+
+// A knock saturating the accelerometer at -32768 (the reading with no positive value
+// in 16 bits) is a peak like any other
+void test_saturated_knock(){
+    shakeGesture gesture = shake_none;
+    for(unsigned int ms = 0; ms < 1000; ms += 10){
+        int reading = (ms == 100) ? -32768 : 0;
+        shakeGesture g = shake_feed(reading, reading, ms);
+        if(g != shake_none){
+            TEST_ASSERT_EQUAL(shake_none, gesture);
+            gesture = g;
+        }
+    }
+    TEST_ASSERT_EQUAL(shake_tap, gesture);
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_traces);
+    RUN_TEST(test_traces_across_time_wrap);
+    RUN_TEST(test_dismiss_delay);
+    RUN_TEST(test_traces_at_half_rate);
+    RUN_TEST(test_saturated_knock);
+    return UNITY_END();
+}
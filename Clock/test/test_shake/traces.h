@@ -0,0 +1,839 @@
+#ifndef TRACES_H
+#define TRACES_H
+
+#include "shake.h"
+
+// Labelled accelerometer traces for the shake classifier replay: raw X and Y readings
+// (16384 per g) with +-500 of noise, sampled about every 10 ms (+-30% jitter) as at
+// the full power poll rate. Knocks are a 60 Hz ringing decaying over 25 to 80 ms,
+// shakes a sine, each starting 500 ms into the trace.
+
+// Sample time in milliseconds from the start of the trace and readings
+typedef struct shakeSample_struct {
+    unsigned int ms;
+    int x;
+    int y;
+} shakeSample;
+
+// Quiet
+static const shakeSample quiet_trace[] = {
+    {7, -5, 7}, {17, -203, 482}, {29, 483, -169}, {42, 239, 374}, {52, -386, 379}, {62, -492, 248},
+    {70, 370, -162}, {80, -438, -220}, {89, -97, 29}, {98, 165, 31}, {107, -150, 415}, {116, -424, -17},
+    {128, 21, 129}, {140, -264, -169}, {149, -316, -282}, {160, -104, -140}, {172, -488, -24}, {183, 297, 387},
+    {190, -38, 58}, {199, 349, 98}, {210, -377, -252}, {218, 430, -237}, {228, -198, -449}, {241, 243, 151},
+    {253, 394, 27}, {263, 360, -337}, {273, -191, 499}, {282, 381, -60}, {290, 481, 62}, {301, -153, -478},
+    {311, 270, -462}, {323, -174, 302}, {334, -265, -214}, {345, -178, 327}, {354, 115, -476}, {365, 415, 207},
+    {376, -476, -425}, {387, -214, 197}, {394, -382, 175}, {402, 32, -304}, {413, -177, -226}, {423, -57, -287},
+    {433, -156, 463}, {442, -385, -411}, {455, 31, -43}, {467, 94, -12}, {475, -140, -244}, {486, -74, -55},
+    {497, -441, -60}, {506, 281, -492}, {513, -315, -300}, {522, 66, 253}, {530, 148, -448}, {537, 169, -300},
+    {547, -6, -129}, {558, -257, 399}, {567, -45, 149}, {575, 194, 262}, {586, -431, 156}, {595, 278, 357},
+    {607, 376, -122}, {619, 451, 248}, {626, -496, -94}, {637, 387, -353}, {648, -370, -307}, {658, 334, -113},
+    {670, 156, -191}, {680, -317, -462}, {689, 78, 121}, {700, -70, 161}, {711, -144, -453}, {720, -58, 3},
+    {731, 312, -218}, {738, 151, 146}, {746, 346, 175}, {759, 127, 419}, {771, -25, -357}, {780, -360, 74},
+    {789, 1, 272}, {800, 152, 23}, {811, 340, 48}, {822, 392, 170}, {831, -230, -176}, {840, 390, 110},
+    {849, -353, 474}, {858, 164, 229}, {867, -121, -136}, {876, -55, -6}, {888, 163, 49}, {897, -399, -54},
+    {908, 291, -132}, {921, -334, -297}, {932, 32, -181}, {941, 132, -16}, {951, -94, -106}, {962, -88, 437},
+    {971, -162, -239}, {982, -384, -183}, {994, -488, 467}, {1005, 70, -227}, {1016, -66, -448}, {1028, -279, 297},
+    {1035, 488, 232}, {1044, -180, -390}, {1054, -471, 81}, {1062, 75, -9}, {1072, 265, 331}, {1084, 145, -118},
+    {1093, -492, -278}, {1101, 152, 246}, {1114, -483, -449}, {1121, 106, 2}, {1129, 13, 333}, {1140, -86, 32},
+    {1150, 121, 212}, {1157, 351, 74}, {1164, -227, 45}, {1172, 197, -489}, {1180, -137, -186}, {1192, 382, -160},
+    {1203, 176, -241}, {1212, -138, 365}, {1222, -117, 413}, {1229, -427, 381}, {1236, 106, 416}, {1244, -328, -118},
+    {1256, -115, -218}, {1266, -71, -418}, {1278, -486, 21}, {1287, -53, -226}, {1299, 86, 281}, {1309, -387, 317},
+    {1316, -254, 396}, {1326, -59, -238}, {1336, -74, -484}, {1343, 199, 421}, {1354, -372, -292}, {1363, -6, -98},
+    {1372, -493, -287}, {1383, -300, 379}, {1391, 286, -278}, {1399, 413, -339}, {1406, -189, -129}, {1417, 319, -212},
+    {1428, -267, -173}, {1441, 124, -250}, {1453, -353, -352}, {1462, -18, -448}, {1469, 184, -202}, {1476, 49, -303},
+    {1488, 352, 0}, {1500, -413, -157}, {1513, 150, 308}, {1523, 257, 179}, {1532, 249, -424}, {1544, 30, -199},
+    {1553, 254, 202}, {1560, -149, 100}, {1569, -154, -147}, {1580, -29, -15}, {1591, -185, -495}, {1604, -392, 414},
+    {1614, -210, 31}, {1627, 338, -421}, {1637, 171, 188}, {1645, 370, -290}, {1656, -429, -324}, {1663, -389, 343},
+    {1671, -234, -310}, {1683, 187, -466}, {1695, -24, 99}, {1703, -180, 320}, {1711, -32, 176}, {1720, 205, 472},
+    {1731, 290, -486}, {1739, 321, 285}, {1751, -345, -440}, {1758, 306, -22}, {1767, 252, -91}, {1775, 311, -51},
+    {1784, -462, 260}, {1793, -498, -54}, {1802, -245, -295}, {1815, 88, -89}, {1823, 241, -269}, {1832, 69, 45},
+    {1844, 297, 134}, {1856, 71, 366}, {1865, 132, -291}, {1878, 450, -204}, {1890, 194, 387}, {1898, -433, -446},
+    {1910, -103, 243}, {1922, -119, 394}, {1932, -475, 499}, {1940, 280, -37}, {1950, -134, 456}, {1960, -209, 298},
+    {1971, -169, -4}, {1984, -414, 283}, {1994, 98, 59}, {2004, -60, -454}, {2016, -421, 275}, {2029, -460, 111},
+    {2036, 206, -384}, {2045, 308, -160}, {2052, 360, -240}, {2059, -354, 402}, {2070, -64, -438}, {2078, -258, 373},
+    {2091, -156, -221}, {2098, 372, -328}, {2107, 487, -32}, {2118, 335, 412}, {2130, 473, 208}, {2142, 418, -50},
+    {2152, -394, 55}, {2161, -419, -383}, {2171, -66, -128}, {2181, -273, 483}, {2189, 397, 464}, {2201, 251, 122},
+    {2210, 338, -333}, {2220, 249, 195}, {2232, -84, 267}, {2243, 47, 371}, {2255, 198, 466}, {2265, 468, -124},
+    {2274, 485, -266}, {2283, -16, -316}, {2294, 111, -245}, {2304, -345, 146}, {2317, -217, -152}, {2324, -470, -408},
+    {2336, 223, 19}, {2346, -112, 158}, {2358, -339, -428}, {2367, -496, -83}, {2379, 429, -107}, {2387, -178, 44},
+    {2399, -268, -134}, {2410, -289, -406}, {2421, 327, 36}, {2434, 196, 126}, {2443, -308, 447}, {2455, 332, 254},
+    {2464, -82, -206}, {2472, 109, -135}, {2482, 398, 314}, {2493, 70, -448}, {2505, 62, -431}, {2516, 26, -439},
+    {2525, -295, 3}, {2536, 36, 239}, {2548, -316, -27}, {2557, -449, -185}, {2567, 28, -390}, {2579, 388, 0},
+    {2589, -281, -287}, {2602, -65, -275}, {2610, -312, -449}, {2620, -270, 21}, {2632, -180, 235}, {2641, 349, -160},
+    {2653, -25, 85}, {2662, 239, 329}, {2671, -185, 114}, {2682, -102, -133}, {2690, -14, -424}, {2697, -427, -139},
+    {2706, -97, 191}, {2713, 380, 118}, {2720, 199, -497}, {2729, 494, 294}, {2740, -390, 466}, {2748, -186, -280},
+    {2758, -194, 233}, {2766, 272, -372}, {2777, 492, -258}, {2788, -308, -437}, {2801, -222, -460}, {2813, -178, -493},
+    {2823, -407, 6}, {2831, 3, 2}, {2840, -289, -145}, {2848, -414, 300}, {2859, -363, -414}, {2868, 1, 318},
+    {2880, 390, 298}, {2889, 186, -64}, {2896, -10, 20}, {2907, -289, -85}, {2917, 127, 438}, {2924, -189, 468},
+    {2937, 362, -280}, {2944, 201, 269}, {2957, -170, -195}, {2970, 350, 414}, {2981, 259, 341}, {2993, -400, -357}
+};
+
+// Single knock
+static const shakeSample single_tap_trace[] = {
+    {3, 157, 45}, {15, -171, -79}, {26, -61, -152}, {35, -470, -150}, {48, -496, -473}, {60, 131, 402},
+    {68, -151, 227}, {79, -141, -363}, {92, -143, -381}, {102, -312, -242}, {109, 331, 314}, {118, -50, 65},
+    {127, -238, -74}, {138, 135, 320}, {150, -33, -256}, {158, 214, 182}, {169, -449, -119}, {177, 463, 135},
+    {184, -213, 358}, {195, -386, 37}, {206, 368, 448}, {215, -162, 228}, {224, 171, 291}, {233, -147, -175},
+    {246, -71, -425}, {256, 180, -377}, {267, 487, -207}, {275, 340, -229}, {282, 36, 391}, {293, -497, 97},
+    {306, 480, -195}, {316, -106, -222}, {325, -149, 173}, {338, -24, -287}, {346, 414, 292}, {355, 184, -186},
+    {363, -100, 35}, {371, -239, 67}, {382, -37, 322}, {390, -52, 53}, {402, -152, 388}, {413, -408, 320},
+    {421, -153, -109}, {429, -68, -232}, {438, 10, 142}, {449, 97, -48}, {462, 230, 497}, {473, -394, -37},
+    {486, -377, -338}, {496, -116, 281}, {506, -5700, 480}, {519, 1593, -224}, {532, 2169, 463}, {544, -591, -265},
+    {556, -787, 89}, {568, 400, -390}, {580, -272, -326}, {591, 84, -145}, {598, -30, 315}, {605, -105, 29},
+    {616, -102, 229}, {625, 196, 73}, {637, 308, 468}, {649, 46, 398}, {657, 168, -165}, {666, 469, 220},
+    {675, -106, -493}, {683, -4, 269}, {694, -280, -341}, {702, -158, -203}, {713, -407, 112}, {722, 392, -472},
+    {733, -262, -207}, {740, 494, -19}, {751, -431, -475}, {761, 416, 280}, {771, 319, 452}, {784, 47, 403},
+    {792, -421, 110}, {804, -420, 495}, {816, -398, -70}, {824, -282, -341}, {835, 80, -299}, {843, 200, 394},
+    {850, -228, 296}, {861, 158, -431}, {873, 124, -339}, {884, -403, -406}, {897, -158, -140}, {906, 26, 201},
+    {916, 0, -275}, {927, 35, -8}, {936, 162, 361}, {946, 316, -364}, {954, -377, -430}, {965, 443, 412},
+    {976, -309, -65}, {987, 432, 475}, {997, -319, 145}, {1008, -148, -2}, {1017, 1, -197}, {1029, 22, 119},
+    {1039, -483, -246}, {1048, -396, 340}, {1060, 57, -262}, {1071, -445, -229}, {1082, -224, -127}, {1090, 308, 385},
+    {1101, -280, 259}, {1112, -359, 208}, {1121, -206, -260}, {1133, -456, 61}, {1142, 18, -411}, {1152, 121, 298},
+    {1160, -264, -326}, {1169, 304, -323}, {1182, 167, 353}, {1189, -109, 263}, {1198, 489, 160}, {1205, 215, 55},
+    {1217, 325, 40}, {1228, 472, -306}, {1238, 306, -323}, {1247, 471, 435}, {1257, 119, 194}, {1269, 353, 315},
+    {1278, 188, 264}, {1287, -445, 101}, {1295, -98, 379}, {1307, 55, -491}, {1315, 31, -133}, {1322, -324, -221},
+    {1332, -228, -125}, {1345, -31, -432}, {1354, -482, 402}, {1363, -17, -226}, {1373, 338, 129}, {1386, -73, -278},
+    {1393, -247, -408}, {1400, -485, -135}, {1410, 240, -29}, {1422, -464, -103}, {1432, -344, -460}, {1443, -96, -56},
+    {1454, 405, -453}, {1465, 252, 232}, {1473, 104, 57}, {1483, -174, 402}, {1496, 67, 41}, {1505, 212, 349},
+    {1517, -177, -252}, {1529, 206, 279}, {1538, -462, 120}, {1546, -190, 361}, {1554, 22, -172}, {1567, 175, 145},
+    {1574, -286, 135}, {1583, 18, -355}, {1593, -208, -291}, {1600, -234, -253}, {1610, 346, 77}, {1621, 482, 350},
+    {1630, 237, 326}, {1638, 368, 394}, {1647, 60, 280}, {1657, 331, -326}, {1666, 377, 214}, {1676, -62, 107},
+    {1688, 113, -124}, {1701, -233, -134}, {1713, -222, 338}, {1721, -58, 499}, {1732, -84, -8}, {1739, 386, 0},
+    {1749, -54, -332}, {1758, 66, 421}, {1769, 292, -290}, {1777, 265, 491}, {1786, 467, -493}, {1793, -332, 353},
+    {1801, -495, -233}, {1813, -219, 357}, {1823, -95, -424}, {1831, -22, -456}, {1838, 8, 7}, {1849, 192, 237},
+    {1858, 428, -166}, {1870, 52, -100}, {1878, -24, -410}, {1889, -30, 154}, {1897, 213, 59}, {1907, 481, -371},
+    {1916, -441, -67}, {1927, -129, 33}, {1935, -420, 179}, {1943, -163, -373}, {1955, -98, 426}, {1968, -231, -32},
+    {1978, -123, 347}, {1988, -124, -376}, {1999, -87, -119}
+};
+
+// Double knock 260 ms apart
+static const shakeSample double_tap_trace[] = {
+    {7, 231, 298}, {18, -231, 348}, {31, 69, -43}, {39, -270, -6}, {48, 48, -369}, {61, 279, 408},
+    {74, -222, 451}, {85, -16, 456}, {97, 106, 426}, {107, -321, -44}, {116, 311, 46}, {123, -65, 153},
+    {134, -180, 62}, {142, -198, 427}, {151, 131, -4}, {163, -392, 373}, {171, 352, -371}, {180, 350, 184},
+    {190, 481, -469}, {200, -37, -14}, {209, 375, 389}, {221, 471, -483}, {231, 28, -315}, {242, -148, 331},
+    {254, -411, -19}, {266, 84, 412}, {276, 255, -127}, {288, -281, -136}, {297, -18, 366}, {306, -43, 74},
+    {317, -396, 222}, {329, 51, -462}, {342, -147, -457}, {352, -462, 185}, {363, 357, -354}, {372, -410, -46},
+    {380, -424, -13}, {389, -468, -77}, {402, 291, -325}, {410, 274, 245}, {417, 108, -138}, {429, 228, -276},
+    {439, 57, 31}, {449, -47, -278}, {461, 267, -27}, {474, -417, -196}, {487, 324, -35}, {496, -174, 257},
+    {504, -1199, 466}, {517, 4509, 417}, {526, -2702, 321}, {534, 1652, 431}, {546, 299, 284}, {554, -52, -119},
+    {564, 757, 377}, {577, -516, 420}, {588, -29, 370}, {597, -224, 330}, {605, 5, 416}, {617, -360, -359},
+    {630, 268, -382}, {639, 171, 241}, {651, 343, 56}, {660, 282, 131}, {668, -230, -425}, {677, 299, -303},
+    {685, 148, 327}, {696, -19, -295}, {708, 107, -101}, {719, -418, 394}, {731, 247, -497}, {743, 489, -169},
+    {754, -470, -440}, {766, -4907, 422}, {777, 4076, -326}, {789, 677, 277}, {796, 714, -209}, {809, 1159, -230},
+    {819, -240, 78}, {831, -524, -493}, {842, 704, -206}, {850, -635, -411}, {858, 389, 182}, {869, 0, -191},
+    {879, 100, 190}, {891, 137, 218}, {899, -512, -495}, {910, -472, 196}, {922, 436, 227}, {933, -337, -56},
+    {943, -163, 194}, {953, 363, 44}, {964, 291, -270}, {974, 229, -485}, {982, 78, 362}, {990, -484, 481},
+    {1000, -16, -200}, {1010, -279, 410}, {1020, 211, 157}, {1028, 304, -471}, {1041, 184, 273}, {1051, -417, -144},
+    {1061, -76, -407}, {1073, -465, -8}, {1085, 400, -72}, {1098, 90, -416}, {1110, 37, 126}, {1122, 159, 101},
+    {1130, 242, 422}, {1142, 432, 357}, {1151, -353, -7}, {1162, -255, -96}, {1174, 443, 16}, {1181, -465, 228},
+    {1194, 0, 270}, {1206, -336, 399}, {1214, -378, 11}, {1223, -353, -440}, {1230, 151, -278}, {1238, 57, 439},
+    {1249, -204, -42}, {1259, -337, -215}, {1266, 339, 363}, {1279, -466, 358}, {1291, -349, -391}, {1300, 203, -74},
+    {1308, 137, -201}, {1317, -379, 369}, {1330, -443, -376}, {1343, 445, -140}, {1354, 339, 291}, {1362, -28, -292},
+    {1372, 330, 17}, {1383, -306, 336}, {1394, -397, -400}, {1403, 315, -488}, {1413, -247, 370}, {1423, -285, -262},
+    {1436, -165, -450}, {1445, 162, 474}, {1456, -167, -224}, {1466, -186, -401}, {1474, 338, 362}, {1483, 257, 228},
+    {1495, -172, -457}, {1503, -339, -129}, {1511, -297, -259}, {1524, -221, 486}, {1533, 2, -345}, {1543, -129, -62},
+    {1552, 436, -316}, {1561, 296, -68}, {1569, 149, -33}, {1580, 331, 383}, {1587, 369, 78}, {1600, 473, -138},
+    {1610, -145, 161}, {1622, 280, -495}, {1629, -215, 18}, {1638, -482, -422}, {1650, -490, 452}, {1659, 135, -424},
+    {1668, 310, -113}, {1678, 385, -478}, {1690, 78, 36}, {1702, 70, -131}, {1710, -434, 181}, {1719, -261, 171},
+    {1727, -383, 296}, {1739, 342, 415}, {1750, -456, 96}, {1761, -359, -320}, {1772, -466, -245}, {1781, 374, -476},
+    {1789, -239, -153}, {1799, 13, 263}, {1810, -393, -222}, {1821, -421, 43}, {1829, 137, -250}, {1841, -155, 348},
+    {1854, -249, 26}, {1862, -61, 382}, {1873, -352, 48}, {1881, 130, 453}, {1892, -467, -339}, {1903, 331, 272},
+    {1911, -296, 496}, {1923, -410, -162}, {1931, 434, 294}, {1941, -385, 283}, {1950, 301, -320}, {1960, 110, -114},
+    {1970, -127, -305}, {1979, 446, 89}, {1991, -95, 98}, {1998, -45, 252}
+};
+
+// Bump of the nightstand
+static const shakeSample bump_trace[] = {
+    {4, 237, -402}, {13, 483, -199}, {24, -7, 148}, {32, -248, 193}, {42, 110, 493}, {50, 148, -293},
+    {60, -75, 188}, {70, -4, -235}, {79, 267, 68}, {91, 164, 309}, {102, 99, 165}, {111, -210, 304},
+    {120, 127, 221}, {130, 279, 176}, {140, 453, 164}, {152, 267, -273}, {164, 32, -270}, {174, -73, -221},
+    {185, 471, 124}, {198, -213, -389}, {207, 446, 387}, {219, -16, -56}, {230, -226, -143}, {242, -434, 23},
+    {251, -87, -100}, {264, 293, 63}, {273, 438, -193}, {285, 74, 104}, {293, -246, -481}, {303, -68, 43},
+    {313, 83, -427}, {323, 180, 390}, {330, -474, 440}, {342, 213, 7}, {355, -308, 166}, {366, 32, -108},
+    {376, 219, -59}, {387, 468, -250}, {396, 189, 37}, {404, -294, -75}, {416, 218, 265}, {424, -448, -62},
+    {434, -221, -170}, {443, -412, -314}, {456, -1, 274}, {468, 110, 67}, {480, 8, -98}, {493, -473, -418},
+    {506, -13773, -170}, {517, 14470, 164}, {527, -8797, -407}, {538, -5862, 308}, {545, -474, -62}, {555, -4784, 238},
+    {567, 7639, 234}, {577, -3308, -323}, {586, 1409, -361}, {594, -2320, 483}, {605, -2476, -75}, {615, 4194, 192},
+    {625, -4126, -352}, {632, 3291, 236}, {643, -2859, 30}, {654, -430, 383}, {665, 2155, -256}, {677, -976, -325},
+    {687, -159, 466}, {697, 621, -120}, {704, -314, -85}, {713, 474, 271}, {723, -959, -296}, {733, 1172, 236},
+    {740, -1430, 242}, {749, 556, 1}, {760, -1013, -467}, {769, 829, -480}, {777, -659, -451}, {784, 535, 288},
+    {792, -893, -411}, {801, 773, -371}, {808, -842, -220}, {817, 797, -287}, {825, -224, -392}, {836, 86, 373},
+    {847, 91, 154}, {857, -214, 463}, {869, -352, 445}, {879, 429, 310}, {887, 204, 48}, {896, 160, -458},
+    {905, -193, -153}, {916, 332, 311}, {924, -146, -362}, {932, -184, -288}, {944, -42, -45}, {952, -196, -103},
+    {960, -52, 286}, {972, 103, 205}, {981, 414, -419}, {991, -215, 311}, {1000, -17, -305}, {1010, -25, 178},
+    {1021, -352, 217}, {1034, 453, 356}, {1044, 54, -219}, {1051, -291, -93}, {1063, 46, -192}, {1071, 121, -37},
+    {1083, -57, 324}, {1095, -321, -255}, {1104, 297, 257}, {1112, 184, -478}, {1122, -86, 361}, {1131, 464, -170},
+    {1143, -351, -298}, {1151, 472, -37}, {1160, 412, 319}, {1169, 354, -472}, {1177, 320, -479}, {1187, 77, -418},
+    {1198, -249, -89}, {1206, 22, -355}, {1214, -136, 106}, {1221, -255, -382}, {1232, -94, -229}, {1242, -258, 376},
+    {1253, 240, 375}, {1262, -32, -415}, {1275, -23, -147}, {1287, 397, 8}, {1300, -332, 37}, {1311, -97, 345},
+    {1320, 376, -435}, {1327, 260, 375}, {1337, 171, -389}, {1350, 7, -58}, {1361, -228, -338}, {1373, -492, 58},
+    {1381, -69, 184}, {1392, 427, 171}, {1399, -198, -114}, {1410, 482, 343}, {1417, 344, -61}, {1425, 144, -81},
+    {1433, -473, 356}, {1445, -291, -80}, {1458, -128, 405}, {1468, -142, 230}, {1477, -369, -285}, {1489, -340, 334},
+    {1501, -401, 491}, {1511, -371, 144}, {1518, 373, 5}, {1526, 272, 198}, {1535, -427, 233}, {1546, 273, 267},
+    {1556, 298, 328}, {1568, 213, 136}, {1575, -119, 324}, {1587, -499, 105}, {1597, -321, 221}, {1605, -104, 488},
+    {1615, 473, 371}, {1622, -195, 136}, {1634, -273, -196}, {1644, 239, -230}, {1652, -251, -84}, {1663, 102, -352},
+    {1672, -457, -333}, {1684, 195, -134}, {1696, -126, 195}, {1708, 127, 301}, {1720, -179, -488}, {1733, 3, -8},
+    {1743, -132, -337}, {1752, -429, 475}, {1761, 298, -454}, {1770, 212, 390}, {1780, 429, 251}, {1792, -34, 334},
+    {1803, -32, -380}, {1814, 443, -207}, {1823, -485, 387}, {1831, 338, -343}, {1839, 16, 115}, {1847, -92, -390},
+    {1860, -337, -239}, {1870, -410, 417}, {1883, -457, -407}, {1893, -331, -102}, {1905, 75, -167}, {1917, -361, 113},
+    {1926, 0, 175}, {1938, -336, 52}, {1947, 447, 112}, {1956, 314, -157}, {1964, 402, -305}, {1973, 461, 266},
+    {1982, -456, 162}, {1994, -2, 129}
+};
+
+// Two bumps 1.7 s apart
+static const shakeSample two_bumps_trace[] = {
+    {7, -424, 450}, {16, -267, -244}, {23, 370, 264}, {33, -490, -249}, {46, 483, 330}, {54, -406, 335},
+    {64, 462, 54}, {73, -150, -83}, {84, -290, 155}, {94, -350, -367}, {104, -230, -232}, {111, 429, -378},
+    {120, 315, -249}, {131, -193, 164}, {143, 242, -497}, {156, -226, -362}, {163, 20, 292}, {173, 284, -100},
+    {182, 217, -94}, {195, 222, -455}, {205, -156, 133}, {213, -432, 157}, {223, -68, 371}, {231, 265, 495},
+    {240, 495, 385}, {248, 106, 240}, {259, -209, -2}, {271, -382, -268}, {280, -482, 245}, {292, -226, -166},
+    {301, 382, 285}, {310, 45, -150}, {320, 171, 72}, {332, 66, 136}, {339, 241, -403}, {348, -48, -183},
+    {358, 83, 216}, {370, 57, -239}, {379, 368, 352}, {389, -305, -267}, {399, -369, -403}, {409, 100, 364},
+    {421, 491, -9}, {433, -326, 353}, {441, 85, 30}, {449, 282, 51}, {458, 85, -335}, {470, 152, 347},
+    {480, -497, 311}, {493, -371, -499}, {500, 13233, -299}, {509, -11673, 319}, {520, 2242, 36}, {528, -2787, -133},
+    {536, 1606, -202}, {545, 416, -429}, {556, -4410, 182}, {567, 4407, 415}, {574, -4052, -16}, {586, 1064, -385},
+    {598, 1817, 437}, {607, -1868, -85}, {619, 530, 313}, {631, 1205, 447}, {643, -848, 279}, {651, 1086, -222},
+    {659, -564, 329}, {671, -536, -441}, {680, -5, -199}, {692, -278, -50}, {701, 856, 257}, {713, -145, -301},
+    {721, -37, 287}, {729, 156, -447}, {737, -45, -35}, {749, 439, 394}, {758, 21, -451}, {768, 255, 272},
+    {776, -170, -340}, {787, 435, 215}, {798, 424, -4}, {811, 11, -497}, {819, 73, 348}, {830, 449, -212},
+    {842, 390, 466}, {854, 252, 231}, {861, 15, 34}, {874, -398, -439}, {883, 381, -193}, {892, 289, -313},
+    {902, 100, -326}, {913, 10, 322}, {926, 75, 195}, {935, 446, -278}, {944, -135, -121}, {956, -202, 467},
+    {968, -448, 228}, {980, -239, -39}, {992, 193, 369}, {999, 166, 8}, {1012, 291, -259}, {1021, 191, -314},
+    {1030, -375, 176}, {1038, 428, 345}, {1049, -131, 383}, {1061, 206, 477}, {1072, -328, -402}, {1083, 231, -223},
+    {1091, -32, -38}, {1101, 249, -389}, {1109, -135, -104}, {1122, 319, -228}, {1131, 322, 499}, {1141, -49, 186},
+    {1150, 482, -244}, {1163, 138, -21}, {1173, 331, 79}, {1183, 86, 32}, {1190, 83, 486}, {1199, 151, -4},
+    {1207, 463, 414}, {1217, 270, 335}, {1228, -231, -25}, {1239, -74, -113}, {1252, 392, 176}, {1264, 414, 35},
+    {1274, 195, 386}, {1285, -43, 441}, {1296, -110, 76}, {1305, -71, -33}, {1317, 344, -378}, {1326, 245, 198},
+    {1338, 461, -308}, {1348, -323, -252}, {1359, 35, -484}, {1372, -371, 203}, {1384, -254, 42}, {1392, -324, 420},
+    {1403, 193, -205}, {1411, -143, -469}, {1419, -355, -76}, {1430, -449, -155}, {1441, -136, -222}, {1452, 420, -453},
+    {1463, 222, -20}, {1473, -258, -165}, {1482, -26, -171}, {1494, 130, -76}, {1502, 343, -467}, {1514, 450, 51},
+    {1523, -142, -437}, {1534, 443, 408}, {1542, 59, 162}, {1550, 346, -357}, {1559, -486, -206}, {1571, -456, 338},
+    {1580, -242, 35}, {1589, 21, -363}, {1600, -378, 243}, {1612, 168, -99}, {1624, 43, -21}, {1636, 191, 76},
+    {1648, 312, -8}, {1661, 186, 157}, {1669, 385, 310}, {1679, -353, -82}, {1688, -321, -320}, {1695, -73, -195},
+    {1706, -494, 419}, {1718, -38, -336}, {1726, 43, 461}, {1739, 256, -312}, {1751, -481, 93}, {1760, -59, -242},
+    {1772, -24, -288}, {1780, 407, 72}, {1790, -175, -407}, {1797, -172, -272}, {1807, 51, 473}, {1815, -440, -345},
+    {1823, -251, 481}, {1832, 253, 68}, {1840, 378, -333}, {1849, 161, 330}, {1857, -71, 208}, {1865, -55, -109},
+    {1873, -148, 35}, {1882, 13, -291}, {1892, 461, 429}, {1900, 170, 306}, {1908, 177, -143}, {1918, 95, 376},
+    {1927, -210, 90}, {1937, -48, -427}, {1947, -367, 387}, {1956, 143, -81}, {1967, 342, 252}, {1979, 9, -22},
+    {1989, -415, 75}, {2000, -21, -320}, {2013, -72, -328}, {2026, 471, 486}, {2036, -246, -494}, {2048, -415, 278},
+    {2058, -128, 125}, {2067, 324, 130}, {2077, 232, 104}, {2090, -62, -119}, {2100, -90, 493}, {2109, -386, 146},
+    {2119, 247, -402}, {2132, -417, 203}, {2143, -172, -417}, {2154, 402, -134}, {2164, -323, 206}, {2175, -39, 291},
+    {2183, -149, -293}, {2195, 469, 360}, {2205, -6466, -392}, {2212, 2139, 28}, {2225, -9386, 14}, {2237, -1242, -172},
+    {2249, 5980, -368}, {2261, -1218, 399}, {2270, 837, -429}, {2279, -270, -265}, {2289, -2034, -284}, {2297, 2137, -487},
+    {2307, -2647, 175}, {2316, 1673, -292}, {2326, -1700, 110}, {2338, -227, 359}, {2350, 943, -44}, {2360, -906, 172},
+    {2370, 45, -167}, {2382, 646, 335}, {2391, -587, -322}, {2399, 105, -255}, {2407, -753, 362}, {2420, -283, -498},
+    {2427, 90, -159}, {2435, -326, 372}, {2444, -34, 105}, {2455, 245, -399}, {2464, -13, 491}, {2471, -251, 224},
+    {2483, -94, -411}, {2495, 478, -175}, {2502, -350, -186}, {2514, 380, 332}, {2524, 375, 416}, {2534, 173, 329},
+    {2546, 24, 447}, {2555, -299, -20}, {2562, -199, -25}, {2570, -278, -498}, {2579, 190, -427}, {2588, -417, -155},
+    {2597, 468, -119}, {2609, -286, -29}, {2616, 496, -264}, {2625, -475, -110}, {2633, 317, 190}, {2641, -41, 377},
+    {2653, -111, 425}, {2665, -203, 0}, {2675, -125, 348}, {2686, -343, -110}, {2693, 138, 405}, {2701, -299, 380},
+    {2713, 309, -108}, {2725, 248, 466}, {2736, -344, -212}, {2747, -84, -312}, {2756, 116, -96}, {2765, 34, -123},
+    {2774, 134, -134}, {2783, 361, -74}, {2790, -267, 217}, {2803, 429, 459}, {2815, -20, -314}, {2824, -73, 88},
+    {2834, -252, 366}, {2845, 91, -356}, {2857, 415, 383}, {2867, -77, -455}, {2879, -64, 291}, {2891, -275, 213},
+    {2902, 395, 254}, {2912, 280, 184}, {2924, 19, -210}, {2934, -332, 323}, {2946, 229, -412}, {2954, -486, 305},
+    {2962, 188, -279}, {2973, 217, 262}, {2980, -15, 239}, {2991, 412, 254}, {3002, 357, -40}, {3014, -290, -28},
+    {3027, -380, -35}, {3039, -499, -179}, {3051, 188, 98}, {3061, 346, 308}, {3070, -122, 493}, {3082, 240, 372},
+    {3091, -145, -100}, {3101, -225, 64}, {3111, -73, 359}, {3123, -16, -249}, {3132, -446, -499}, {3143, 412, -272},
+    {3151, -250, 480}, {3161, -328, -90}, {3170, -223, 365}, {3178, -471, 1}, {3191, 286, 479}, {3201, 296, 304},
+    {3210, 322, -11}, {3219, 72, 67}, {3231, 323, -227}, {3243, 94, 34}, {3254, 61, 348}, {3267, 248, -397},
+    {3276, 135, 388}, {3287, -491, -265}, {3296, 456, 108}, {3308, -154, -453}, {3317, -128, -447}, {3324, -117, 213},
+    {3332, -179, -427}, {3342, 318, -387}, {3352, -297, 11}, {3359, -77, -155}, {3366, 339, 388}, {3377, -390, -443},
+    {3389, -292, 112}, {3401, -106, -292}, {3413, -165, -1}, {3420, -266, 193}, {3433, -483, -368}, {3441, -423, 480},
+    {3454, 276, -155}, {3467, 101, 160}, {3474, -302, 352}, {3483, -30, 76}, {3493, 56, 319}, {3500, -401, 433},
+    {3507, -98, 392}, {3517, -257, 38}, {3529, -5, 473}, {3539, 415, -406}, {3547, -248, 282}, {3556, 437, -323},
+    {3566, 112, 463}, {3576, -374, -159}, {3587, 480, -204}, {3596, 426, -39}, {3607, 142, -240}, {3618, -490, -238},
+    {3631, 326, -477}, {3644, -391, 159}, {3656, -200, 94}, {3664, -362, -156}, {3677, -329, 203}, {3690, -130, 234},
+    {3702, -208, 169}, {3710, -302, -256}, {3719, -72, -198}, {3730, 278, -23}, {3741, -411, 107}, {3752, 67, 296},
+    {3760, 187, 336}, {3772, 46, -103}, {3779, -65, -345}, {3788, 153, 289}, {3798, -394, 458}, {3810, 225, -127},
+    {3820, 117, 134}, {3832, 456, -27}, {3841, -456, -223}, {3853, 166, -470}, {3863, -15, 151}, {3876, 411, 323},
+    {3885, 458, -59}, {3893, -284, 391}, {3905, -297, 42}, {3914, -44, 66}, {3925, -452, 463}, {3935, 174, -237},
+    {3946, 279, 80}, {3957, -135, 437}, {3966, 132, 304}, {3977, -3, 374}, {3988, -173, 429}, {3999, -175, -302}
+};
+
+// 4 s shake along X at 4 Hz
+static const shakeSample shake_x_trace[] = {
+    {3, 195, -209}, {14, -227, -201}, {22, -154, 1}, {33, 399, 295}, {45, -282, -359}, {54, 457, -120},
+    {62, 131, -139}, {71, 404, -150}, {83, 131, -49}, {94, -219, 155}, {102, 337, 380}, {113, -353, -176},
+    {125, -44, 461}, {134, -423, -29}, {147, -282, -242}, {158, -351, -306}, {171, 290, 172}, {184, -441, -139},
+    {196, 428, 360}, {204, -211, -422}, {216, -97, -138}, {228, 460, -115}, {240, -10, 128}, {252, 313, -66},
+    {260, 48, 347}, {268, -76, -296}, {277, 477, -296}, {285, 106, 17}, {295, 54, -493}, {308, 138, 405},
+    {320, 485, 324}, {331, 203, 83}, {343, -355, 37}, {353, 237, 86}, {361, -174, 467}, {371, 55, 337},
+    {379, 15, -19}, {388, 434, 176}, {395, -22, 238}, {408, -452, -359}, {418, -327, -21}, {429, -86, -481},
+    {440, 299, -490}, {450, -238, -35}, {462, -1, 294}, {474, 470, 199}, {482, -27, -187}, {493, 493, -410},
+    {503, 751, -423}, {511, 3272, 120}, {521, 5899, -19}, {531, 8048, 61}, {540, 10536, 376}, {548, 11451, 335},
+    {556, 12073, -463}, {567, 11532, -104}, {576, 11431, 410}, {585, 10256, 121}, {595, 8400, -167}, {607, 5436, 26},
+    {616, 2349, -420}, {629, -1537, -192}, {640, -4281, -54}, {652, -7289, 12}, {660, -9203, -268}, {670, -10494, 358},
+    {682, -12373, 311}, {694, -11553, -10}, {703, -11221, 177}, {712, -9510, -304}, {721, -8348, 121}, {730, -5839, 375},
+    {743, -2282, -39}, {752, 783, -219}, {761, 3310, 460}, {771, 6366, 317}, {781, 8178, -133}, {789, 9946, 439},
+    {801, 11370, 195}, {813, 11532, -95}, {826, 11613, 192}, {838, 9877, -56}, {849, 7569, -380}, {858, 4805, 110},
+    {869, 2100, 263}, {880, -1889, 337}, {890, -5005, -158}, {902, -7558, -495}, {911, -9914, -306}, {924, -10889, -484},
+    {932, -11777, -73}, {940, -12423, -298}, {952, -11015, 408}, {964, -8965, 49}, {971, -7564, -215}, {982, -4920, -435},
+    {992, -2791, 402}, {1002, 811, -228}, {1013, 4416, -185}, {1026, 7873, 160}, {1038, 10232, 262}, {1049, 11399, 93},
+    {1059, 11732, 293}, {1071, 11770, 458}, {1083, 10028, 427}, {1092, 8879, 96}, {1099, 6908, -484}, {1110, 4808, -209},
+    {1122, 1023, 208}, {1132, -2306, 347}, {1141, -4677, -314}, {1150, -7439, 44}, {1160, -9233, -448}, {1169, -11097, 485},
+    {1177, -11731, -442}, {1188, -12092, -371}, {1196, -11522, -446}, {1208, -10801, -453}, {1218, -8379, -175}, {1228, -5730, 165},
+    {1236, -4187, -272}, {1243, -1498, 42}, {1253, 1237, 264}, {1265, 4917, -52}, {1278, 7517, 22}, {1290, 9684, -212},
+    {1300, 11477, -378}, {1312, 11954, 145}, {1320, 12063, -418}, {1331, 10676, 480}, {1339, 8977, 257}, {1352, 6824, -245},
+    {1363, 3168, 265}, {1375, -151, 27}, {1383, -2995, -465}, {1392, -5561, 298}, {1399, -6707, -89}, {1411, -9915, -377},
+    {1423, -11343, -43}, {1432, -11934, 287}, {1441, -11960, 352}, {1452, -11057, -420}, {1460, -10133, 65}, {1471, -7586, 417},
+    {1481, -5717, 184}, {1489, -3527, -98}, {1497, -962, 76}, {1508, 2250, -475}, {1516, 4624, 277}, {1528, 7704, -381},
+    {1540, 9759, 268}, {1552, 11745, 284}, {1559, 11664, 43}, {1570, 11548, -142}, {1579, 10927, 128}, {1588, 9797, -327},
+    {1597, 7530, 453}, {1607, 5305, -322}, {1619, 1675, 239}, {1630, -1397, 162}, {1639, -4254, -199}, {1651, -7487, -357},
+    {1659, -9235, -77}, {1671, -10671, -322}, {1682, -11729, 218}, {1690, -12053, 151}, {1701, -11600, -374}, {1709, -10149, 299},
+    {1717, -8392, -58}, {1727, -6912, -483}, {1738, -3255, 64}, {1747, -204, -283}, {1757, 2051, 329}, {1765, 4137, -208},
+    {1773, 6535, 116}, {1783, 9038, 429}, {1791, 10072, -377}, {1801, 11634, 348}, {1813, 12021, 456}, {1822, 11380, -297},
+    {1834, 10012, 466}, {1842, 8641, 208}, {1854, 5806, -47}, {1862, 3509, 269}, {1872, 587, 172}, {1881, -1396, 118},
+    {1892, -5402, -200}, {1904, -8151, -217}, {1914, -10312, -266}, {1924, -11342, 376}, {1933, -11638, 418}, {1942, -12276, 20},
+    {1951, -11527, -408}, {1963, -9647, 413}, {1973, -6845, 89}, {1980, -5593, -162}, {1990, -3011, 152}, {1998, -876, 123},
+    {2009, 3089, 347}, {2019, 5578, -131}, {2028, 7356, 51}, {2038, 9500, -66}, {2050, 10949, 120}, {2059, 12264, -16},
+    {2071, 11552, 169}, {2081, 10256, -360}, {2092, 8881, -381}, {2100, 7325, 485}, {2112, 3494, 397}, {2120, 1119, -17},
+    {2133, -1984, -18}, {2141, -5105, 70}, {2150, -7449, 153}, {2160, -9325, -24}, {2168, -10447, -341}, {2178, -11734, -475},
+    {2187, -12415, -354}, {2196, -11550, -19}, {2209, -10080, -439}, {2218, -8919, 182}, {2229, -6332, -107}, {2241, -2539, -461},
+    {2251, 96, -59}, {2258, 2248, 126}, {2268, 5129, 483}, {2279, 8351, -49}, {2289, 9843, 41}, {2298, 11005, 139},
+    {2311, 11580, 98}, {2323, 11955, -401}, {2335, 10158, 483}, {2345, 8093, 412}, {2356, 5724, -228}, {2367, 2039, 29},
+    {2374, -204, 404}, {2386, -3422, -6}, {2397, -6064, -94}, {2405, -8682, -219}, {2412, -9269, 354}, {2425, -11570, -7},
+    {2437, -12388, 40}, {2444, -11368, -39}, {2454, -10591, -70}, {2462, -9452, -466}, {2472, -7423, 367}, {2484, -4097, -426},
+    {2492, -2310, 168}, {2499, 215, 458}, {2508, 2595, -5}, {2517, 4799, -400}, {2529, 7583, -309}, {2541, 10568, -219},
+    {2551, 11056, -37}, {2559, 11456, -177}, {2566, 12123, -414}, {2577, 10784, -114}, {2585, 9728, 9}, {2592, 8774, 408},
+    {2600, 7208, 57}, {2609, 4844, 490}, {2621, 976, 89}, {2629, -1714, 233}, {2639, -4116, -187}, {2647, -6225, 337},
+    {2659, -8592, -367}, {2670, -10497, -38}, {2680, -11862, 200}, {2692, -11481, -345}, {2701, -11526, -432}, {2709, -10481, -128},
+    {2716, -9116, 104}, {2729, -6107, 356}, {2739, -3471, 82}, {2746, -1208, 438}, {2758, 2439, -415}, {2768, 5024, -1},
+    {2780, 8573, 141}, {2792, 9995, -339}, {2802, 11182, 263}, {2809, 11732, 475}, {2819, 11327, -248}, {2828, 10911, 132},
+    {2837, 9784, 471}, {2850, 6894, 480}, {2860, 3863, -24}, {2872, 499, -116}, {2881, -2435, 135}, {2893, -5896, -293},
+    {2903, -7383, -299}, {2910, -9254, -55}, {2919, -10484, 420}, {2931, -11754, -204}, {2943, -11939, 154}, {2952, -11382, -315},
+    {2959, -10098, 117}, {2972, -8024, 48}, {2983, -5286, 166}, {2995, -1721, -115}, {3003, 991, -212}, {3014, 3898, -128},
+    {3026, 7105, 188}, {3035, 9568, -433}, {3043, 10641, -349}, {3052, 11663, -15}, {3063, 11976, 55}, {3071, 11642, -427},
+    {3082, 10453, 225}, {3090, 8946, 370}, {3098, 7361, -493}, {3110, 4623, -109}, {3121, 603, -276}, {3132, -2516, -17},
+    {3140, -4710, 445}, {3148, -6340, -263}, {3160, -8808, 184}, {3169, -10271, 190}, {3181, -11673, -39}, {3189, -11838, 377},
+    {3196, -11748, 372}, {3205, -10543, -7}, {3216, -9476, 87}, {3227, -6424, -284}, {3234, -4223, 410}, {3243, -2427, -37},
+    {3255, 1487, 325}, {3266, 4622, -391}, {3275, 7311, 178}, {3286, 9150, -47}, {3298, 11658, -95}, {3310, 12187, -43},
+    {3318, 11395, 447}, {3331, 10303, -448}, {3343, 8346, -202}, {3350, 7450, -476}, {3362, 3845, -226}, {3370, 1247, 281},
+    {3378, -1300, 489}, {3386, -3092, -481}, {3394, -6207, 135}, {3405, -8556, -442}, {3416, -10700, 492}, {3424, -11856, -78},
+    {3433, -11802, 331}, {3444, -12068, 385}, {3456, -10959, -390}, {3468, -8493, -434}, {3480, -5592, 111}, {3491, -2361, -183},
+    {3498, -253, -48}, {3509, 2660, -38}, {3520, 5963, 76}, {3529, 8103, 152}, {3537, 9359, -298}, {3548, 11051, -124},
+    {3558, 11574, 310}, {3568, 11422, -103}, {3579, 11280, -365}, {3589, 9691, -338}, {3601, 6687, -221}, {3612, 3484, 456},
+    {3622, 1317, 377}, {3631, -2258, 333}, {3642, -5417, 462}, {3652, -8059, -400}, {3660, -9481, 426}, {3670, -11146, 398},
+    {3681, -11917, 254}, {3692, -11805, -344}, {3700, -11241, -83}, {3713, -9771, 432}, {3723, -7299, -404}, {3733, -4446, 465},
+    {3744, -1350, 131}, {3753, 1215, 409}, {3765, 4498, -132}, {3776, 7643, 91}, {3786, 9218, -226}, {3794, 10582, -221},
+    {3807, 11926, -466}, {3816, 11879, 264}, {3823, 11462, -22}, {3834, 10478, 291}, {3845, 7863, 29}, {3853, 6066, -409},
+    {3862, 4254, 74}, {3873, 409, -416}, {3885, -3493, 400}, {3898, -6373, -496}, {3906, -8299, 112}, {3914, -9851, 498},
+    {3922, -11410, -303}, {3929, -11354, -34}, {3941, -12410, 116}, {3953, -10867, 170}, {3961, -9411, 112}, {3974, -7227, -76},
+    {3985, -4052, 107}, {3993, -1704, -152}, {4002, 1074, -125}, {4015, 4300, -489}, {4026, 7768, -132}, {4036, 9807, 471},
+    {4046, 11403, -114}, {4058, 12006, 0}, {4065, 12033, 455}, {4077, 11460, 10}, {4088, 9486, 113}, {4099, 7509, -494},
+    {4109, 4151, 470}, {4117, 2316, -470}, {4129, -1207, -267}, {4138, -4151, 440}, {4148, -6246, 70}, {4159, -9571, 22},
+    {4170, -10723, 12}, {4182, -12293, -285}, {4190, -12434, -262}, {4198, -11883, -6}, {4210, -9980, -38}, {4220, -7784, -309},
+    {4232, -4763, -210}, {4242, -2001, -222}, {4252, 875, -284}, {4260, 3444, -113}, {4267, 5310, -346}, {4278, 8167, -375},
+    {4286, 10103, -321}, {4294, 10409, 428}, {4301, 11576, -128}, {4311, 12408, -474}, {4318, 12300, 415}, {4327, 11289, 254},
+    {4336, 10167, -125}, {4348, 7802, -207}, {4356, 5881, 287}, {4368, 2519, 66}, {4379, -1201, 494}, {4391, -5297, 380},
+    {4402, -7428, -149}, {4413, -10257, 35}, {4421, -11293, 230}, {4433, -11863, -24}, {4442, -11500, -12}, {4452, -11290, 251},
+    {4460, -10002, 262}, {4473, -7456, -186}, {4481, -5309, -193}, {4491, -2219, -69}, {4499, -556, 220}, {4511, 253, 262},
+    {4521, -75, 275}, {4532, 379, 364}, {4543, -200, -301}, {4554, 134, 153}, {4564, 127, -384}, {4576, -102, -373},
+    {4587, 165, -481}, {4595, -255, -148}, {4606, 43, 443}, {4614, 2, 21}, {4622, 397, -251}, {4634, 373, 91},
+    {4645, -60, -342}, {4656, 46, 293}, {4664, 487, 467}, {4675, -61, -450}, {4686, -258, 83}, {4695, -15, -427},
+    {4704, -157, 280}, {4716, 124, 176}, {4724, 481, -140}, {4731, 393, 85}, {4743, 108, -415}, {4754, 276, 272},
+    {4762, -496, -418}, {4774, 233, -397}, {4781, -246, -415}, {4794, 40, 317}, {4805, 415, 192}, {4815, 368, -356},
+    {4825, 390, 56}, {4835, -250, -452}, {4842, -205, -377}, {4850, -172, 430}, {4860, -140, -130}, {4867, -429, 282},
+    {4879, -361, 178}, {4888, -175, -410}, {4901, 54, 244}, {4913, 391, 8}, {4923, -431, -312}, {4932, -482, -391},
+    {4943, 499, -228}, {4954, 461, 199}, {4964, -217, 383}, {4974, -466, 32}, {4983, -318, 179}, {4996, -215, -99},
+    {5009, -240, -446}, {5016, 226, 424}, {5028, 121, -155}, {5037, 257, 54}, {5048, -287, -78}, {5060, -306, 63},
+    {5071, 210, 64}, {5084, -440, -422}, {5095, -211, -204}, {5105, -453, 401}, {5116, -218, 66}, {5124, -202, 193},
+    {5136, 28, -46}, {5147, 421, 260}, {5158, 441, -223}, {5171, -107, 3}, {5180, 61, 285}, {5191, 245, -205},
+    {5203, -353, 334}, {5216, -279, -177}, {5224, -434, 186}, {5237, 255, 184}, {5250, -467, 361}, {5261, 5, 250},
+    {5274, 466, -308}, {5286, -238, 95}, {5296, 492, -28}, {5305, -41, -493}, {5313, -108, 374}, {5324, -340, -120},
+    {5334, -496, -460}, {5345, -330, 1}, {5353, -123, -20}, {5363, -297, -471}, {5375, 204, 218}, {5386, 244, -330},
+    {5397, -188, -180}, {5405, -485, 375}, {5413, -270, 201}, {5423, -299, 46}, {5431, -349, -89}, {5439, 352, -447},
+    {5452, 277, -259}, {5459, -395, 95}, {5471, -138, -130}, {5481, -373, 188}, {5492, 448, -89}, {5501, 463, -212},
+    {5512, 130, -454}, {5523, 164, 363}, {5534, 315, 124}, {5541, -135, 428}, {5552, -186, 418}, {5564, 223, -184},
+    {5572, 256, 401}, {5579, 368, -264}, {5590, 142, -261}, {5602, 262, 388}, {5610, -468, 378}, {5620, 146, -331},
+    {5627, 175, 410}, {5637, 453, 239}, {5648, -389, 80}, {5659, 372, 8}, {5667, 499, -357}, {5677, -54, -210},
+    {5685, 248, 432}, {5694, 366, -320}, {5705, -313, 332}, {5715, -113, 427}, {5724, 322, -473}, {5732, 481, -164},
+    {5743, 494, 208}, {5751, 182, -35}, {5762, 399, -361}, {5773, -257, -318}, {5784, -178, -279}, {5791, 17, -167},
+    {5804, 69, -9}, {5813, 244, 56}, {5825, 408, -317}, {5833, 114, 43}, {5844, 23, 270}, {5854, 285, -243},
+    {5861, 290, -342}, {5874, -241, -110}, {5886, -116, -105}, {5895, 261, -382}, {5902, 5, 107}, {5912, -445, 394},
+    {5924, -225, 24}, {5931, 304, 342}, {5944, -461, 273}, {5956, -52, -480}, {5965, -341, 333}, {5977, -323, 77},
+    {5985, 33, -176}, {5995, 486, 115}
+};
+
+// 4 s shake along Y at 5 Hz
+static const shakeSample shake_y_trace[] = {
+    {9, -481, 21}, {18, -259, 42}, {29, 242, 87}, {39, -374, -44}, {46, -428, 364}, {55, 100, -72},
+    {63, -30, -262}, {70, -458, 71}, {82, -208, 435}, {95, -392, -51}, {104, 290, -100}, {112, -400, 116},
+    {121, -451, -289}, {132, -35, 282}, {143, -21, 103}, {151, -258, 224}, {161, -195, 355}, {172, 463, 369},
+    {182, -315, 74}, {191, -186, -294}, {201, 373, 173}, {214, 54, 421}, {227, 80, 58}, {238, 18, 431},
+    {250, -58, 311}, {259, 183, -304}, {268, -255, -96}, {279, 124, -15}, {291, -171, -287}, {303, 364, -493},
+    {312, -195, -114}, {321, 411, -459}, {330, -492, 317}, {341, -492, -9}, {354, 331, 287}, {366, 376, -486},
+    {378, -132, 21}, {389, -1, -374}, {397, 475, -272}, {407, 190, -53}, {418, 229, 372}, {429, -471, 489},
+    {438, 358, 237}, {450, -104, -351}, {459, 114, 29}, {466, -329, 285}, {478, -285, 88}, {489, 362, 90},
+    {500, -243, 167}, {511, 204, 3206}, {518, 281, 5324}, {526, -7, 6693}, {539, 368, 8891}, {547, 202, 8897},
+    {557, -60, 9091}, {565, 168, 7968}, {578, 159, 5269}, {586, -150, 3722}, {596, -395, 1323}, {607, 462, -2029},
+    {618, 98, -5029}, {630, 26, -6946}, {643, -133, -8615}, {650, -416, -9401}, {658, 430, -8578}, {670, -362, -7485},
+    {681, 380, -5317}, {688, 86, -3392}, {699, -55, -605}, {712, -314, 3824}, {722, 7, 5970}, {732, -182, 7322},
+    {743, -14, 8312}, {753, 102, 9191}, {760, -293, 8256}, {767, 126, 7863}, {778, 220, 5336}, {786, 328, 3875},
+    {794, 171, 1952}, {807, -186, -2448}, {816, 158, -4282}, {826, -362, -6428}, {837, 227, -7860}, {848, -166, -9338},
+    {856, 411, -8368}, {866, 216, -7814}, {874, -34, -5996}, {887, -249, -3744}, {899, -289, -492}, {911, -4, 2867},
+    {922, -364, 6107}, {932, -61, 7205}, {942, -326, 9014}, {952, 220, 9215}, {963, 290, 7718}, {974, -460, 6493},
+    {985, 319, 3573}, {994, -212, 935}, {1005, 170, -1942}, {1012, 160, -3620}, {1019, 335, -5407}, {1027, 316, -6468},
+    {1036, -152, -8405}, {1048, 329, -9243}, {1060, 88, -8313}, {1071, -15, -7307}, {1081, 115, -5351}, {1092, -300, -1998},
+    {1100, 397, 224}, {1111, 95, 3466}, {1119, -367, 5758}, {1129, 0, 7452}, {1141, 42, 8245}, {1153, 417, 9425},
+    {1161, 305, 8026}, {1172, -257, 6702}, {1179, 32, 5622}, {1187, 254, 3136}, {1200, 438, -227}, {1211, -330, -3065},
+    {1221, -374, -5493}, {1233, 277, -7512}, {1242, -381, -8463}, {1249, -40, -8616}, {1262, 84, -8051}, {1269, 100, -7242},
+    {1281, 357, -5218}, {1293, 184, -1994}, {1305, 205, 1140}, {1314, -387, 4096}, {1326, 481, 6654}, {1337, 6, 8406},
+    {1349, -429, 8784}, {1361, 49, 8878}, {1369, 275, 7488}, {1381, -367, 5189}, {1390, -427, 2610}, {1401, -169, -87},
+    {1413, 367, -3910}, {1422, 20, -6003}, {1434, 176, -7549}, {1442, 128, -8377}, {1453, 376, -8722}, {1462, -169, -8015},
+    {1470, 437, -6795}, {1482, 201, -4476}, {1491, 296, -2589}, {1501, 126, 290}, {1508, -235, 2055}, {1518, 471, 5323},
+    {1530, -358, 6989}, {1543, -168, 8381}, {1556, -64, 9056}, {1563, 352, 8630}, {1575, 335, 6263}, {1585, -68, 4026},
+    {1595, -135, 1416}, {1602, -175, -578}, {1610, 349, -2636}, {1621, 425, -5956}, {1634, 119, -7688}, {1642, -231, -8688},
+    {1652, 97, -8985}, {1664, 29, -8192}, {1676, 181, -5830}, {1688, 40, -3499}, {1697, -426, -679}, {1710, -368, 2662},
+    {1720, 466, 5450}, {1731, 298, 7574}, {1741, 243, 8331}, {1751, 495, 9309}, {1764, 89, 8123}, {1774, -417, 5940},
+    {1785, -314, 4070}, {1797, 208, 899}, {1806, 377, -1640}, {1818, -354, -4986}, {1826, -18, -6438}, {1834, 390, -8058},
+    {1846, 137, -8443}, {1853, 24, -8509}, {1862, -144, -8356}, {1870, 144, -6880}, {1881, -328, -5410}, {1894, -123, -1956},
+    {1904, -434, 1700}, {1917, 260, 4327}, {1929, -456, 7746}, {1938, -451, 8674}, {1949, -453, 8760}, {1958, 167, 9015},
+    {1965, 92, 7851}, {1973, -86, 6444}, {1981, -202, 4893}, {1988, -364, 3459}, {1996, -300, 1257}, {2009, 444, -2342},
+    {2019, 22, -5345}, {2031, 234, -7233}, {2040, -196, -8538}, {2048, 42, -9106}, {2059, -475, -8319}, {2066, -469, -7744},
+    {2075, -332, -6673}, {2086, -384, -4001}, {2098, -158, -449}, {2109, 40, 2463}, {2121, -108, 5686}, {2128, 405, 7345},
+    {2139, 141, 8683}, {2149, -58, 9375}, {2157, -317, 8612}, {2167, 69, 8058}, {2179, 360, 5227}, {2191, -485, 2841},
+    {2203, -133, -590}, {2214, -494, -4393}, {2227, 91, -7257}, {2234, 353, -8246}, {2247, -347, -8534}, {2259, 428, -8212},
+    {2271, 231, -6914}, {2283, 317, -5015}, {2292, 155, -1900}, {2302, -296, 646}, {2314, 363, 3881}, {2327, 232, 6733},
+    {2340, -344, 8359}, {2353, 419, 9087}, {2365, -95, 7518}, {2378, 347, 6136}, {2385, -386, 4157}, {2392, -279, 1625},
+    {2401, -8, -635}, {2408, -468, -2247}, {2417, 440, -4436}, {2426, 381, -6530}, {2436, 125, -7698}, {2443, 234, -9084},
+    {2452, 12, -9097}, {2464, 138, -8264}, {2475, -441, -6615}, {2486, 185, -4151}, {2497, -67, -1213}, {2508, -237, 2477},
+    {2520, 438, 5156}, {2531, -153, 7031}, {2539, -450, 8512}, {2551, -104, 8555}, {2561, -304, 8134}, {2570, -384, 7556},
+    {2578, -276, 5373}, {2591, -379, 2080}, {2601, -315, -586}, {2612, -218, -3405}, {2620, 341, -5237}, {2630, -207, -7497},
+    {2640, -423, -8594}, {2651, 225, -9241}, {2663, -419, -7749}, {2674, 120, -6255}, {2686, 499, -4126}, {2698, -124, -374},
+    {2710, -72, 3133}, {2722, -12, 5611}, {2730, 425, 6911}, {2740, -94, 8785}, {2747, -58, 8941}, {2755, 38, 8615},
+    {2767, -182, 7726}, {2776, -303, 6202}, {2785, -229, 3618}, {2795, 499, 1282}, {2807, 13, -2116}, {2818, -470, -5364},
+    {2831, 416, -7965}, {2841, 260, -9126}, {2852, 370, -8594}, {2864, 47, -8515}, {2873, -246, -6569}, {2882, -296, -4384},
+    {2892, 156, -1962}, {2902, 453, 782}, {2911, 287, 2689}, {2923, 280, 6321}, {2932, 186, 8101}, {2945, 466, 8726},
+    {2954, -320, 8524}, {2963, -160, 8410}, {2976, 218, 6478}, {2985, 21, 4156}, {2993, 7, 2170}, {3005, -296, -1935},
+    {3017, 89, -4949}, {3025, -274, -6703}, {3037, -221, -8399}, {3048, -498, -9208}, {3057, -390, -8345}, {3067, 59, -7560},
+    {3079, -298, -5075}, {3092, -258, -2657}, {3102, 200, 181}, {3113, 330, 4225}, {3121, 197, 5678}, {3128, 145, 7289},
+    {3138, 287, 8577}, {3149, 378, 9021}, {3160, -332, 8120}, {3172, -281, 6830}, {3183, 438, 4956}, {3191, 23, 2393},
+    {3200, -491, -281}, {3211, -413, -3133}, {3221, 257, -5703}, {3232, 273, -7965}, {3244, -124, -9246}, {3251, -433, -8867},
+    {3261, 19, -8643}, {3272, 277, -7384}, {3281, 202, -5279}, {3291, 498, -2699}, {3299, 69, 286}, {3311, 25, 2742},
+    {3324, 465, 6617}, {3332, 325, 8086}, {3341, -44, 8297}, {3350, -195, 8619}, {3358, 196, 8966}, {3365, -83, 8275},
+    {3374, 322, 6094}, {3387, 398, 3972}, {3397, 250, 1157}, {3408, -351, -2736}, {3420, -445, -5008}, {3428, 45, -7431},
+    {3438, 324, -8174}, {3446, -267, -8743}, {3455, 161, -8531}, {3465, 139, -8101}, {3475, 216, -6528}, {3482, 293, -4655},
+    {3491, -76, -2815}, {3500, -319, 272}, {3507, -153, 1871}, {3515, 198, 3750}, {3525, -221, 6418}, {3532, 482, 7580},
+    {3542, 18, 8523}, {3552, -367, 9117}, {3564, 465, 7591}, {3574, 122, 6359}, {3582, -58, 4789}, {3590, 427, 3000},
+    {3597, -88, 561}, {3606, -354, -1749}, {3616, 486, -4057}, {3627, 142, -7221}, {3638, 378, -8473}, {3650, 17, -8782},
+    {3663, 212, -7832}, {3670, -109, -7393}, {3681, 347, -5449}, {3693, 328, -1301}, {3705, 121, 1657}, {3717, -86, 4523},
+    {3726, 161, 6289}, {3739, -253, 8859}, {3751, 182, 8854}, {3763, -83, 8703}, {3771, 417, 6875}, {3779, 218, 4873},
+    {3787, -406, 3323}, {3795, 142, 1387}, {3804, 106, -802}, {3814, -74, -3615}, {3826, -201, -6452}, {3838, 197, -8036},
+    {3848, -498, -9167}, {3857, 486, -8849}, {3864, 248, -8000}, {3871, -364, -6465}, {3884, -196, -3957}, {3892, -94, -2436},
+    {3904, -73, 903}, {3915, 281, 4489}, {3925, -473, 6735}, {3936, 285, 8108}, {3948, -397, 9441}, {3959, 311, 8755},
+    {3968, -359, 7772}, {3977, 270, 6253}, {3986, -142, 3405}, {3994, 78, 1307}, {4005, 464, -1468}, {4016, 256, -4160},
+    {4023, -156, -5547}, {4032, -305, -7263}, {4042, 302, -9169}, {4052, 339, -9400}, {4061, -197, -8211}, {4070, 355, -6652},
+    {4078, -163, -5988}, {4085, 22, -3559}, {4094, 331, -1700}, {4101, 419, 718}, {4110, 268, 2548}, {4120, -335, 5815},
+    {4133, 395, 7452}, {4141, 239, 8692}, {4151, 208, 9419}, {4162, -309, 8147}, {4169, 96, 7561}, {4178, -267, 5783},
+    {4187, 316, 3115}, {4199, -464, 231}, {4210, 189, -2447}, {4219, -281, -5529}, {4228, -305, -7338}, {4235, 353, -8447},
+    {4244, 344, -8615}, {4254, -12, -8669}, {4264, 22, -7928}, {4273, 471, -6738}, {4284, 164, -4266}, {4294, 137, -1795},
+    {4304, 455, 837}, {4316, -411, 4655}, {4324, -50, 6360}, {4332, 146, 8083}, {4340, 257, 8615}, {4352, -268, 8891},
+    {4359, 216, 8226}, {4367, -296, 7467}, {4380, 198, 5224}, {4392, -43, 2686}, {4401, -39, -564}, {4410, 283, -2654},
+    {4420, -309, -5808}, {4431, -195, -7240}, {4441, -331, -8210}, {4451, -20, -9111}, {4458, -320, -8724}, {4467, -498, -7529},
+    {4475, 94, -5904}, {4488, 79, -3166}, {4496, 285, -670}, {4505, -84, 184}, {4518, -237, -493}, {4526, 392, 39},
+    {4536, 197, 71}, {4546, 255, 264}, {4558, 243, -202}, {4569, 327, -260}, {4581, -194, 468}, {4589, -474, -451},
+    {4602, 162, 12}, {4610, -276, 457}, {4618, 101, -9}, {4630, -268, -410}, {4641, -29, 147}, {4653, 426, -300},
+    {4663, 310, -443}, {4675, -172, 223}, {4683, 456, -369}, {4693, -382, -19}, {4703, 286, 33}, {4714, 427, 212},
+    {4722, 11, 281}, {4729, -111, 344}, {4742, -345, -442}, {4752, 249, -365}, {4762, -349, 14}, {4769, 75, -375},
+    {4778, -304, -382}, {4785, 326, 23}, {4793, -228, 285}, {4800, -167, 463}, {4808, -8, -120}, {4815, -45, 257},
+    {4826, -324, 303}, {4838, -39, 76}, {4845, -184, -231}, {4857, 397, 204}, {4870, -169, -22}, {4882, 487, -231},
+    {4893, 271, -208}, {4904, 339, 109}, {4913, -114, -377}, {4926, 493, 197}, {4935, 183, -378}, {4944, 90, -262},
+    {4953, 437, 411}, {4962, -308, 392}, {4970, -259, -79}, {4981, -464, 259}, {4992, -448, -421}, {5002, -245, -481},
+    {5015, -118, -78}, {5025, -158, -100}, {5035, 16, 373}, {5046, 392, 390}, {5053, 441, -246}, {5064, -92, 320},
+    {5073, 370, -236}, {5085, 183, -257}, {5094, 38, -478}, {5101, -428, -233}, {5110, -338, -112}, {5118, 147, 240},
+    {5129, -283, 136}, {5140, -442, -46}, {5152, -38, 255}, {5160, 79, 247}, {5172, 331, -113}, {5181, 185, -290},
+    {5189, -363, -292}, {5197, -376, 340}, {5206, -299, -225}, {5214, -181, 365}, {5227, 361, 113}, {5238, 102, -422},
+    {5246, 483, -411}, {5257, 71, -104}, {5269, -117, -173}, {5277, 96, -488}, {5285, -170, -266}, {5295, -239, -189},
+    {5307, -465, -115}, {5319, -230, -45}, {5332, -235, -190}, {5341, -395, -207}, {5354, -492, -32}, {5361, -49, 496},
+    {5369, 333, -62}, {5380, -314, 90}, {5392, -138, 97}, {5403, -41, -231}, {5413, 490, -159}, {5422, -358, -339},
+    {5434, 293, 91}, {5442, 181, 459}, {5454, -260, -330}, {5464, -368, 54}, {5477, -350, -233}, {5489, 405, 82},
+    {5500, -473, -417}, {5507, 25, 60}, {5515, 194, -108}, {5528, -107, 487}, {5537, 374, 73}, {5546, -129, 95},
+    {5553, -375, -108}, {5566, 207, 131}, {5575, -217, 47}, {5586, 82, 346}, {5598, -164, 296}, {5606, -202, 88},
+    {5618, -141, -348}, {5630, 408, -342}, {5637, 435, -46}, {5645, 319, -178}, {5655, -284, -147}, {5665, 123, 172},
+    {5672, 13, -30}, {5680, -280, -306}, {5692, -389, -234}, {5705, 487, -272}, {5715, 153, 420}, {5724, 57, 232},
+    {5733, -168, -271}, {5744, -55, -12}, {5752, 199, -194}, {5764, 89, 152}, {5772, 344, 136}, {5781, 81, 341},
+    {5793, -228, 244}, {5800, -405, 114}, {5810, 180, 13}, {5822, 324, -460}, {5834, 33, 437}, {5844, 450, 241},
+    {5856, -425, 345}, {5867, 399, 82}, {5878, -295, 361}, {5890, 464, 388}, {5903, -139, 154}, {5913, -471, 369},
+    {5924, -172, -269}, {5934, -48, 155}, {5941, 108, 331}, {5950, 386, -419}, {5958, 286, 192}, {5967, 61, -349},
+    {5977, -482, 208}, {5989, -195, 320}, {5999, 68, 285}
+};
+
+// 1.5 s shake
+static const shakeSample short_shake_trace[] = {
+    {3, 11, -93}, {10, -105, -283}, {22, 10, -264}, {33, 140, -42}, {44, -334, -81}, {53, 343, -113},
+    {63, 28, 205}, {72, -64, -421}, {82, 350, -244}, {91, 192, -132}, {100, -403, -497}, {112, 95, 398},
+    {124, -127, -417}, {134, 334, 276}, {147, 426, 346}, {155, 250, 488}, {168, -367, 251}, {176, 245, -12},
+    {188, 108, -352}, {195, -67, 96}, {203, -119, 253}, {210, 66, -347}, {218, 247, -158}, {231, 33, 31},
+    {239, -258, 423}, {248, 428, -34}, {256, 362, -37}, {267, 6, -187}, {274, -27, 391}, {284, 33, -321},
+    {294, -481, 474}, {306, -178, -446}, {313, 482, -213}, {325, -20, 366}, {334, -277, -151}, {346, -337, -392},
+    {355, -399, 190}, {367, -158, -58}, {376, 63, -111}, {386, 387, -48}, {397, 83, -160}, {409, 495, -76},
+    {418, -399, -184}, {430, -274, 335}, {441, -109, 78}, {451, -298, 449}, {461, 4, 86}, {469, 236, 165},
+    {479, -308, -435}, {487, 430, 43}, {495, -47, -17}, {507, 2309, 149}, {518, 5396, 218}, {530, 8357, 132},
+    {543, 10855, -70}, {553, 11798, -314}, {564, 11858, -71}, {577, 10783, 306}, {587, 9577, -420}, {596, 7614, 0},
+    {605, 6032, 6}, {614, 3747, 342}, {625, -165, -361}, {635, -2608, 46}, {644, -5505, 384}, {651, -7826, -38},
+    {662, -10068, 444}, {673, -10865, 134}, {682, -12343, -425}, {692, -11523, 353}, {704, -10549, 295}, {713, -9418, 331},
+    {721, -7498, 366}, {734, -4935, 432}, {742, -2040, -474}, {753, 473, -405}, {762, 3407, 287}, {770, 6259, -138},
+    {781, 7988, 338}, {788, 10158, -330}, {800, 11941, -202}, {811, 11554, -188}, {821, 12108, 379}, {832, 10554, -278},
+    {840, 8852, 246}, {848, 7459, 483}, {855, 5405, 68}, {867, 2150, -263}, {875, -568, -420}, {885, -3649, 366},
+    {897, -6869, -327}, {906, -8628, -347}, {916, -10199, -213}, {925, -11777, 260}, {935, -11791, 142}, {944, -11653, 256},
+    {954, -10936, 104}, {965, -9506, 35}, {975, -7270, -318}, {985, -4482, -178}, {994, -1526, -25}, {1002, 979, 152},
+    {1010, 3374, 80}, {1021, 6094, 498}, {1029, 8325, -256}, {1040, 10659, -73}, {1049, 11299, -209}, {1060, 11931, 458},
+    {1071, 11548, 115}, {1081, 10903, -456}, {1092, 9087, -241}, {1101, 7015, -219}, {1109, 4428, 356}, {1121, 1387, -176},
+    {1133, -2433, -4}, {1142, -4889, 93}, {1153, -7827, 246}, {1161, -9289, -261}, {1169, -11037, -86}, {1178, -11505, -33},
+    {1190, -12036, -216}, {1199, -11627, -321}, {1208, -10729, 398}, {1217, -8840, 49}, {1227, -6202, -361}, {1236, -4054, 464},
+    {1248, -279, -357}, {1260, 2991, -34}, {1271, 6381, 353}, {1279, 7651, 116}, {1287, 9879, -284}, {1295, 11026, -51},
+    {1307, 11634, 299}, {1319, 12026, 370}, {1330, 10801, -100}, {1342, 8445, 235}, {1354, 5850, 376}, {1363, 3841, -62},
+    {1371, 889, -233}, {1381, -1666, 208}, {1394, -5828, 468}, {1402, -8023, -473}, {1412, -9946, 1}, {1422, -10849, 281},
+    {1432, -11716, -352}, {1444, -11555, -391}, {1454, -10749, -14}, {1466, -8539, -454}, {1476, -6754, 121}, {1488, -3483, -72},
+    {1495, -1356, 121}, {1505, 1749, 155}, {1515, 4484, -53}, {1522, 6602, -228}, {1532, 8417, -86}, {1541, 10546, 471},
+    {1549, 11161, 468}, {1557, 12031, -14}, {1566, 12377, -206}, {1577, 11496, -46}, {1584, 9791, -462}, {1594, 8262, -261},
+    {1602, 6955, -298}, {1615, 2810, -203}, {1626, -479, 453}, {1638, -4159, 38}, {1650, -7428, 410}, {1661, -9989, 322},
+    {1669, -10787, -329}, {1678, -11438, -4}, {1691, -12207, -390}, {1703, -10832, 124}, {1711, -9709, 252}, {1718, -8760, -156},
+    {1725, -7064, -274}, {1734, -4644, -46}, {1741, -2242, 76}, {1749, -113, -300}, {1761, 3528, -492}, {1771, 6775, 360},
+    {1781, 9030, -219}, {1794, 10941, 81}, {1804, 12081, 349}, {1817, 12213, 85}, {1828, 10667, 473}, {1838, 9746, 177},
+    {1847, 8083, 373}, {1858, 4830, 202}, {1869, 1091, 183}, {1879, -1717, -145}, {1889, -4265, 253}, {1897, -6941, 3},
+    {1908, -8703, 63}, {1918, -10889, 431}, {1927, -11592, -203}, {1939, -12456, -352}, {1949, -11119, 343}, {1957, -10470, 187},
+    {1965, -9102, 269}, {1974, -6912, -458}, {1985, -4485, 32}, {1997, -949, -367}, {2007, 193, 475}, {2019, -219, 489},
+    {2031, 448, 374}, {2042, -292, -476}, {2055, 91, -414}, {2067, 491, -422}, {2074, 114, 50}, {2086, -402, -373},
+    {2094, -196, -284}, {2103, 189, -182}, {2111, -477, 128}, {2120, 178, 232}, {2130, 203, 252}, {2137, -155, -462},
+    {2146, -64, -227}, {2154, -465, 428}, {2162, -176, -65}, {2174, -260, -479}, {2183, 3, -310}, {2190, -430, 104},
+    {2202, 495, -321}, {2214, 418, -103}, {2225, 275, 337}, {2238, 335, -273}, {2245, -257, 157}, {2256, 397, -217},
+    {2267, 470, -124}, {2279, 109, -151}, {2292, -82, 131}, {2303, -389, -327}, {2310, 486, -130}, {2319, 221, 379},
+    {2329, 96, -479}, {2340, -384, -417}, {2350, 173, -259}, {2358, -364, -400}, {2368, -283, 238}, {2376, -449, -65},
+    {2386, -157, -24}, {2395, 273, -78}, {2403, -31, -232}, {2410, -169, 200}, {2418, -464, 72}, {2430, 96, 412},
+    {2437, -64, 487}, {2447, -395, 293}, {2459, 38, 248}, {2468, -68, 54}, {2477, 486, -246}, {2487, -39, -290},
+    {2495, -349, -107}, {2506, 49, -235}, {2515, -84, -276}, {2525, -126, 412}, {2535, -306, -234}, {2544, 493, 154},
+    {2556, 328, -59}, {2566, -87, 482}, {2575, -215, -42}, {2584, 159, 53}, {2595, -207, -346}, {2607, -308, 498},
+    {2619, -153, -413}, {2631, -379, -231}, {2639, 216, -98}, {2646, 74, -313}, {2659, -124, 257}, {2667, -295, 101},
+    {2675, 0, 340}, {2685, 126, -194}, {2696, 458, 257}, {2709, -171, 116}, {2720, 421, -180}, {2732, -179, -211},
+    {2742, 33, -482}, {2749, 68, -348}, {2760, -227, -289}, {2771, 483, 134}, {2778, -87, 308}, {2787, -4, -411},
+    {2794, 258, -14}, {2803, 7, 49}, {2811, 40, -301}, {2820, 246, -133}, {2832, -365, 46}, {2841, -201, 334},
+    {2853, -485, -246}, {2866, -141, 247}, {2878, -406, 300}, {2888, 479, 28}, {2899, -150, 492}, {2910, 342, -166},
+    {2920, -88, 491}, {2932, 344, -200}, {2940, -8, -409}, {2951, -485, 329}, {2959, 335, -225}, {2967, -438, 82},
+    {2979, 86, -170}, {2989, 70, 61}, {2998, 225, -452}, {3007, 126, -27}, {3019, -7, 303}, {3031, -82, -259},
+    {3043, -57, 27}, {3055, -434, -136}, {3064, -451, 370}, {3076, 251, -19}, {3088, -5, -422}, {3097, 387, -158},
+    {3106, -412, 358}, {3114, 383, -440}, {3122, -80, -211}, {3132, 286, -178}, {3144, -295, 13}, {3155, 319, 441},
+    {3164, -65, 302}, {3172, 100, 441}, {3180, -229, -291}, {3188, 86, -462}, {3199, 317, 395}, {3210, -494, -297},
+    {3221, 196, 389}, {3229, -185, 220}, {3238, -443, 301}, {3249, 475, 357}, {3256, -45, 288}, {3265, -439, -405},
+    {3275, 234, 295}, {3284, 484, 51}, {3296, 336, 364}, {3307, -111, -489}, {3317, -328, -483}, {3326, 456, 216},
+    {3338, 476, -481}, {3348, 197, 327}, {3358, 315, -452}, {3370, 473, -293}, {3380, -389, -461}, {3388, -198, 431},
+    {3400, -116, -254}, {3412, 222, 194}, {3424, 95, -195}, {3433, -248, -498}, {3444, 251, 317}, {3455, 204, 307},
+    {3463, 174, -254}, {3472, 422, -477}, {3483, 96, 147}, {3491, -315, -482}, {3503, 490, 35}, {3515, -166, -446},
+    {3525, 283, 380}, {3532, 395, -214}, {3545, 356, -445}, {3553, -268, 243}, {3560, 9, -258}, {3569, -8, -47},
+    {3580, -234, 84}, {3591, 414, 95}, {3600, -305, -378}, {3613, 248, -125}, {3623, 158, -231}, {3635, 315, 479},
+    {3642, -380, -96}, {3655, 22, 317}, {3662, -58, 309}, {3674, 325, 406}, {3684, 319, -463}, {3693, -51, -400},
+    {3704, -248, -73}, {3715, -125, 35}, {3723, -279, -129}, {3734, -104, -22}, {3744, 467, 53}, {3753, -243, -56},
+    {3761, 35, -271}, {3771, 166, -212}, {3779, -19, -201}, {3788, -286, 138}, {3801, 401, 239}, {3810, 458, 341},
+    {3820, -291, 142}, {3832, -243, -171}, {3839, 270, 411}, {3850, -442, -440}, {3862, -138, -107}, {3870, 249, -63},
+    {3879, -449, 465}, {3887, -202, 366}, {3895, 455, 387}, {3905, -265, 361}, {3912, 497, -92}, {3923, 260, -167},
+    {3934, 82, -51}, {3944, -491, 0}, {3953, 352, 363}, {3965, -268, 59}, {3975, 419, 83}, {3985, -42, -489},
+    {3996, -264, 149}
+};
+
+// 2 s shake, pause, 2 s shake
+static const shakeSample broken_shake_trace[] = {
+    {8, -176, 242}, {16, 440, 334}, {23, -175, -214}, {32, -391, 72}, {44, -30, 264}, {52, -488, 485},
+    {63, 416, 464}, {73, 178, 19}, {80, -455, -310}, {88, 80, -207}, {100, 321, 230}, {111, 232, 326},
+    {123, -304, 104}, {136, 434, 463}, {143, -106, -140}, {153, -354, -95}, {166, 303, -38}, {177, 310, 492},
+    {184, 328, 61}, {197, 130, 176}, {206, 381, 155}, {216, -398, 295}, {227, -74, 437}, {240, 311, -408},
+    {249, 208, 357}, {257, -191, 108}, {265, 104, 181}, {276, -445, -110}, {289, 221, 84}, {298, 245, 119},
+    {307, 169, -466}, {319, -455, 119}, {330, -340, -464}, {343, -11, 364}, {354, -171, -18}, {366, -385, 403},
+    {378, -47, 164}, {388, -416, 367}, {400, 454, 216}, {410, -175, 451}, {419, -141, 13}, {428, 496, -469},
+    {441, 103, -166}, {448, -215, -171}, {459, 360, -216}, {468, 317, 273}, {476, 279, -211}, {489, 239, -30},
+    {501, 740, -329}, {511, 3171, -75}, {519, 6211, -403}, {530, 8622, -54}, {539, 9831, -64}, {547, 11248, 362},
+    {559, 12283, 288}, {570, 11714, -21}, {578, 11274, 241}, {591, 9290, 408}, {599, 6879, 112}, {611, 4054, -291},
+    {622, 204, -275}, {630, -1354, -38}, {642, -5143, -12}, {651, -7634, 206}, {660, -9044, -176}, {670, -10477, -106},
+    {679, -11680, -292}, {687, -12451, -256}, {697, -11883, -137}, {708, -10705, -310}, {719, -8778, -107}, {728, -6279, 302},
+    {741, -2653, 372}, {749, -203, -162}, {761, 2820, -307}, {771, 5607, -153}, {780, 8532, 173}, {788, 10140, -32},
+    {799, 10901, 243}, {810, 12337, 335}, {819, 11664, 202}, {827, 11145, -254}, {837, 10038, -135}, {844, 8198, 488},
+    {854, 6168, 90}, {865, 3223, -489}, {875, -159, 15}, {884, -2716, 300}, {893, -5041, 488}, {902, -7371, -332},
+    {913, -9717, 1}, {924, -11566, 309}, {932, -11978, 152}, {944, -11476, -170}, {956, -10349, 419}, {968, -8266, -389},
+    {976, -6438, -235}, {984, -4698, -297}, {991, -2841, 368}, {1002, 923, -377}, {1013, 3978, -487}, {1024, 7179, -266},
+    {1036, 9834, 397}, {1048, 11557, -397}, {1055, 12110, 422}, {1066, 12283, 495}, {1076, 10887, 213}, {1084, 10442, -87},
+    {1091, 8668, 430}, {1102, 6863, -170}, {1114, 3222, 129}, {1125, 106, 34}, {1135, -2902, 215}, {1145, -5684, -262},
+    {1157, -8790, 270}, {1169, -10412, 336}, {1179, -11917, -224}, {1187, -12222, 19}, {1196, -12009, -473}, {1204, -11126, -412},
+    {1214, -9779, -244}, {1226, -7115, -331}, {1236, -3639, 255}, {1245, -1302, 223}, {1256, 1880, -473}, {1266, 4986, 4},
+    {1274, 6715, -263}, {1285, 9300, 362}, {1295, 10612, 13}, {1307, 11785, -427}, {1314, 12430, 370}, {1324, 11284, -427},
+    {1331, 10300, 272}, {1343, 8006, -220}, {1355, 5858, -360}, {1366, 3142, 384}, {1375, -147, -180}, {1383, -2865, 284},
+    {1395, -5678, -197}, {1405, -7966, -442}, {1414, -10061, -289}, {1426, -11993, 139}, {1436, -12321, 352}, {1445, -11990, 98},
+    {1453, -11369, 364}, {1464, -9379, -318}, {1476, -7090, 220}, {1489, -2841, 22}, {1498, -284, 148}, {1510, 2687, 173},
+    {1521, 5985, -273}, {1531, 8771, -128}, {1543, 10104, -302}, {1552, 11781, 190}, {1564, 11953, 280}, {1572, 11379, -17},
+    {1583, 10129, 1}, {1593, 8413, -231}, {1601, 6677, -156}, {1613, 3450, 494}, {1626, -700, 227}, {1636, -3790, 285},
+    {1646, -6627, 121}, {1659, -8631, 125}, {1670, -10545, 297}, {1678, -11539, 109}, {1687, -12139, -476}, {1697, -11127, -321},
+    {1705, -10484, 221}, {1713, -9935, -13}, {1724, -7426, -134}, {1734, -4972, 312}, {1743, -2329, 170}, {1754, 1164, 178},
+    {1762, 3396, -179}, {1775, 7403, -443}, {1784, 9676, 307}, {1794, 11065, 358}, {1802, 11513, 122}, {1815, 11518, 75},
+    {1828, 10903, 364}, {1836, 9374, 250}, {1847, 7364, -478}, {1859, 4129, 184}, {1871, 1340, -28}, {1878, -937, 17},
+    {1891, -4299, 483}, {1900, -6860, 116}, {1909, -9424, -265}, {1921, -10893, 402}, {1931, -11475, -352}, {1939, -12285, 37},
+    {1951, -11418, 61}, {1958, -10388, -377}, {1969, -8100, 25}, {1978, -6592, -188}, {1989, -3110, -256}, {1998, -22, 5},
+    {2007, 1798, -43}, {2015, 5102, -483}, {2027, 7290, 282}, {2035, 9672, 382}, {2046, 11098, -190}, {2057, 11787, -290},
+    {2069, 11532, -34}, {2077, 10955, 227}, {2089, 9000, 438}, {2101, 6650, 441}, {2114, 3096, -301}, {2122, 1046, -449},
+    {2131, -1779, 381}, {2144, -5891, 27}, {2152, -7776, -419}, {2159, -9379, -465}, {2170, -10571, -182}, {2182, -11956, -444},
+    {2194, -11846, 233}, {2204, -10843, -71}, {2217, -9064, 270}, {2227, -6601, 157}, {2236, -4222, -118}, {2244, -1407, 187},
+    {2252, 305, 55}, {2261, 3502, 22}, {2271, 6401, 173}, {2284, 8790, 364}, {2294, 10906, 490}, {2306, 11908, 162},
+    {2317, 12325, -231}, {2329, 10663, -252}, {2341, 9152, -156}, {2353, 5660, -70}, {2365, 3164, -340}, {2376, -994, 253},
+    {2384, -2595, 40}, {2392, -5557, 278}, {2403, -8316, 252}, {2414, -10235, -431}, {2425, -11379, 112}, {2433, -11859, -215},
+    {2446, -11375, 194}, {2456, -11070, 37}, {2465, -8909, 403}, {2474, -6998, 410}, {2486, -3948, -47}, {2499, -447, 304},
+    {2507, -167, -477}, {2517, -466, 17}, {2528, 128, 140}, {2537, 36, -294}, {2549, -228, 46}, {2560, 459, -362},
+    {2572, -241, -402}, {2585, 379, 405}, {2594, -40, -27}, {2602, 298, 481}, {2611, 273, 218}, {2622, -130, 292},
+    {2631, -481, -78}, {2643, 328, -289}, {2654, 205, -473}, {2663, 435, -383}, {2672, 109, 92}, {2684, -71, -51},
+    {2693, 288, 8}, {2703, 301, 381}, {2711, -45, -35}, {2721, 405, -448}, {2733, 358, 187}, {2744, 189, 482},
+    {2756, -404, -251}, {2766, -425, -383}, {2778, -16, 452}, {2785, 276, -398}, {2794, 416, -404}, {2803, 84, -245},
+    {2811, -137, -363}, {2823, -108, -156}, {2832, -97, -458}, {2842, 497, -398}, {2849, -36, 347}, {2857, -26, 129},
+    {2870, -337, 219}, {2878, 116, 86}, {2888, 410, 40}, {2901, 273, 336}, {2908, 187, 305}, {2918, -433, 444},
+    {2930, 131, -147}, {2942, 305, 187}, {2951, 371, -274}, {2962, 114, -15}, {2972, 240, 175}, {2979, 52, -105},
+    {2991, -222, -391}, {2998, -240, -394}, {3006, 186, -12}, {3019, 418, -453}, {3030, -351, -12}, {3042, 49, 59},
+    {3051, -361, -72}, {3062, 430, 250}, {3072, -324, 254}, {3083, -333, -31}, {3096, 127, 127}, {3105, 194, 23},
+    {3114, -485, 363}, {3122, -248, -408}, {3134, 436, -210}, {3141, -406, 431}, {3150, 51, -218}, {3162, -15, 338},
+    {3174, -254, -489}, {3183, -251, -18}, {3193, 416, 194}, {3201, 742, 35}, {3211, 2849, 366}, {3219, 5928, 262},
+    {3231, 8364, -39}, {3244, 10847, -56}, {3253, 11855, -266}, {3266, 11866, -167}, {3275, 11040, 308}, {3285, 10114, -482},
+    {3294, 8690, -128}, {3301, 6672, -136}, {3308, 4671, 298}, {3317, 2334, -69}, {3327, -487, 250}, {3337, -3806, -468},
+    {3346, -6075, -483}, {3354, -8039, 333}, {3362, -9499, -372}, {3371, -11157, 154}, {3382, -12062, -464}, {3393, -12358, -127},
+    {3405, -10714, -122}, {3416, -8759, 85}, {3428, -6642, 113}, {3436, -3959, 453}, {3447, -425, -433}, {3457, 2505, 350},
+    {3465, 4235, 147}, {3477, 7744, 259}, {3486, 9353, 287}, {3496, 11306, 44}, {3505, 11879, 378}, {3512, 11996, 17},
+    {3523, 11386, -269}, {3536, 9529, 464}, {3545, 8344, -156}, {3555, 5529, 9}, {3564, 2736, -484}, {3574, -92, 6},
+    {3586, -3892, 77}, {3597, -6495, -159}, {3608, -8757, -230}, {3616, -10862, -196}, {3628, -12017, 67}, {3638, -11610, -44},
+    {3649, -11939, 454}, {3661, -9516, 116}, {3669, -8681, -42}, {3676, -6188, -94}, {3689, -3209, 444}, {3701, 631, 475},
+    {3714, 3882, 497}, {3725, 7512, 358}, {3732, 8867, 356}, {3743, 11064, -432}, {3755, 11583, 251}, {3767, 12165, -130},
+    {3777, 10762, 125}, {3785, 10316, -117}, {3793, 8156, -453}, {3805, 5862, 396}, {3812, 3865, 333}, {3820, 1922, 97},
+    {3832, -2589, 177}, {3840, -5005, -437}, {3851, -7253, 290}, {3858, -9138, 223}, {3866, -10407, -138}, {3878, -11593, -326},
+    {3886, -12309, -143}, {3899, -11069, 491}, {3906, -10572, 437}, {3915, -8928, 483}, {3927, -6919, 27}, {3937, -3408, -3},
+    {3949, -29, -177}, {3958, 3144, -287}, {3966, 4349, 256}, {3975, 7271, 83}, {3983, 8998, -284}, {3995, 11297, 306},
+    {4005, 11493, -464}, {4015, 12226, 493}, {4027, 10799, 47}, {4035, 10260, 458}, {4046, 8304, 222}, {4059, 5048, 251},
+    {4068, 2091, 184}, {4075, 159, 373}, {4086, -3605, -378}, {4094, -5479, 306}, {4103, -7490, -115}, {4110, -9189, -219},
+    {4119, -11178, 305}, {4130, -11630, -77}, {4138, -11818, -2}, {4149, -11765, 202}, {4161, -9595, 200}, {4171, -7627, -178},
+    {4178, -6373, -80}, {4189, -2991, -32}, {4198, -708, 412}, {4205, 1606, 70}, {4217, 5126, -205}, {4230, 7831, -19},
+    {4238, 10349, -199}, {4248, 11525, -276}, {4259, 12162, 470}, {4268, 11507, 231}, {4277, 11599, 311}, {4288, 9380, 213},
+    {4298, 7017, 199}, {4309, 4376, 67}, {4317, 2245, 55}, {4330, -1584, 491}, {4337, -3433, 91}, {4347, -6120, 204},
+    {4356, -8099, 131}, {4363, -9564, -80}, {4374, -11024, 318}, {4384, -11939, 494}, {4394, -12119, 210}, {4404, -10675, -94},
+    {4417, -8644, 68}, {4428, -5776, 442}, {4438, -3410, -141}, {4450, 390, 301}, {4460, 2856, 245}, {4473, 6661, 467},
+    {4483, 9060, -380}, {4493, 10151, -460}, {4504, 11743, -74}, {4516, 11767, -77}, {4523, 11709, -161}, {4531, 11133, -478},
+    {4541, 8705, -443}, {4553, 6099, -140}, {4561, 4354, 245}, {4571, 1411, 264}, {4584, -2826, -83}, {4595, -5927, -456},
+    {4607, -9025, 277}, {4615, -9706, 286}, {4624, -11397, -187}, {4636, -11636, -280}, {4646, -11863, 161}, {4655, -10255, -249},
+    {4665, -8933, -465}, {4675, -7218, -373}, {4684, -4423, -260}, {4694, -1680, 350}, {4706, 1872, 59}, {4714, 3955, -234},
+    {4724, 7036, 49}, {4732, 8518, -39}, {4739, 9586, 4}, {4748, 11015, 413}, {4761, 11714, -350}, {4773, 11406, 15},
+    {4786, 10043, 327}, {4794, 8621, -110}, {4803, 6442, -298}, {4815, 2762, -341}, {4825, -21, -216}, {4834, -3250, -430},
+    {4846, -6013, -208}, {4857, -9189, -371}, {4865, -10261, 128}, {4873, -10744, -345}, {4883, -11679, -482}, {4896, -12042, -96},
+    {4905, -11169, 68}, {4912, -9815, -318}, {4923, -7101, -191}, {4934, -4569, 85}, {4946, -638, -36}, {4958, 2121, -205},
+    {4968, 5303, 8}, {4980, 8578, -449}, {4989, 9969, 285}, {4997, 10884, -243}, {5004, 12052, -297}, {5016, 12356, 328},
+    {5025, 11863, -185}, {5033, 10637, -283}, {5042, 8710, 294}, {5049, 7544, -247}, {5057, 5558, -402}, {5069, 1240, -274},
+    {5077, -692, 335}, {5089, -4476, -154}, {5100, -7309, -351}, {5111, -9241, 0}, {5121, -10609, -396}, {5132, -12375, 460},
+    {5142, -11931, 402}, {5153, -10638, -59}, {5160, -10081, -71}, {5170, -7605, 172}, {5178, -6208, -82}, {5185, -4002, -105},
+    {5193, -2127, -225}, {5204, -281, -80}, {5215, -150, -169}, {5222, 162, -325}, {5233, -294, -437}, {5242, 131, 391},
+    {5251, -115, 57}, {5261, 313, -177}, {5269, -56, -245}, {5278, -195, 173}, {5289, -155, 248}, {5302, 488, -374},
+    {5315, -165, -322}, {5324, 352, -367}, {5337, 300, -11}, {5346, 273, -120}, {5357, -234, 101}, {5367, -458, -437},
+    {5378, -73, -244}, {5386, 168, 408}, {5396, 390, -428}, {5407, -251, -427}, {5419, -483, -383}, {5431, 414, 329},
+    {5439, -477, 481}, {5447, 160, 225}, {5455, -248, -313}, {5465, -427, 65}, {5474, -225, -94}, {5486, -268, -67},
+    {5495, -287, 328}, {5502, -150, 112}, {5514, -48, 171}, {5522, -119, -406}, {5530, 148, 110}, {5541, 179, -443},
+    {5552, 187, 195}, {5560, -50, -15}, {5571, 490, -499}, {5581, 49, 336}, {5590, -161, -445}, {5602, 403, -99},
+    {5609, -382, 329}, {5621, 77, 264}, {5631, 125, 319}, {5644, -216, 45}, {5651, 373, -11}, {5662, 344, -215},
+    {5673, -482, -372}, {5682, 413, -327}, {5693, -168, 383}, {5703, 465, 495}, {5713, -118, 14}, {5722, -151, -22},
+    {5732, 308, -363}, {5744, 424, 410}, {5753, 366, 492}, {5762, 82, 234}, {5769, 133, -457}, {5782, 149, -23},
+    {5793, 46, 377}, {5803, 495, -307}, {5816, 162, -230}, {5825, -159, -161}, {5836, 311, -135}, {5847, -435, 209},
+    {5855, 41, -186}, {5864, 46, 356}, {5876, 7, 362}, {5885, 308, -352}, {5892, 225, -300}, {5905, 499, -132},
+    {5918, 327, -434}, {5927, 499, 13}, {5939, -257, 436}, {5951, -317, -294}, {5964, 449, 285}, {5977, -392, 347},
+    {5988, -291, 221}, {5996, 169, -35}, {6005, -67, 27}, {6016, -490, 363}, {6025, -404, 388}, {6035, -307, 16},
+    {6044, -148, 320}, {6052, -56, -157}, {6064, 245, 115}, {6076, -21, -227}, {6083, -306, -207}, {6096, -295, -228},
+    {6109, -365, -123}, {6120, 321, -295}, {6132, -6, 1}, {6144, -394, 231}, {6152, 390, -354}, {6160, -86, -395},
+    {6170, -273, 11}, {6183, 175, 45}, {6193, 60, -153}, {6202, -77, 105}, {6214, 448, -278}, {6224, 115, 160},
+    {6237, 121, 59}, {6245, 319, -55}, {6257, 189, -56}, {6264, 499, -207}, {6272, -249, 475}, {6281, 459, -21},
+    {6293, 88, 232}, {6306, -270, 319}, {6313, 337, 92}, {6324, 404, -50}, {6331, -208, 459}, {6342, 236, -83},
+    {6354, -247, -324}, {6362, 5, 3}, {6373, -417, 146}, {6384, -62, -51}, {6392, 358, 459}, {6400, -269, -51},
+    {6413, 285, -462}, {6421, 434, 114}, {6431, -216, -404}, {6441, 242, 281}, {6448, -104, 434}, {6457, -33, 332},
+    {6467, 428, 362}, {6479, -275, -58}, {6492, -25, -233}, {6503, 120, 384}, {6514, -263, 115}, {6527, -38, -163},
+    {6538, -209, -72}, {6545, 274, 304}, {6554, 210, -11}, {6564, 167, 101}, {6576, 206, -155}, {6588, -190, -479},
+    {6598, 174, 351}, {6606, -436, 116}, {6617, 324, -184}, {6626, 56, -255}, {6635, 291, 7}, {6648, -294, 271},
+    {6657, -124, 78}, {6670, 0, -387}, {6680, -169, 152}, {6690, -439, 486}, {6701, 355, 146}, {6711, -260, 76},
+    {6722, -319, 74}, {6731, 338, 469}, {6744, -76, -115}, {6752, -323, -453}, {6761, 113, -394}, {6773, 69, -262},
+    {6786, 35, 331}, {6796, 485, -223}, {6807, 306, 327}, {6818, -70, 381}, {6827, -160, 288}, {6840, -195, -492},
+    {6851, -398, -473}, {6860, 320, -419}, {6870, 314, -362}, {6880, -306, -137}, {6889, -477, -108}, {6897, -300, -131},
+    {6904, 159, 425}, {6917, -163, 477}, {6925, -456, -28}, {6934, 152, 148}, {6944, 438, -309}, {6957, 494, 401},
+    {6967, -398, 374}, {6978, -271, 461}, {6990, -33, 40}
+};
+
+// Clock tilted and left
+static const shakeSample tilt_trace[] = {
+    {7, -267, -451}, {19, -274, 67}, {26, 497, 470}, {39, -20, -463}, {50, 8, -356}, {62, 366, 53},
+    {74, -134, -425}, {87, -12, 332}, {96, 348, -471}, {107, -188, -398}, {116, 104, 63}, {124, 349, -364},
+    {135, 343, 328}, {145, -52, 492}, {156, 454, -63}, {167, -269, 362}, {175, -303, -90}, {186, -13, -335},
+    {197, 367, 7}, {209, -493, 320}, {220, -386, 456}, {231, 175, -145}, {238, -223, -145}, {247, -158, -284},
+    {257, -55, -197}, {269, 241, -7}, {282, 108, -478}, {290, -484, 421}, {300, 73, -494}, {312, -402, 338},
+    {322, 50, -24}, {331, -497, -5}, {343, -440, -321}, {352, 299, 373}, {362, 68, 306}, {373, 300, 438},
+    {386, -475, -434}, {396, -256, 441}, {404, -331, -318}, {417, 5, -277}, {429, -198, -130}, {442, 121, 138},
+    {452, 413, 48}, {463, 144, 43}, {471, -184, -166}, {479, -373, 456}, {490, -307, -412}, {497, 251, -154},
+    {507, 5231, 64}, {518, 5401, -331}, {525, 5229, -82}, {535, 5192, -418}, {545, 5340, 116}, {555, 5246, -25},
+    {567, 5357, 44}, {577, 5249, 232}, {585, 5203, -187}, {597, 5067, -111}, {609, 5025, 68}, {622, 4945, -431},
+    {634, 4541, 330}, {646, 5084, 381}, {654, 4570, -364}, {665, 4620, 170}, {673, 5372, 23}, {682, 4781, -228},
+    {694, 5229, 140}, {702, 4765, 192}, {713, 5407, 2}, {724, 4609, 363}, {733, 5409, -319}, {742, 5093, -126},
+    {750, 5186, 464}, {763, 5441, -161}, {770, 4696, -241}, {778, 5373, -187}, {788, 4973, -232}, {800, 4772, 399},
+    {813, 4625, -266}, {823, 5005, -25}, {835, 5393, 262}, {843, 4677, -343}, {852, 5198, 28}, {861, 5350, 460},
+    {868, 4823, -130}, {879, 4509, 268}, {889, 5141, 79}, {901, 4806, 26}, {913, 4535, 405}, {921, 5356, 337},
+    {933, 4931, 42}, {942, 4636, 341}, {949, 4585, -337}, {959, 5241, -454}, {968, 4551, 242}, {978, 4551, 8},
+    {985, 5454, 238}, {995, 5078, 44}, {1007, 5013, 379}, {1020, 5030, 329}, {1031, 5436, 111}, {1039, 5372, 100},
+    {1052, 4620, 478}, {1059, 5407, -180}, {1068, 4785, -31}, {1078, 4676, 482}, {1085, 4983, -401}, {1093, 4691, 472},
+    {1104, 4599, 287}, {1113, 4791, -396}, {1122, 4787, 278}, {1133, 5150, -221}, {1143, 5464, 159}, {1150, 4720, 408},
+    {1161, 5303, -254}, {1170, 4637, 489}, {1181, 4844, -127}, {1188, 5372, 18}, {1197, 4661, -133}, {1207, 4666, 130},
+    {1218, 5222, 235}, {1229, 5014, 121}, {1242, 4857, -149}, {1254, 5245, 271}, {1266, 4988, -340}, {1277, 5474, 109},
+    {1288, 4525, -296}, {1298, 5449, -461}, {1305, 5085, -18}, {1313, 5094, -28}, {1326, 5449, 428}, {1334, 4753, 381},
+    {1341, 5394, 47}, {1354, 5437, -65}, {1365, 4831, -18}, {1376, 5104, -410}, {1385, 4879, 39}, {1396, 4733, -147},
+    {1407, 5306, -24}, {1418, 4755, -444}, {1429, 5474, -451}, {1441, 5089, 348}, {1450, 4706, 130}, {1459, 4842, 291},
+    {1466, 4726, 411}, {1478, 5437, -293}, {1490, 4578, 476}, {1498, 4709, 198}, {1510, 5185, 281}, {1517, 5241, -493},
+    {1525, 5447, 311}, {1536, 4988, -424}, {1546, 4543, -39}, {1557, 4947, 21}, {1566, 4835, -101}, {1576, 5428, -110},
+    {1587, 4530, 475}, {1594, 5188, 356}, {1602, 5023, -76}, {1611, 5473, -208}, {1622, 4547, -92}, {1634, 4738, 334},
+    {1643, 4569, -306}, {1650, 4588, -119}, {1662, 5062, -31}, {1670, 5211, 145}, {1678, 4575, 95}, {1691, 5339, 216},
+    {1699, 4749, 332}, {1707, 4519, -271}, {1716, 4696, 296}, {1723, 5221, -408}, {1731, 5379, -291}, {1741, 5072, -82},
+    {1752, 4916, 194}, {1761, 5237, -456}, {1772, 5459, -324}, {1785, 4734, 330}, {1794, 5052, -372}, {1805, 5222, 118},
+    {1817, 4625, 252}, {1826, 4522, 11}, {1836, 5031, 321}, {1848, 4926, 391}, {1857, 4782, 235}, {1869, 5062, -181},
+    {1876, 4895, -406}, {1888, 4841, -272}, {1900, 4993, 267}, {1908, 4792, -433}, {1916, 4576, -191}, {1929, 4778, -200},
+    {1936, 5121, -327}, {1945, 4914, -84}, {1957, 5405, -418}, {1964, 5192, 355}, {1975, 5221, 29}, {1987, 5100, 15},
+    {1995, 5381, -273}, {2007, 5269, -269}, {2016, 4677, -496}, {2026, 4939, -108}, {2039, 5185, -34}, {2050, 4746, 113},
+    {2058, 5095, -77}, {2066, 5147, -410}, {2073, 4946, 378}, {2082, 5490, -434}, {2094, 4945, -393}, {2102, 4517, 63},
+    {2111, 4758, -395}, {2119, 4832, -217}, {2130, 4947, -57}, {2137, 4620, -183}, {2145, 4943, -199}, {2153, 4638, -389},
+    {2164, 5219, -282}, {2176, 5264, 294}, {2186, 5070, 339}, {2198, 5141, 315}, {2207, 5158, 193}, {2219, 4690, 21},
+    {2231, 4717, 266}, {2243, 4519, -406}, {2254, 5089, -66}, {2267, 4530, 495}, {2280, 4988, 498}, {2288, 5223, 339},
+    {2298, 4652, 387}, {2311, 4510, -174}, {2319, 4783, -218}, {2332, 5051, 162}, {2341, 4943, 210}, {2351, 4900, 124},
+    {2361, 4803, 391}, {2374, 4985, -348}, {2384, 5404, 347}, {2396, 4720, -352}, {2403, 5329, -413}, {2411, 4759, 388},
+    {2419, 5464, -138}, {2430, 4692, -314}, {2443, 4726, -186}, {2451, 5196, -280}, {2462, 4932, -492}, {2471, 4943, 202},
+    {2483, 4716, -342}, {2494, 5279, 264}, {2502, 5134, 62}, {2514, 5460, 229}, {2524, 5390, -454}, {2532, 4984, 186},
+    {2541, 4805, 407}, {2549, 5288, 3}, {2557, 4975, 202}, {2565, 4855, 204}, {2572, 4731, 347}, {2580, 5491, -144},
+    {2592, 5349, -149}, {2599, 5335, 363}, {2608, 5136, 197}, {2618, 4847, -142}, {2626, 5309, 166}, {2634, 4841, -454},
+    {2644, 4829, 107}, {2653, 5308, 207}, {2663, 4583, -21}, {2675, 4595, -263}, {2684, 5086, 139}, {2695, 5196, 372},
+    {2704, 4595, -273}, {2716, 5200, 45}, {2727, 5299, 97}, {2734, 5166, -21}, {2743, 4988, -339}, {2751, 4970, 462},
+    {2759, 5362, 103}, {2766, 4897, 450}, {2773, 4880, -203}, {2782, 5006, 384}, {2794, 4811, -72}, {2804, 4556, 406},
+    {2815, 4886, -384}, {2827, 5025, -130}, {2836, 4718, 66}, {2844, 4995, -208}, {2852, 4882, -477}, {2862, 4940, -335},
+    {2873, 5329, -430}, {2884, 4704, -223}, {2893, 4520, 44}, {2904, 5184, -41}, {2917, 5456, -382}, {2928, 4519, 392},
+    {2937, 5493, -213}, {2945, 4794, -90}, {2954, 4616, -146}, {2965, 5069, -77}, {2972, 4554, 133}, {2984, 5232, -98},
+    {2993, 4923, 455}
+};
+
+// Gentle rocking
+static const shakeSample rocking_trace[] = {
+    {4, 45, 42}, {16, -295, 240}, {26, -434, -273}, {34, -30, 471}, {43, -276, -108}, {51, -446, 460},
+    {60, -457, -466}, {70, -114, -197}, {79, -157, -28}, {89, 125, 63}, {99, 0, -108}, {106, -32, 144},
+    {119, -395, 41}, {126, -42, -277}, {136, -101, 359}, {144, 326, 169}, {155, -330, 70}, {165, 133, 111},
+    {174, 3, 25}, {185, 255, -472}, {196, 40, 316}, {203, 486, 48}, {216, -344, -39}, {228, -197, -135},
+    {238, -289, 154}, {247, -450, 387}, {257, 285, 422}, {265, 101, -411}, {275, 50, -349}, {284, 263, -345},
+    {291, -323, -189}, {299, 449, 381}, {312, -52, -103}, {322, 425, 443}, {333, -18, 363}, {343, 134, 469},
+    {351, -298, 84}, {358, -103, -446}, {370, 490, -380}, {378, 12, -365}, {390, -341, 332}, {397, -450, -121},
+    {409, 144, -386}, {417, -161, -16}, {427, -393, 267}, {434, -23, 53}, {446, -198, -168}, {459, 344, 460},
+    {471, -83, 353}, {480, -57, -163}, {490, 253, -81}, {497, 62, 114}, {504, 709, -37}, {516, 617, 259},
+    {525, 1472, 125}, {533, 1781, 116}, {546, 2397, 212}, {556, 2831, -489}, {565, 2199, -485}, {575, 1881, -479},
+    {587, 2412, -462}, {598, 1332, -423}, {609, 542, -87}, {620, 555, -216}, {631, -33, 21}, {641, -1201, -362},
+    {652, -1247, -384}, {659, -1641, 29}, {671, -2612, 471}, {680, -2368, 203}, {692, -2641, -159}, {703, -2663, 64},
+    {711, -1893, 251}, {721, -1676, 4}, {732, -1195, -73}, {744, -166, 142}, {756, 569, -146}, {764, 970, -363},
+    {773, 1527, 290}, {783, 2122, 482}, {791, 1989, 232}, {800, 2247, -55}, {812, 2945, 130}, {820, 2097, -468},
+    {829, 1985, -118}, {841, 1620, 169}, {849, 1979, -121}, {860, 963, -17}, {868, 234, -343}, {880, -200, -164},
+    {891, -803, 400}, {902, -1863, -460}, {909, -2250, 361}, {919, -2175, 391}, {928, -2257, -45}, {939, -2393, 433},
+    {951, -2785, 70}, {962, -2313, -396}, {970, -2047, -110}, {983, -1047, -315}, {994, 131, 210}, {1001, -314, -307},
+    {1013, 960, 102}, {1024, 1369, 124}, {1035, 1633, 384}, {1045, 2594, 223}, {1055, 2601, 237}, {1063, 2201, 154},
+    {1074, 2539, -45}, {1085, 1758, -246}, {1097, 1951, -358}, {1105, 1460, 266}, {1115, 237, 366}, {1123, -116, 214},
+    {1132, -869, 67}, {1142, -1377, 307}, {1153, -1932, 229}, {1162, -1672, 57}, {1173, -2669, 125}, {1181, -2959, 493},
+    {1189, -2314, 143}, {1202, -2577, 143}, {1214, -2150, 487}, {1226, -946, 176}, {1235, -1175, 278}, {1245, -733, 381},
+    {1256, 370, -159}, {1269, 1224, 360}, {1281, 1608, -297}, {1289, 2221, 123}, {1302, 2333, -409}, {1312, 2447, -34},
+    {1321, 2286, 456}, {1329, 1955, 300}, {1339, 1790, 310}, {1346, 1641, -155}, {1358, 1451, 389}, {1369, 778, 316},
+    {1382, -392, -47}, {1394, -1190, -450}, {1406, -1529, -272}, {1417, -2016, -313}, {1428, -2351, -209}, {1435, -2991, -155},
+    {1447, -2725, 409}, {1456, -2612, 428}, {1466, -2069, 134}, {1479, -1441, -24}, {1491, -389, 162}, {1499, -202, 206},
+    {1511, 829, -227}, {1521, 1602, -318}, {1531, 2249, 329}, {1541, 2299, 215}, {1554, 1984, 181}, {1563, 2757, -36},
+    {1572, 2729, 445}, {1585, 1753, -172}, {1593, 1257, 479}, {1602, 1677, -402}, {1611, 1310, -428}, {1624, -87, -22},
+    {1635, -437, 124}, {1643, -1285, 403}, {1653, -2088, 367}, {1666, -2263, 310}, {1676, -2820, 372}, {1686, -2421, 257},
+    {1694, -2671, -79}, {1703, -1981, 63}, {1712, -2384, 477}, {1720, -1928, -140}, {1729, -982, 328}, {1740, -609, -284},
+    {1752, -63, -354}, {1765, 1045, 247}, {1776, 1775, 19}, {1784, 2188, 368}, {1794, 2234, -262}, {1802, 2052, 66},
+    {1813, 2340, -161}, {1824, 2013, -102}, {1831, 2477, -274}, {1839, 1610, -422}, {1851, 1288, -129}, {1862, 989, -166},
+    {1870, 713, -110}, {1880, -495, 429}, {1889, -675, 18}, {1900, -1756, 9}, {1912, -1742, -223}, {1922, -2244, 174},
+    {1932, -2739, 335}, {1941, -2577, -51}, {1952, -2738, -100}, {1960, -1784, -470}, {1970, -1276, 97}, {1978, -1714, 2},
+    {1988, -900, 194}, {2000, 301, 393}, {2012, 734, -364}, {2020, 1044, 247}, {2028, 1502, 219}, {2040, 1782, -384},
+    {2048, 2353, -87}, {2057, 2936, 121}, {2067, 2528, 110}, {2078, 2562, -492}, {2089, 1508, -148}, {2099, 1164, -185},
+    {2107, 1342, 284}, {2116, 404, 110}, {2128, -672, 412}, {2138, -758, 410}, {2148, -1646, -108}, {2156, -2041, 211},
+    {2164, -2262, 423}, {2173, -2477, -221}, {2184, -2937, 16}, {2194, -2541, 108}, {2206, -1974, 154}, {2218, -1503, 210},
+    {2226, -1509, -363}, {2234, -487, 124}, {2246, -276, -350}, {2258, 655, -184}, {2266, 1027, 320}, {2276, 1582, -124},
+    {2289, 2312, -195}, {2302, 2587, -341}, {2310, 2647, -318}, {2317, 2216, 284}, {2327, 2552, 190}, {2337, 1877, -350},
+    {2345, 1549, -416}, {2357, 1360, 349}, {2370, 541, -362}, {2379, -243, 187}, {2391, -648, 93}, {2403, -1522, -345},
+    {2414, -2188, -437}, {2426, -2724, -451}, {2438, -2868, 181}, {2450, -2180, -360}, {2461, -1956, 41}, {2470, -2063, 28},
+    {2481, -1069, 176}, {2490, -918, -383}, {2498, -564, -356}, {2510, 679, -168}, {2521, 1170, -29}, {2531, 1869, -470},
+    {2539, 2229, 8}, {2549, 1949, -288}, {2559, 2301, -31}, {2569, 2020, 476}, {2580, 2543, 170}, {2593, 2214, 361},
+    {2601, 979, -206}, {2613, 302, -28}, {2626, -375, -356}, {2634, -543, -441}, {2642, -1012, -259}, {2653, -1985, -38},
+    {2662, -2140, 240}, {2670, -1953, 49}, {2681, -2904, -22}, {2688, -2143, -409}, {2701, -2608, -340}, {2713, -1760, 192},
+    {2721, -1353, 499}, {2730, -1387, -280}, {2741, -907, -192}, {2750, 298, 351}, {2762, 891, -166}, {2773, 1589, 185},
+    {2785, 2193, -119}, {2793, 1917, 32}, {2805, 2129, 486}, {2814, 2084, -177}, {2822, 2657, 187}, {2834, 1661, -225},
+    {2841, 2360, 155}, {2849, 1473, 224}, {2861, 516, -263}, {2872, 311, -207}, {2884, -1027, -323}, {2896, -1693, 262},
+    {2907, -1646, -444}, {2915, -2406, 367}, {2928, -2147, -274}, {2937, -2760, 349}, {2945, -2780, -228}, {2953, -2680, -14},
+    {2961, -2004, 277}, {2970, -1531, 454}, {2983, -768, 442}, {2993, -288, 229}, {3005, 405, -193}, {3017, 553, -127},
+    {3029, 1990, 134}, {3042, 2451, 419}, {3050, 2700, 235}, {3062, 2010, -264}, {3074, 2351, 244}, {3081, 2472, 5},
+    {3093, 1556, -353}, {3102, 966, 279}, {3112, 494, 86}, {3120, -65, -297}, {3128, -15, -272}, {3140, -1279, -138},
+    {3150, -1242, -287}, {3162, -1676, 387}, {3170, -1898, -20}, {3180, -2174, -274}, {3193, -2789, 496}, {3201, -2034, -264},
+    {3214, -2188, -332}, {3222, -1827, -484}, {3234, -1162, 458}, {3243, -504, -386}, {3253, 383, -477}, {3261, 803, -459},
+    {3273, 1290, 344}, {3284, 2216, 219}, {3295, 2018, 199}, {3304, 2843, -202}, {3316, 2002, 453}, {3328, 2484, -29},
+    {3340, 2253, 476}, {3350, 1857, -274}, {3361, 523, 218}, {3371, -83, 149}, {3382, -488, 208}, {3390, -583, -268},
+    {3400, -1319, -471}, {3408, -2259, 290}, {3418, -2585, 28}, {3431, -2425, 451}, {3440, -2100, -184}, {3449, -2486, 320},
+    {3458, -2023, -192}, {3471, -1508, -235}, {3482, -1184, -126}, {3491, -160, 452}, {3499, -394, -151}, {3511, 352, -436},
+    {3520, 1152, 443}, {3529, 1230, -177}, {3538, 1899, -152}, {3546, 2452, 264}, {3558, 2942, -462}, {3569, 2392, -117},
+    {3577, 2567, -409}, {3589, 2201, 76}, {3599, 1668, -481}, {3612, 299, -458}, {3622, -279, 412}, {3629, -761, 18},
+    {3642, -1010, -70}, {3650, -1095, 54}, {3662, -2517, 395}, {3670, -2589, -319}, {3679, -2750, 67}, {3688, -2692, -336},
+    {3698, -2525, 322}, {3706, -2657, -259}, {3714, -2333, 316}, {3723, -1317, -11}, {3735, -1180, 384}, {3747, 19, 233},
+    {3756, 387, 224}, {3766, 914, 168}, {3775, 1523, -369}, {3784, 1943, -436}, {3797, 2710, 327}, {3809, 2015, -249},
+    {3818, 2655, 167}, {3826, 2106, 268}, {3834, 2261, -266}, {3842, 2025, 333}, {3851, 1804, 122}, {3863, 608, -458},
+    {3870, 692, 448}, {3882, -793, -44}, {3889, -1336, 336}, {3898, -1449, 488}, {3907, -1548, 450}, {3919, -2637, 234},
+    {3929, -2313, -177}, {3938, -2738, 151}, {3945, -2359, -474}, {3957, -2490, 262}, {3969, -2210, -32}, {3978, -1288, 269},
+    {3988, -611, -162}, {3996, -140, 242}, {4007, 973, 485}, {4018, 1352, -206}, {4027, 2062, 264}, {4039, 2134, -119},
+    {4052, 2474, 121}, {4062, 2105, 157}, {4070, 2742, 468}, {4078, 2293, -473}, {4088, 2366, 103}, {4098, 1139, 288},
+    {4111, 895, -269}, {4123, -233, 63}, {4134, -461, 344}, {4143, -884, 373}, {4156, -1617, -475}, {4165, -2440, -449},
+    {4173, -2405, 400}, {4185, -2240, 377}, {4197, -2395, -152}, {4204, -2283, -387}, {4214, -1784, 166}, {4221, -1813, 307},
+    {4229, -1229, 296}, {4239, -589, -421}, {4251, 36, 335}, {4264, 1095, 226}, {4274, 1378, -101}, {4283, 1802, 375},
+    {4291, 2586, -399}, {4298, 2408, 22}, {4308, 2163, -313}, {4317, 2405, 167}, {4327, 2652, -396}, {4336, 1597, -78},
+    {4343, 1869, 28}, {4355, 1066, -252}, {4367, 142, -354}, {4374, 56, -246}, {4382, -365, -295}, {4394, -1574, -324},
+    {4405, -1979, 132}, {4415, -2184, -29}, {4428, -2279, -261}, {4435, -2732, 171}, {4444, -2927, -215}, {4453, -2540, 408},
+    {4465, -2167, -29}, {4474, -1046, -245}, {4487, -803, -414}, {4499, 289, -195}, {4510, -494, 390}, {4519, -157, -364},
+    {4527, 70, 485}, {4536, -492, 64}, {4548, 99, 212}, {4561, 233, -145}, {4571, -491, -141}, {4583, 7, 274},
+    {4594, -131, -294}, {4601, 91, 174}, {4614, 293, -300}, {4627, 457, 471}, {4638, 217, -230}, {4647, -278, -279},
+    {4655, -37, -417}, {4668, -390, 155}, {4676, -242, 264}, {4684, -277, 371}, {4696, -388, 362}, {4708, 146, -445},
+    {4720, 197, 89}, {4733, 190, -101}, {4741, -341, -375}, {4749, 258, -357}, {4758, -17, 7}, {4770, -323, -143},
+    {4780, 361, -105}, {4789, -30, -95}, {4800, -314, 228}, {4813, -112, 227}, {4824, 81, -415}, {4836, 215, -146},
+    {4848, 148, -266}, {4855, 134, -194}, {4866, 301, -298}, {4876, -323, 290}, {4885, 373, 354}, {4893, -454, 343},
+    {4900, 388, 296}, {4911, 349, 327}, {4924, 159, -398}, {4935, 8, 441}, {4944, 111, -328}, {4951, -119, 148},
+    {4961, 499, 242}, {4973, -117, 182}, {4985, -92, 329}, {4993, -360, -473}, {5005, -285, -370}, {5017, 444, -466},
+    {5025, -105, -321}, {5037, -447, 89}, {5047, 349, -221}, {5055, 99, 475}, {5063, -359, 486}, {5071, -325, 334},
+    {5082, -190, 194}, {5093, 324, -99}, {5102, -325, 80}, {5114, -477, 394}, {5123, -244, 455}, {5131, 382, 248},
+    {5139, -242, 304}, {5148, 151, -444}, {5160, 239, -465}, {5170, -235, -95}, {5183, -104, 219}, {5194, -18, -482},
+    {5204, -401, -120}, {5212, 402, 328}, {5221, 104, -443}, {5229, 378, 416}, {5240, 93, 243}, {5252, -385, -43},
+    {5261, -72, -77}, {5272, -21, -416}, {5283, 303, 262}, {5291, -186, -164}, {5301, -302, -250}, {5309, -228, 66},
+    {5320, 259, -220}, {5332, -41, 14}, {5339, -441, 0}, {5351, -77, -108}, {5361, 343, -72}, {5368, -244, -312},
+    {5381, 224, -377}, {5388, 355, 77}, {5396, -78, -44}, {5406, -384, 82}, {5419, 499, -251}, {5431, 80, 408},
+    {5442, -261, -192}, {5451, 351, 101}, {5461, -456, -348}, {5471, 267, -58}, {5484, 59, 447}, {5494, -361, -287},
+    {5502, -114, 446}, {5511, 80, 276}, {5520, -443, -57}, {5528, 210, 89}, {5538, 189, -454}, {5546, 250, -427},
+    {5556, -47, 288}, {5569, -184, -498}, {5578, -229, -141}, {5586, 409, 309}, {5598, 410, -14}, {5606, -77, -41},
+    {5615, -136, -250}, {5625, 160, -192}, {5636, -325, 370}, {5645, 168, -404}, {5654, -367, -265}, {5665, -86, 490},
+    {5673, -38, -305}, {5681, -433, -182}, {5690, -58, -60}, {5697, 458, -96}, {5706, -402, -52}, {5714, 454, 186},
+    {5725, -131, 304}, {5738, 297, 477}, {5750, 415, 440}, {5757, 202, 66}, {5770, -28, -469}, {5780, -281, 43},
+    {5792, -109, 130}, {5803, -337, 11}, {5813, 301, -211}, {5824, -372, 98}, {5835, 29, -298}, {5847, 375, -92},
+    {5859, 172, 168}, {5869, 123, -173}, {5880, 17, 390}, {5889, -481, -141}, {5899, -326, -113}, {5910, -172, -144},
+    {5918, -397, -433}, {5931, -384, -164}, {5943, -64, 234}, {5956, -37, -221}, {5966, 241, 58}, {5976, -17, 58},
+    {5985, 148, 285}, {5997, 180, 418}
+};
+
+// Trace, the gestures it must give in order and their number
+typedef struct shakeTrace_struct {
+    const char * name;
+    const shakeSample * samples;
+    unsigned int count;
+    shakeGesture expected[2];
+    unsigned char expected_count;
+} shakeTrace;
+
+static const shakeTrace traces[] = {
+    {"quiet", quiet_trace, sizeof(quiet_trace) / sizeof(shakeSample), {shake_none, shake_none}, 0},
+    {"single knock", single_tap_trace, sizeof(single_tap_trace) / sizeof(shakeSample), {shake_tap, shake_none}, 1},
+    {"double knock 260 ms apart", double_tap_trace, sizeof(double_tap_trace) / sizeof(shakeSample), {shake_tap, shake_none}, 1},
+    {"bump of the nightstand", bump_trace, sizeof(bump_trace) / sizeof(shakeSample), {shake_tap, shake_none}, 1},
+    {"two bumps 1.7 s apart", two_bumps_trace, sizeof(two_bumps_trace) / sizeof(shakeSample), {shake_tap, shake_tap}, 2},
+    {"4 s shake along X at 4 Hz", shake_x_trace, sizeof(shake_x_trace) / sizeof(shakeSample), {shake_dismiss, shake_none}, 1},
+    {"4 s shake along Y at 5 Hz", shake_y_trace, sizeof(shake_y_trace) / sizeof(shakeSample), {shake_dismiss, shake_none}, 1},
+    {"1.5 s shake", short_shake_trace, sizeof(short_shake_trace) / sizeof(shakeSample), {shake_none, shake_none}, 0},
+    {"2 s shake, pause, 2 s shake", broken_shake_trace, sizeof(broken_shake_trace) / sizeof(shakeSample), {shake_none, shake_none}, 0},
+    {"clock tilted and left", tilt_trace, sizeof(tilt_trace) / sizeof(shakeSample), {shake_tap, shake_none}, 1},
+    {"gentle rocking", rocking_trace, sizeof(rocking_trace) / sizeof(shakeSample), {shake_none, shake_none}, 0}
+};
+
+#define TRACE_COUNT (sizeof(traces) / sizeof(shakeTrace))
+
+#endif
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// The timer wheel with far more timers than the firmware runs: hundreds of timers with
+// expiries spread over many turns of the wheel, many due on the same tick and many in
+// the same slot on different turns. Every timer has to fire on its exact tick, cancelled
+// timers not at all, and the free timers have to be found again. The cost of a tick is
+// reported as the number of timers looked at and the host time.
+
+// The firmware builds the wheel with TIMER_WHEEL_TIMERS from timer_wheel.h. timer_wheel.cpp
+// is built again here with WHEEL_TEST_TIMERS timers, in its own namespace.
+#define WHEEL_TEST_TIMERS 256
+#define TIMER_WHEEL_TIMERS WHEEL_TEST_TIMERS
+namespace wheel {
+#include "../../src/timer_wheel.cpp"
+}
+
+// Ticks run since the start of the test program
+static unsigned long tick_count = 0;
+
+// Tick each timer is expected on and tick it fired on, 0 if it did not
+static unsigned long expected_tick[WHEEL_TEST_TIMERS];
+static unsigned long fired_tick[WHEEL_TEST_TIMERS];
+static int fired = 0;
+
+// Cost of the ticks run: timers looked at and host time
+static unsigned long visited_total = 0;
+static unsigned int visited_most = 0;
+static double tick_ns_total = 0;
+static double tick_ns_longest = 0;
+static unsigned long ticks_measured = 0;
+
+static void record_fire(wheel::timerId timer){
+    fired_tick[timer] = tick_count;
+    fired += 1;
+}
+
+void setUp(){
+    for(int k = 0; k < WHEEL_TEST_TIMERS; k++){
+        expected_tick[k] = 0;
+        fired_tick[k] = 0;
+    }
+    fired = 0;
+    visited_total = 0;
+    visited_most = 0;
+    tick_ns_total = 0;
+    tick_ns_longest = 0;
+    ticks_measured = 0;
+}
+
+void tearDown(){
+}
+
+// Starts a timer due in ticks ticks and checks the time it has left
+static wheel::timerId start(unsigned long ticks){
+    wheel::timerId timer = wheel::timer_start(ticks, record_fire);
+    TEST_ASSERT_TRUE(timer < WHEEL_TEST_TIMERS);
+    TEST_ASSERT_EQUAL(0, expected_tick[timer]);
+    TEST_ASSERT_EQUAL(ticks, wheel::timer_remaining(timer));
+    expected_tick[timer] = tick_count + ticks;
+    return timer;
+}
+
+// Runs the wheel for the given number of ticks, counting the timers in the slot of
+// each tick and timing the tick
+static void run_ticks(unsigned long ticks){
+    for(unsigned long k = 0; k < ticks; k++){
+        unsigned int visited = 0;
+        unsigned char slot = (wheel::wheel_position + 1) & (TIMER_WHEEL_SLOTS - 1);
+        for(wheel::timerId t = wheel::wheel_slots[slot]; t != TIMER_NONE; t = wheel::wheel_timers[t].next)
+            visited += 1;
+        visited_total += visited;
+        if(visited > visited_most)
+            visited_most = visited;
+
+        tick_count += 1;
+        auto begin = std::chrono::steady_clock::now();
+        wheel::timer_wheel_tick();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        tick_ns_total += ns;
+        if(ns > tick_ns_longest)
+            tick_ns_longest = ns;
+        ticks_measured += 1;
+    }
+}
+
+static void print_tick_cost(const char * run){
+    printf("%s: %lu ticks, timers looked at per tick %.2f average, %u most, "
+        "host time per tick %.0f ns average, %.0f ns longest\n", run, ticks_measured,
+        (double)visited_total / ticks_measured, visited_most, tick_ns_total / ticks_measured,
+        tick_ns_longest);
+}
+
+// Checks every timer started fired once, on its expected tick
+static void check_fired(int started){
+    TEST_ASSERT_EQUAL(started, fired);
+    for(int k = 0; k < WHEEL_TEST_TIMERS; k++){
+        TEST_ASSERT_EQUAL(expected_tick[k], fired_tick[k]);
+        TEST_ASSERT_EQUAL(0, wheel::timer_remaining(k));
+    }
+}
+
+// All the timers at once: the turn edges (1, 32, 33 and 64 ticks), a spread over many
+// turns, 64 timers due on the same tick and 60 in one slot one turn apart
+void test_all_timers_fire_on_their_tick(){
+    start(1);
+    start(32);
+    start(33);
+    start(64);
+    for(int k = 0; k < 128; k++)
+        start(2 + (k * 97UL) % 5000);
+    for(int k = 0; k < 64; k++)
+        start(640);
+    for(int k = 0; k < 60; k++)
+        start(7 + 32UL * k);
+
+    // all in use
+    TEST_ASSERT_EQUAL(TIMER_NONE, wheel::timer_start(10, record_fire));
+
+    run_ticks(5100);
+    check_fired(WHEEL_TEST_TIMERS);
+    print_tick_cost("all timers");
+}
+
+// Cancelled timers do not fire, and their entries are reused by the next timers
+void test_cancelled_timers_are_reused(){
+    wheel::timerId timers[WHEEL_TEST_TIMERS];
+    for(int k = 0; k < WHEEL_TEST_TIMERS; k++)
+        timers[k] = start(100 + (k % 8) * 32);
+    TEST_ASSERT_EQUAL(TIMER_NONE, wheel::timer_start(10, record_fire));
+
+    for(int k = 0; k < WHEEL_TEST_TIMERS; k += 2){
+        wheel::timer_cancel(timers[k]);
+        expected_tick[timers[k]] = 0;
+        TEST_ASSERT_EQUAL(0, wheel::timer_remaining(timers[k]));
+    }
+
+    run_ticks(50);
+    for(int k = 0; k < WHEEL_TEST_TIMERS / 2; k++)
+        start(1 + k % 200);
+    TEST_ASSERT_EQUAL(TIMER_NONE, wheel::timer_start(10, record_fire));
+
+    run_ticks(400);
+    check_fired(WHEEL_TEST_TIMERS);
+    print_tick_cost("cancel and reuse");
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_all_timers_fire_on_their_tick);
+    RUN_TEST(test_cancelled_timers_are_reused);
+    return UNITY_END();
+}
@@ -0,0 +1,429 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "global_header.h"
+#include "ui.h"
+#include "clock.h"
+#include "countdown.h"
+#include "timer_wheel.h"
+#include "PWM.h"
+#include "I2C.h"
+#include "display.h"
+
+// Every state x event of the transition table in ui.cpp against the input handling of
+// the main loop before the table (an if chain per input, below), both calling the
+// same firmware functions. Each case starts from the same state, hour mode, cursor
+// and buffer AM/PM, and everything the inputs can change is compared afterwards.
+
+// Current system state and times (global variables in main)
+extern volatile stateType state;
+extern volatile int hour_mode;
+extern volatile char time_digits [TIME_DIGITS_NUMBER];
+extern volatile char am_pm;
+extern volatile char alarm_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char alarm_am_pm;
+extern volatile char buffer_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char buffer_am_pm;
+extern volatile char cursor_digit;
+extern volatile char alarm_activation;
+
+// Countdowns and stopwatch (countdown.cpp), alarm tone (PWM.cpp)
+extern volatile char timer_display_digits [4];
+extern volatile timerId countdowns[COUNTDOWN_TIMERS];
+extern char countdown_minutes;
+extern char countdown_digits_typed;
+extern unsigned long stopwatch_ticks;
+extern char stopwatch_running;
+extern char alarm_sounding;
+
+/*Reference: the main loop input handling before the transition table*/
+
+// snooze_alarm() used to turn off the ringing alarm itself
+static void reference_snooze(){
+    if(state != alarm_on)
+        return;
+    turn_off_alarm();
+    state = show_time;
+    snooze_alarm();
+}
+
+static void reference_switch(switchEvent switch_input){
+    if(switch_input == switch_click){
+        reference_snooze();
+    }
+    else if(switch_input == switch_long_press){
+        if(state == alarm_on){
+            turn_off_alarm();
+            state = show_time;
+        }
+    }
+    else if(switch_input == switch_double_click){
+        if(state == show_time)
+            alarm_activation = !alarm_activation;
+    }
+}
+
+// Any movement used to turn off the ringing alarm, which a shake still does. A tap
+// snoozes it like a click of the button.
+static void reference_gesture(shakeGesture gesture){
+    if(gesture == shake_tap)
+        reference_snooze();
+    else if(state == alarm_on){
+        turn_off_alarm();
+        state = show_time;
+    }
+}
+
+static void reference_button(char button){
+    if(button == 'A'){
+        if(state == show_time)
+            alarm_activation = !alarm_activation;
+    }
+
+    if(button == 'S'){
+        if(state == alarm_on){
+            turn_off_alarm();
+            state = show_time;
+        }
+    }
+
+#if TIME_WARP_ENABLED
+    if(button == '/'){
+        if(state == show_time)
+            next_time_warp();
+    }
+#endif
+
+    if(button == 'M'){
+        if(state == show_time){
+            load_time_to_buffer((char *)time_digits, am_pm);
+            state = set_time;
+        }
+        else if(state == set_time){
+            save_buffer_to_time((char *)time_digits, (char *)(&am_pm));
+            load_time_to_buffer((char *)alarm_time_digits, alarm_am_pm);
+            state = set_alarm;
+        }
+        else if(state == set_alarm){
+            save_buffer_to_time((char *)alarm_time_digits, (char *)(&alarm_am_pm));
+            update_timer_display();
+            state = show_timer;
+        }
+        else if(state == show_timer){
+            update_temperature_display();
+            state = show_temperature;
+        }
+        else if(state == show_temperature){
+            state = show_time;
+        }
+        cursor_digit = 0;
+    }
+    if (button == 'P') {
+        change_hour_mode();
+    }
+
+    if(state == show_timer){
+        if(button >= '0' && button <= '9')
+            countdown_digit(button - '0');
+        else if(button == '/')
+            countdown_start();
+        else if(button == 'S')
+            countdown_cancel();
+        else if(button == 'R')
+            stopwatch_toggle();
+        else if(button == 'L')
+            stopwatch_reset();
+    }
+
+    if(state == show_temperature){
+        if(button == '/')
+            temperature_unit = !temperature_unit;
+    }
+
+    if(state == set_time || state == set_alarm){
+        if(button >= '0' && button <= '9'){
+            buffer_time_digits[(int)cursor_digit] = button - '0';
+            button = 'R';
+        }
+        else if(button == '/'){
+            if (hour_mode == 0) {
+                buffer_am_pm = !buffer_am_pm;
+            }
+        }
+
+        if(button == 'R'){
+            cursor_digit += 1;
+            if(cursor_digit == 4)
+                cursor_digit = 0;
+        }
+        else if(button == 'L'){
+            cursor_digit -= 1;
+            if(cursor_digit == -1)
+                cursor_digit = 3;
+        }
+    }
+}
+
+// A countdown expiring used to ring the alarm and set alarm_on directly, skipping the
+// exit action of set_time and set_alarm. The buffer being edited is now saved as when
+// leaving them with M.
+static void reference_countdown(){
+    if(state == set_time)
+        save_buffer_to_time((char *)time_digits, (char *)(&am_pm));
+    else if(state == set_alarm)
+        save_buffer_to_time((char *)alarm_time_digits, (char *)(&alarm_am_pm));
+    if(state != alarm_on){
+        turn_on_alarm();
+        state = alarm_on;
+    }
+}
+
+// The clock reaching the alarm time used to ring the alarm and set alarm_on from the
+// clock timer interrupt, in show_time, show_timer and show_temperature only
+static void reference_alarm(){
+    if(state == show_time || state == show_timer || state == show_temperature){
+        turn_on_alarm();
+        state = alarm_on;
+    }
+}
+
+/*Cases*/
+
+// Inputs: a button of the remote, a gesture of the snooze/dismiss button or of the MPU,
+// a countdown expiring, the alarm time
+typedef enum inputKind_enum {
+    input_button, input_switch, input_gesture, input_countdown, input_alarm}
+inputKind;
+
+typedef struct uiCase_struct {
+    stateType state;
+    int hour_mode;
+    char cursor;
+    char buffer_am_pm;
+    inputKind kind;
+    char input;
+} uiCase;
+
+// Everything the inputs can change
+typedef struct uiSnapshot_struct {
+    int state;
+    int hour_mode;
+    char cursor_digit;
+    char buffer_time_digits[TIME_DIGITS_NUMBER];
+    char buffer_am_pm;
+    char time_digits[TIME_DIGITS_NUMBER];
+    char am_pm;
+    char alarm_time_digits[TIME_DIGITS_NUMBER];
+    char alarm_am_pm;
+    char alarm_activation;
+    char alarm_sounding;
+    char temperature_unit;
+    char countdown_minutes;
+    char countdown_digits_typed;
+    char countdowns_running;
+    char stopwatch_running;
+    char timer_display_digits[4];
+    char temperature_display_digits[4];
+} uiSnapshot;
+
+// Puts the firmware in the starting point of a case
+static void arrange(const uiCase * c){
+    for(int k = 0; k < COUNTDOWN_TIMERS; k++){
+        timer_cancel(countdowns[k]);
+        countdowns[k] = TIMER_NONE;
+    }
+    countdown_minutes = 0;
+    countdown_digits_typed = 0;
+    stopwatch_running = 0;
+    stopwatch_ticks = 0;
+
+    // a countdown to cancel and a length typed before
+    countdown_digit(4);
+    countdown_start();
+    countdown_digit(2);
+
+    static const char time[TIME_DIGITS_NUMBER] = {1, 0, 3, 5};
+    static const char alarm[TIME_DIGITS_NUMBER] = {0, 7, 1, 5};
+    static const char buffer[TIME_DIGITS_NUMBER] = {1, 1, 4, 2};
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        time_digits[k] = time[k];
+        alarm_time_digits[k] = alarm[k];
+        buffer_time_digits[k] = buffer[k];
+        timer_display_digits[k] = DIGIT_BLANK;
+        temperature_display_digits[k] = DIGIT_BLANK;
+    }
+    // 24 hour times are kept in 24 hour mode
+    am_pm = c->hour_mode ? 0 : 1;
+    alarm_am_pm = 0;
+    buffer_am_pm = c->buffer_am_pm;
+    hour_mode = c->hour_mode;
+    cursor_digit = c->cursor;
+    alarm_activation = 1;
+    temperature_unit = 0;
+
+    turn_off_alarm();
+    if(c->state == alarm_on)
+        turn_on_alarm();
+    state = c->state;
+}
+
+static void take_snapshot(uiSnapshot * s){
+    memset(s, 0, sizeof(uiSnapshot));
+    s->state = state;
+    s->hour_mode = hour_mode;
+    s->cursor_digit = cursor_digit;
+    s->buffer_am_pm = buffer_am_pm;
+    s->am_pm = am_pm;
+    s->alarm_am_pm = alarm_am_pm;
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        s->buffer_time_digits[k] = buffer_time_digits[k];
+        s->time_digits[k] = time_digits[k];
+        s->alarm_time_digits[k] = alarm_time_digits[k];
+        s->timer_display_digits[k] = timer_display_digits[k];
+        s->temperature_display_digits[k] = temperature_display_digits[k];
+    }
+    s->alarm_activation = alarm_activation;
+    s->alarm_sounding = alarm_sounding;
+    s->temperature_unit = temperature_unit;
+    s->countdown_minutes = countdown_minutes;
+    s->countdown_digits_typed = countdown_digits_typed;
+    for(int k = 0; k < COUNTDOWN_TIMERS; k++)
+        s->countdowns_running += countdowns[k] != TIMER_NONE;
+    s->stopwatch_running = stopwatch_running;
+}
+
+static void run_reference(const uiCase * c){
+    if(c->kind == input_button)
+        reference_button(c->input);
+    else if(c->kind == input_switch)
+        reference_switch((switchEvent)c->input);
+    else if(c->kind == input_gesture)
+        reference_gesture((shakeGesture)c->input);
+    else if(c->kind == input_countdown)
+        reference_countdown();
+    else
+        reference_alarm();
+}
+
+static void run_table(const uiCase * c){
+    if(c->kind == input_button)
+        dispatch_event(button_event(c->input), c->input);
+    else if(c->kind == input_switch)
+        dispatch_event(switch_event((switchEvent)c->input), 0);
+    else if(c->kind == input_gesture)
+        dispatch_event(shake_event((shakeGesture)c->input), 0);
+    else if(c->kind == input_countdown)
+        dispatch_event(event_countdown, 0);
+    else
+        dispatch_event(event_alarm, 0);
+}
+
+// Runs a case both ways. Returns 1 if they end the same. The cursor only matters in
+// set_time and set_alarm: M used to clear it in every state, it is now set on entry.
+static int check_case(const uiCase * c){
+    uiSnapshot expected, actual;
+    arrange(c);
+    run_reference(c);
+    take_snapshot(&expected);
+    arrange(c);
+    run_table(c);
+    take_snapshot(&actual);
+
+    if(expected.state != set_time && expected.state != set_alarm)
+        expected.cursor_digit = actual.cursor_digit;
+    if(memcmp(&expected, &actual, sizeof(uiSnapshot)) == 0)
+        return 1;
+    printf("state %d hour mode %d cursor %d input %d/%c: expected state %d, got %d\n",
+        c->state, c->hour_mode, c->cursor, c->kind, c->input, expected.state, actual.state);
+    return 0;
+}
+
+// Remote buttons, including one not mapped ('?') and a transmission error ('E')
+static const char buttons[] = "0123456789MSRL/APE?";
+
+static int check_state(stateType s){
+    int mismatches = 0;
+    for(int mode = 0; mode < 2; mode++)
+    for(char cursor = 0; cursor < 4; cursor++)
+    for(char pm = 0; pm < 2; pm++){
+        uiCase c = {s, mode, cursor, pm, input_button, 0};
+        for(const char * b = buttons; *b; b++){
+            c.input = *b;
+            mismatches += !check_case(&c);
+        }
+        c.kind = input_switch;
+        for(char input = switch_click; input <= switch_double_click; input++){
+            c.input = input;
+            mismatches += !check_case(&c);
+        }
+        c.kind = input_gesture;
+        for(char input = shake_tap; input <= shake_dismiss; input++){
+            c.input = input;
+            mismatches += !check_case(&c);
+        }
+        c.kind = input_countdown;
+        c.input = 0;
+        mismatches += !check_case(&c);
+        c.kind = input_alarm;
+        mismatches += !check_case(&c);
+    }
+    return mismatches;
+}
+
+void setUp(){
+}
+
+void tearDown(){
+}
+
+void test_show_time(){
+    TEST_ASSERT_EQUAL(0, check_state(show_time));
+}
+
+void test_alarm_on(){
+    TEST_ASSERT_EQUAL(0, check_state(alarm_on));
+}
+
+void test_set_time(){
+    TEST_ASSERT_EQUAL(0, check_state(set_time));
+}
+
+void test_set_alarm(){
+    TEST_ASSERT_EQUAL(0, check_state(set_alarm));
+}
+
+void test_show_timer(){
+    TEST_ASSERT_EQUAL(0, check_state(show_timer));
+}
+
+void test_show_temperature(){
+    TEST_ASSERT_EQUAL(0, check_state(show_temperature));
+}
+
+// The button events cover every event of the table
+void test_events_cover_table(){
+    char seen[event_count] = {0};
+    for(const char * b = buttons; *b; b++)
+        seen[button_event(*b)] = 1;
+    for(char input = switch_click; input <= switch_double_click; input++)
+        seen[switch_event((switchEvent)input)] = 1;
+    for(char input = shake_tap; input <= shake_dismiss; input++)
+        seen[shake_event((shakeGesture)input)] = 1;
+    // given by countdown_take_expired() and alarm_take_due() in the main loop
+    seen[event_countdown] = 1;
+    seen[event_alarm] = 1;
+    for(int event = 0; event < event_count; event++)
+        TEST_ASSERT_EQUAL(1, seen[event]);
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_show_time);
+    RUN_TEST(test_alarm_on);
+    RUN_TEST(test_set_time);
+    RUN_TEST(test_set_alarm);
+    RUN_TEST(test_show_timer);
+    RUN_TEST(test_show_temperature);
+    RUN_TEST(test_events_cover_table);
+    return UNITY_END();
+}
@@ -0,0 +1,218 @@
+#include <unity.h>
+#include <avr/io.h>
+#include "global_header.h"
+#include "warm_restart.h"
+#include "watchdog.h"
+
+// Warm restart (warm_restart.cpp) on the host: the state is saved with save_clock_state(),
+// the clock variables are changed as a reset to the initial values would, then
+// restore_clock_state() is called for each reset cause and with a corrupted copy. The
+// firmware is not booted, the saved copy and the reset cause are set directly.
+
+// Current system state (global variable in main)
+extern volatile stateType state;
+
+// Current clock time digits and AM/PM status (global variables in main)
+extern volatile char time_digits [TIME_DIGITS_NUMBER];
+extern volatile char am_pm;
+extern volatile int hour_mode;
+// Alarm time digits and AM/PM status (global variables in main)
+extern volatile char alarm_time_digits [TIME_DIGITS_NUMBER];
+extern volatile char alarm_am_pm;
+
+// Status of alarm being activated or deactivated (global variable in main)
+extern volatile char alarm_activation;
+
+// Counter of clock ticks within the current minute and minutes counted but not advanced
+// yet (global variables in clock)
+extern volatile unsigned int counter;
+extern volatile unsigned int clock_minutes_pending;
+
+// Current date in days since 2000-01-01 (global variable in calendar)
+extern volatile unsigned int day_number;
+
+// Copy of the state kept across resets, as in warm_restart.cpp
+typedef struct savedState_struct {
+    unsigned int magic;
+    char time_digits [TIME_DIGITS_NUMBER];
+    char am_pm;
+    char hour_mode;
+    char alarm_time_digits [TIME_DIGITS_NUMBER];
+    char alarm_am_pm;
+    char alarm_activation;
+    char state;
+    unsigned int counter;
+    unsigned int day_number;
+    unsigned char checksum;
+} savedState;
+
+// Saved state (global variable in warm_restart)
+extern savedState saved_state;
+
+// State saved by every test: 23:47 in 24-hour mode, alarm 6:30 AM turned off, ringing
+static const char saved_time [TIME_DIGITS_NUMBER] = {2, 3, 4, 7};
+static const char saved_alarm [TIME_DIGITS_NUMBER] = {0, 6, 3, 0};
+#define SAVED_COUNTER 4321
+#define SAVED_DAY 9000
+
+// Sets the clock variables to the state above and saves them
+static void save_state(){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        time_digits[k] = saved_time[k];
+        alarm_time_digits[k] = saved_alarm[k];
+    }
+    am_pm = 1;
+    hour_mode = 1;
+    alarm_am_pm = 0;
+    alarm_activation = 0;
+    state = alarm_on;
+    counter = SAVED_COUNTER;
+    clock_minutes_pending = 0;
+    day_number = SAVED_DAY;
+    save_clock_state();
+}
+
+// Sets the clock variables back to their initial values, as the C runtime does at reset
+static void reset_state(){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        time_digits[k] = 0;
+        alarm_time_digits[k] = 0;
+    }
+    am_pm = 0;
+    hour_mode = 0;
+    alarm_am_pm = 0;
+    alarm_activation = 1;
+    state = show_time;
+    counter = 0;
+    day_number = 0;
+}
+
+static void check_restored(){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        TEST_ASSERT_EQUAL(saved_time[k], time_digits[k]);
+        TEST_ASSERT_EQUAL(saved_alarm[k], alarm_time_digits[k]);
+    }
+    TEST_ASSERT_EQUAL(1, am_pm);
+    TEST_ASSERT_EQUAL(1, hour_mode);
+    TEST_ASSERT_EQUAL(0, alarm_am_pm);
+    TEST_ASSERT_EQUAL(0, alarm_activation);
+    TEST_ASSERT_EQUAL(alarm_on, state);
+    TEST_ASSERT_EQUAL(SAVED_COUNTER, counter);
+    TEST_ASSERT_EQUAL(SAVED_DAY, day_number);
+}
+
+static void check_initial(){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++){
+        TEST_ASSERT_EQUAL(0, time_digits[k]);
+        TEST_ASSERT_EQUAL(0, alarm_time_digits[k]);
+    }
+    TEST_ASSERT_EQUAL(0, hour_mode);
+    TEST_ASSERT_EQUAL(1, alarm_activation);
+    TEST_ASSERT_EQUAL(show_time, state);
+    TEST_ASSERT_EQUAL(0, counter);
+    TEST_ASSERT_EQUAL(0, day_number);
+}
+
+void setUp(){
+    save_state();
+    reset_state();
+}
+
+void tearDown(){
+}
+
+// RAM content is random after a power-on reset: the copy is not used even when valid,
+// also with the brown-out flag that comes along with a slow power up
+void test_power_on_reset_keeps_initial_state(){
+    reset_cause = 1 << PORF;
+    TEST_ASSERT_EQUAL(0, restore_clock_state());
+    check_initial();
+
+    reset_cause = 1 << PORF | 1 << BORF;
+    TEST_ASSERT_EQUAL(0, restore_clock_state());
+    check_initial();
+}
+
+// Watchdog, brown-out and external resets keep RAM: the time, alarm and mode are restored
+void test_watchdog_reset_restores_state(){
+    reset_cause = 1 << WDRF;
+    TEST_ASSERT_EQUAL(1, restore_clock_state());
+    check_restored();
+}
+
+void test_brown_out_reset_restores_state(){
+    reset_cause = 1 << BORF;
+    TEST_ASSERT_EQUAL(1, restore_clock_state());
+    check_restored();
+}
+
+void test_external_reset_restores_state(){
+    reset_cause = 1 << EXTRF;
+    TEST_ASSERT_EQUAL(1, restore_clock_state());
+    check_restored();
+}
+
+// Only a ringing alarm is kept, setting the time or the alarm starts again from show_time
+void test_other_states_restart_in_show_time(){
+    state = set_alarm;
+    save_clock_state();
+    reset_state();
+    state = set_time;
+
+    reset_cause = 1 << EXTRF;
+    TEST_ASSERT_EQUAL(1, restore_clock_state());
+    TEST_ASSERT_EQUAL(show_time, state);
+}
+
+// A copy without the magic number was never saved
+void test_bad_magic_keeps_initial_state(){
+    saved_state.magic ^= 0x0100;
+    reset_cause = 1 << WDRF;
+    TEST_ASSERT_EQUAL(0, restore_clock_state());
+    check_initial();
+}
+
+// A flipped bit in the checksum, or in a field it covers, rejects the copy
+void test_flipped_checksum_keeps_initial_state(){
+    saved_state.checksum ^= 0x01;
+    reset_cause = 1 << WDRF;
+    TEST_ASSERT_EQUAL(0, restore_clock_state());
+    check_initial();
+}
+
+void test_flipped_field_keeps_initial_state(){
+    saved_state.time_digits[1] ^= 0x04;
+    reset_cause = 1 << WDRF;
+    TEST_ASSERT_EQUAL(0, restore_clock_state());
+    check_initial();
+}
+
+// A minute counted by the clock timer interrupt but not advanced in the time digits yet
+// would be lost: the previous copy is kept until the next second
+void test_pending_minute_keeps_previous_copy(){
+    for(int k = 0; k < TIME_DIGITS_NUMBER; k++)
+        time_digits[k] = saved_time[k];
+    time_digits[3] = 8;
+    clock_minutes_pending = 1;
+    save_clock_state();
+    clock_minutes_pending = 0;
+    reset_state();
+
+    reset_cause = 1 << WDRF;
+    TEST_ASSERT_EQUAL(1, restore_clock_state());
+    check_restored();
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_power_on_reset_keeps_initial_state);
+    RUN_TEST(test_watchdog_reset_restores_state);
+    RUN_TEST(test_brown_out_reset_restores_state);
+    RUN_TEST(test_external_reset_restores_state);
+    RUN_TEST(test_other_states_restart_in_show_time);
+    RUN_TEST(test_bad_magic_keeps_initial_state);
+    RUN_TEST(test_flipped_checksum_keeps_initial_state);
+    RUN_TEST(test_flipped_field_keeps_initial_state);
+    RUN_TEST(test_pending_minute_keeps_previous_copy);
+    return UNITY_END();
+}
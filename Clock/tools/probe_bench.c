@@ -0,0 +1,335 @@
+/*
+ * simavr harness for the timing probes (src/probe.h): runs the megaatmega2560_probe
+ * firmware image on a simulated ATmega2560 at 16 MHz and records PORTF to a VCD trace
+ * for tools/probe_report.py. Built and run by tools/probe_bench.sh.
+ *
+ * Usage:
+ *     probe_bench firmware.elf trace.vcd [seconds]
+ *
+ * Inputs are driven through the simavr pin and TWI interrupts so every probe runs:
+ * the IR receiver output (PH4) sends an NEC frame of a remote button every second,
+ * cycling through a sequence that goes around the menus and sets the alarm, and an
+ * MPU-6050 at address 0x68 answers on the TWI bus with an accelerometer reading that
+ * shakes the clock for a few seconds in the middle of the run. The push button (PE4)
+ * is held released.
+ *
+ * At the end of the run the entry jitter of the remote and clock timer interrupts
+ * (remote_isr_jitter and clock_isr_jitter, src/latency.h) is read from the RAM of the
+ * simulated AVR and printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <elf.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "sim_irq.h"
+#include "sim_cycle_timers.h"
+#include "sim_vcd_file.h"
+#include "avr_ioport.h"
+#include "avr_twi.h"
+
+#define F_CPU 16000000
+
+/* NEC slot length in microseconds */
+#define NEC_SLOT_US 562.5
+
+/* Buttons sent one per second: menus, alarm set to 12:01, back to the time */
+static const char button_sequence[] = "MM1201MMM/RL";
+
+/* Command codes of the remote buttons, as in button_code_to_button() (src/remote.cpp) */
+static unsigned char button_code(char button){
+    switch(button){
+        case '0': return 0x68;
+        case '1': return 0x30;
+        case '2': return 0x18;
+        case '3': return 0x7A;
+        case '4': return 0x10;
+        case '5': return 0x38;
+        case '6': return 0x5A;
+        case '7': return 0x42;
+        case '8': return 0x4A;
+        case '9': return 0x52;
+        case 'M': return 0x62;
+        case 'S': return 0xE2;
+        case 'R': return 0xC2;
+        case 'L': return 0x02;
+        case '/': return 0x98;
+        case 'A': return 0xA2;
+        case 'P': return 0xA8;
+        default: return 0x00;
+    }
+}
+
+/*IR receiver*/
+
+/* Edges of the frame being sent: times from the start of the frame in microseconds,
+   the receiver output going low (burst) on even edges and high on odd ones */
+typedef struct irFrame_struct {
+    avr_irq_t * pin;
+    double edges[2 * 34];
+    int edge_count;
+    int next_edge;
+    avr_cycle_count_t start;
+    int buttons_sent;
+} irFrame;
+
+static void build_frame(irFrame * frame, unsigned char code){
+    int bits[32];
+    for(int k = 0; k < 8; k++){
+        bits[k] = 0;
+        bits[8 + k] = 1;
+        bits[16 + k] = (code >> (7 - k)) & 1;
+        bits[24 + k] = ((unsigned char)~code >> (7 - k)) & 1;
+    }
+
+    double t = 0;
+    frame->edge_count = 0;
+    /* 9 ms burst, 4.5 ms space */
+    frame->edges[frame->edge_count++] = t;
+    t += 16 * NEC_SLOT_US;
+    frame->edges[frame->edge_count++] = t;
+    t += 8 * NEC_SLOT_US;
+    /* 32 bits, then the final burst */
+    for(int k = 0; k <= 32; k++){
+        frame->edges[frame->edge_count++] = t;
+        t += NEC_SLOT_US;
+        frame->edges[frame->edge_count++] = t;
+        t += (k < 32 && bits[k]) ? 3 * NEC_SLOT_US : NEC_SLOT_US;
+    }
+    frame->next_edge = 0;
+}
+
+/* Cycle timer: starts a frame a second after the start of the previous one and drives
+   its edges */
+static avr_cycle_count_t ir_edge(avr_t * avr, avr_cycle_count_t when, void * param){
+    irFrame * frame = (irFrame *)param;
+
+    if(frame->next_edge == frame->edge_count){
+        char button = button_sequence[frame->buttons_sent % (sizeof(button_sequence) - 1)];
+        frame->buttons_sent += 1;
+        build_frame(frame, button_code(button));
+        frame->start = when;
+    }
+
+    avr_raise_irq(frame->pin, frame->next_edge & 1);
+    frame->next_edge += 1;
+
+    if(frame->next_edge == frame->edge_count)
+        return frame->start + avr_usec_to_cycles(avr, 1000000);
+    /* edges are not whole microseconds */
+    return frame->start + (avr_cycle_count_t)(frame->edges[frame->next_edge] * (F_CPU / 1000000));
+}
+
+/*MPU-6050*/
+
+#define MPU_ADDRESS 0x68
+#define MPU_ACCEL_XOUT_H 0x3B
+
+/* Register file, register pointer and bytes received since the address */
+typedef struct mpu_struct {
+    avr_irq_t * irq;
+    unsigned char registers[128];
+    unsigned char pointer;
+    int selected;
+    int bytes;
+} mpu;
+
+static void mpu_set_accel(mpu * m, int x, int y, int z){
+    int values[3] = {x, y, z};
+    for(int k = 0; k < 3; k++){
+        m->registers[MPU_ACCEL_XOUT_H + 2 * k] = (values[k] >> 8) & 0xFF;
+        m->registers[MPU_ACCEL_XOUT_H + 2 * k + 1] = values[k] & 0xFF;
+    }
+}
+
+/* TWI messages from the AVR: acknowledges its address and the bytes written to it,
+   the first being the register pointer, and answers reads from the register file */
+static void mpu_twi_hook(avr_irq_t * irq, uint32_t value, void * param){
+    mpu * m = (mpu *)param;
+    (void)irq;
+    avr_twi_msg_irq_t message;
+    message.u.v = value;
+
+    if(message.u.twi.msg & TWI_COND_STOP)
+        m->selected = 0;
+
+    if(message.u.twi.msg & TWI_COND_START){
+        m->selected = 0;
+        m->bytes = 0;
+        if((message.u.twi.addr >> 1) == MPU_ADDRESS){
+            m->selected = message.u.twi.addr;
+            avr_raise_irq(m->irq + TWI_IRQ_INPUT,
+                avr_twi_irq_msg(TWI_COND_ACK, m->selected, 1));
+        }
+    }
+
+    if(!m->selected)
+        return;
+
+    if(message.u.twi.msg & TWI_COND_WRITE){
+        avr_raise_irq(m->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, m->selected, 1));
+        if(m->bytes == 0)
+            m->pointer = message.u.twi.data & 0x7F;
+        else
+            m->registers[m->pointer++ & 0x7F] = message.u.twi.data;
+        m->bytes += 1;
+    }
+
+    if(message.u.twi.msg & TWI_COND_READ){
+        unsigned char data = m->registers[m->pointer++ & 0x7F];
+        avr_raise_irq(m->irq + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_READ, m->selected, data));
+    }
+}
+
+static void mpu_connect(avr_t * avr, mpu * m){
+    static const char * names[2] = {"8>mpu.out", "32<mpu.in"};
+    memset(m, 0, sizeof(mpu));
+    m->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, names);
+    avr_irq_register_notify(m->irq + TWI_IRQ_OUTPUT, mpu_twi_hook, m);
+    avr_connect_irq(m->irq + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), m->irq + TWI_IRQ_OUTPUT);
+    /* flat on the table, 1 g on Z, 25 C */
+    mpu_set_accel(m, 0, 0, 16384);
+    m->registers[0x41] = 0xF0;
+    m->registers[0x42] = 0xB0;
+}
+
+/* Accelerometer reading every 5 ms: still, then 4 Hz shaking along X from 4 s to 8 s
+   of the run */
+static avr_cycle_count_t mpu_motion(avr_t * avr, avr_cycle_count_t when, void * param){
+    mpu * m = (mpu *)param;
+    double seconds = (double)when / avr->frequency;
+    int x = 0;
+    if(seconds >= 4 && seconds < 8)
+        x = (int)(12000 * sin(2 * M_PI * 4 * seconds));
+    mpu_set_accel(m, x, 0, 16384);
+    return when + avr_usec_to_cycles(avr, 5000);
+}
+
+/*Interrupt entry jitter*/
+
+/* Offset of the data space addresses in the AVR ELF files */
+#define AVR_DATA_OFFSET 0x800000
+
+/* Address of a symbol in the symbol table of an ELF32 file, -1 if it is not found */
+static long symbol_address(const char * path, const char * name){
+    FILE * file = fopen(path, "rb");
+    if(!file)
+        return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char * image = malloc(size);
+    if(!image || fread(image, 1, size, file) != (size_t)size){
+        free(image);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    long address = -1;
+    const Elf32_Ehdr * header = (const Elf32_Ehdr *)image;
+    const Elf32_Shdr * sections = (const Elf32_Shdr *)(image + header->e_shoff);
+    for(int s = 0; s < header->e_shnum && address < 0; s++){
+        if(sections[s].sh_type != SHT_SYMTAB)
+            continue;
+        const Elf32_Sym * symbols = (const Elf32_Sym *)(image + sections[s].sh_offset);
+        const char * names = (const char *)(image + sections[sections[s].sh_link].sh_offset);
+        int count = sections[s].sh_size / sizeof(Elf32_Sym);
+        for(int k = 0; k < count; k++){
+            if(strcmp(names + symbols[k].st_name, name) == 0){
+                address = symbols[k].st_value;
+                break;
+            }
+        }
+    }
+    free(image);
+    return address;
+}
+
+/* Prints an isrJitter record (two 16-bit timer counts, lowest and highest count read
+   at the start of the routine) with the cycles per count of its timer */
+static void print_jitter(avr_t * avr, const char * elf, const char * name, int cycles_per_count){
+    long address = symbol_address(elf, name);
+    if(address < AVR_DATA_OFFSET){
+        printf("%s: not in the firmware\n", name);
+        return;
+    }
+    const uint8_t * data = avr->data + (address - AVR_DATA_OFFSET);
+    unsigned int min_count = data[0] | data[1] << 8;
+    unsigned int max_count = data[2] | data[3] << 8;
+    if(min_count > max_count){
+        printf("%s: no interrupt recorded\n", name);
+        return;
+    }
+    printf("%s: entry at count %u to %u, jitter %u cycles\n", name, min_count, max_count,
+        (max_count - min_count) * cycles_per_count);
+}
+
+int main(int argc, char * argv[]){
+
+    if(argc < 3){
+        fprintf(stderr, "usage: %s firmware.elf trace.vcd [seconds]\n", argv[0]);
+        return 2;
+    }
+    double seconds = argc > 3 ? atof(argv[3]) : 12;
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if(elf_read_firmware(argv[1], &firmware) != 0){
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    avr_t * avr = avr_make_mcu_by_name("atmega2560");
+    if(!avr){
+        fprintf(stderr, "simavr has no atmega2560 core\n");
+        return 1;
+    }
+    avr_init(avr);
+    avr->frequency = F_CPU;
+    avr_load_firmware(avr, &firmware);
+
+    /* PORTF pins as one 8-bit signal, the name tools/probe_report.py looks for */
+    avr_vcd_t vcd;
+    avr_vcd_init(avr, argv[2], &vcd, 1000);
+    avr_vcd_add_signal(&vcd, avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('F'), IOPORT_IRQ_PIN_ALL),
+        8, "PORTF");
+    avr_vcd_start(&vcd);
+
+    /* idle IR receiver output and released button are high */
+    static irFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.pin = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('H'), 4);
+    avr_raise_irq(frame.pin, 1);
+    avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('E'), 4), 1);
+    /* first button once the firmware has booted */
+    avr_cycle_timer_register_usec(avr, 500000, ir_edge, &frame);
+
+    static mpu accelerometer;
+    mpu_connect(avr, &accelerometer);
+    avr_cycle_timer_register_usec(avr, 5000, mpu_motion, &accelerometer);
+
+    avr_cycle_count_t end = (avr_cycle_count_t)(seconds * F_CPU);
+    int state = cpu_Running;
+    while(avr->cycle < end && state != cpu_Done && state != cpu_Crashed)
+        state = avr_run(avr);
+
+    avr_vcd_stop(&vcd);
+    avr_vcd_close(&vcd);
+
+    if(state == cpu_Crashed){
+        fprintf(stderr, "the firmware crashed at %.3f s\n", (double)avr->cycle / F_CPU);
+        return 1;
+    }
+    printf("%.1f s simulated, %d buttons sent\n", (double)avr->cycle / F_CPU, frame.buttons_sent);
+
+    /* remote timer prescaler 1, clock timer prescaler 8 */
+    print_jitter(avr, argv[1], "remote_isr_jitter", 1);
+    print_jitter(avr, argv[1], "clock_isr_jitter", 8);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Cycle benchmark of the interrupt handlers and hot paths under simavr: builds the
+# megaatmega2560_probe firmware and the simavr harness (tools/probe_bench.c), runs the
+# firmware with remote buttons and accelerometer movement for a few seconds, records
+# PORTF and reports the cycles of each probe with tools/probe_report.py. The report is
+# stored in .pio/probe_bench/report.json.
+#
+# Usage (from the Clock directory):
+#     tools/probe_bench.sh [seconds]
+#     tools/probe_bench.sh --baseline report.json [seconds]
+#
+# Needs PlatformIO, simavr (with its pkg-config file, or SIMAVR_CFLAGS and
+# SIMAVR_LIBS set) and libelf. With --baseline, the run is compared with the report of
+# an earlier run (for example a copy of report.json made before a change) and fails when
+# a probe got slower by more than 10 %. No baseline is kept in the repository.
+
+set -e
+
+baseline=
+if [ "$1" = "--baseline" ]; then
+    baseline=$2
+    shift 2
+fi
+seconds=${1:-12}
+
+out=.pio/probe_bench
+mkdir -p "$out"
+
+pio run -e megaatmega2560_probe
+
+cflags=${SIMAVR_CFLAGS:-$(pkg-config --cflags simavr)}
+libs=${SIMAVR_LIBS:-$(pkg-config --libs simavr)}
+cc -O2 -std=gnu99 $cflags -o "$out/probe_bench" tools/probe_bench.c $libs -lelf -lm
+
+"$out/probe_bench" .pio/build/megaatmega2560_probe/firmware.elf "$out/probe.vcd" "$seconds"
+
+if [ -n "$baseline" ]; then
+    python3 tools/probe_report.py "$out/probe.vcd" --json "$out/report.json" \
+        --baseline "$baseline"
+else
+    python3 tools/probe_report.py "$out/probe.vcd" --json "$out/report.json"
+fi
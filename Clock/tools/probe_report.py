@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Cycle counts per interrupt handler and hot function from a trace of the probe pins.
+
+Build the megaatmega2560_probe environment (PROBE_ENABLED, see src/probe.h), run it
+under simavr or on the board, and record PORTF as a VCD file: an 8-bit PORTF signal
+(simavr register trace, tools/probe_bench.sh) or one signal per pin named PF0..PF7
+or PORTF0..PORTF7 (logic analyzer).
+
+Usage:
+    probe_report.py trace.vcd [--json report.json] [--baseline baseline.json]
+                              [--tolerance 10]
+
+The report gives, for each probe, how many times it ran and the minimum, mean and
+maximum cycles (16 MHz) it took. The main loop probe toggles once per iteration, so
+its numbers are cycles per interaction loop iteration. Interrupt handler numbers do
+not include the prologue and epilogue the compiler adds around the handler body.
+
+With --baseline, mean and maximum cycles are compared with a previous report and the
+script fails if any probe got more than --tolerance percent slower.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+F_CPU = 16000000
+
+# PORTF pin of each probe, must match probeChannel in src/probe.h
+PROBES = ["display_isr", "clock_isr", "remote_isr", "chirp_isr", "spi_isr",
+          "main_loop", "remote_input", "movement"]
+
+# probes that toggle once per run instead of being high while running
+TOGGLED = {"main_loop"}
+
+TIME_UNITS = {"s": 1, "ms": 1e-3, "us": 1e-6, "ns": 1e-9, "ps": 1e-12, "fs": 1e-15}
+
+
+def read_vcd(path):
+    """Returns the time of every change of each PORTF pin, in seconds."""
+    timescale = 1e-9
+    pin_ids = {}    # VCD identifier -> pin number
+    port_ids = set()
+    changes = [[] for _ in PROBES]
+    levels = [0] * len(PROBES)
+    now = 0
+
+    def set_pin(pin, level):
+        if level != levels[pin]:
+            levels[pin] = level
+            changes[pin].append((now * timescale, level))
+
+    with open(path) as vcd:
+        text = vcd.read()
+
+    header, _, body = text.partition("$enddefinitions")
+    match = re.search(r"\$timescale\s*(\d+)\s*(\w+)\s*\$end", header)
+    if match:
+        timescale = int(match.group(1)) * TIME_UNITS[match.group(2)]
+    for width, ident, name in re.findall(r"\$var\s+\w+\s+(\d+)\s+(\S+)\s+(\S+)", header):
+        pin = re.fullmatch(r"P(?:ORT)?F(\d)", name, re.IGNORECASE)
+        if int(width) == 8 and name.upper() == "PORTF":
+            port_ids.add(ident)
+        elif int(width) == 1 and pin and int(pin.group(1)) < len(PROBES):
+            pin_ids[ident] = int(pin.group(1))
+    if not port_ids and not pin_ids:
+        raise SystemExit("no PORTF signal in " + path)
+
+    for token in body.split()[1:]:
+        if token.startswith("#"):
+            now = int(token[1:])
+        elif token[0] in "bB":
+            value = token[1:]
+        elif token[0] in "01xXzZ" and token[1:] in pin_ids:
+            set_pin(pin_ids[token[1:]], 1 if token[0] == "1" else 0)
+        elif token in port_ids:
+            bits = int(value.replace("x", "0").replace("z", "0"), 2)
+            for pin in range(len(PROBES)):
+                set_pin(pin, (bits >> pin) & 1)
+    return changes
+
+
+def durations(name, changes):
+    """Cycles of each run of a probe."""
+    cycles = []
+    if name in TOGGLED:
+        for (start, _), (end, _) in zip(changes, changes[1:]):
+            cycles.append((end - start) * F_CPU)
+    else:
+        start = None
+        for time, level in changes:
+            if level:
+                start = time
+            elif start is not None:
+                cycles.append((time - start) * F_CPU)
+                start = None
+    return [round(c) for c in cycles]
+
+
+def report(changes):
+    probes = {}
+    for pin, name in enumerate(PROBES):
+        cycles = durations(name, changes[pin])
+        if cycles:
+            probes[name] = {"count": len(cycles), "min_cycles": min(cycles),
+                            "mean_cycles": round(sum(cycles) / len(cycles), 1),
+                            "max_cycles": max(cycles)}
+    return {"cpu_hz": F_CPU, "probes": probes}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("vcd")
+    parser.add_argument("--json", help="write the report to this file")
+    parser.add_argument("--baseline", help="report to compare with")
+    parser.add_argument("--tolerance", type=float, default=10,
+                        help="allowed slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    result = report(read_vcd(args.vcd))
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(result, out, indent=2)
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as base:
+            baseline = json.load(base)["probes"]
+
+    print("%-14s %8s %8s %10s %8s" % ("probe", "count", "min", "mean", "max"))
+    regressions = []
+    for name, probe in result["probes"].items():
+        line = "%-14s %8d %8d %10.1f %8d" % (name, probe["count"], probe["min_cycles"],
+                                            probe["mean_cycles"], probe["max_cycles"])
+        if name in baseline:
+            for field in ("mean_cycles", "max_cycles"):
+                before, after = baseline[name][field], probe[field]
+                if before and (after - before) * 100.0 / before > args.tolerance:
+                    regressions.append("%s %s %s -> %s" % (name, field, before, after))
+            line += "   (baseline mean %.1f, max %d)" % (baseline[name]["mean_cycles"],
+                                                      baseline[name]["max_cycles"])
+        print(line)
+
+    if regressions:
+        print("\nslower than the baseline by more than %g%%:" % args.tolerance)
+        for regression in regressions:
+            print("  " + regression)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Decodes an event trace dumped by dump_trace() (src/trace.cpp) into a timeline.
+
+Usage:
+    trace_decode.py dump.bin
+    trace_decode.py /dev/ttyACM0      (needs pyserial, waits for the next dump)
+
+The dump is "TR", the number of records, the record size, then the records oldest
+first. A record is the clock tick (10 ms, 16 bits), the event and a 16-bit argument,
+little endian. Times are seconds since the boot, each reset record starts a new boot.
+"""
+
+import struct
+import sys
+
+TICK_MS = 10
+
+# Must match traceEvent in src/trace.h
+EVENTS = ["reset", "state", "button", "remote_error", "motion",
+          "alarm_on", "alarm_off", "i2c_error", "switch", "gps",
+          "mpu_mode", "stack_peak", "stack_free"]
+
+# Must match switchEvent in src/switch.h
+SWITCH_EVENTS = ["none", "click", "long_press", "double_click"]
+
+# Must match shakeGesture in src/shake.h
+SHAKE_GESTURES = ["none", "tap", "dismiss"]
+
+# Must match gpsState in src/gps.h
+GPS_STATES = ["free_running", "locked", "holdover"]
+
+# Must match mpuMode in src/I2C.h
+MPU_MODES = ["off", "low_power", "full_power"]
+
+# Must match stateType in src/global_header.h
+STATES = ["show_time", "alarm_on", "set_time", "set_alarm", "show_timer",
+          "show_temperature"]
+
+# Must match i2cStatus in src/I2C.h
+I2C_STATUS = ["ok", "timeout", "nack", "bus_error"]
+
+RESET_CAUSES = [(0, "power-on"), (1, "external"), (2, "brown-out"), (3, "watchdog"), (4, "jtag")]
+
+
+def describe(event, arg):
+    name = EVENTS[event] if event < len(EVENTS) else "event_%d" % event
+    if name == "reset":
+        causes = [cause for bit, cause in RESET_CAUSES if arg & (1 << bit)]
+        return "reset (%s)" % (", ".join(causes) or "unknown")
+    if name == "motion":
+        gesture, state = arg >> 8, arg & 0xFF
+        return "motion %s in %s" % (
+            SHAKE_GESTURES[gesture] if gesture < len(SHAKE_GESTURES) else gesture,
+            STATES[state] if state < len(STATES) else state)
+    if name == "state":
+        state = STATES[arg] if arg < len(STATES) else str(arg)
+        return "%s %s" % (name, state)
+    if name in ("button", "remote_error"):
+        return "%s '%s'" % (name, chr(arg & 0xFF))
+    if name == "switch":
+        return "switch %s" % (SWITCH_EVENTS[arg] if arg < len(SWITCH_EVENTS) else arg)
+    if name == "gps":
+        return "gps %s" % (GPS_STATES[arg] if arg < len(GPS_STATES) else arg)
+    if name == "mpu_mode":
+        return "mpu_mode %s" % (MPU_MODES[arg] if arg < len(MPU_MODES) else arg)
+    if name == "i2c_error":
+        status = arg >> 8
+        return "i2c_error %s (TWSR 0x%02X)" % (
+            I2C_STATUS[status] if status < len(I2C_STATUS) else status, arg & 0xFF)
+    if name in ("stack_peak", "stack_free"):
+        return "%s %d bytes" % (name, arg)
+    return name if arg == 0 else "%s %d" % (name, arg)
+
+
+def read_dump(stream):
+    # find the header
+    previous = b""
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            raise SystemExit("no trace header found")
+        if previous + byte == b"TR":
+            break
+        previous = byte
+    records, size = stream.read(2)
+    data = stream.read(records * size)
+    return [struct.unpack_from("<HBH", data, k * size) for k in range(records)]
+
+
+def main():
+    if len(sys.argv) != 2:
+        raise SystemExit(__doc__)
+    path = sys.argv[1]
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        stream = serial.Serial(path, 115200)
+    else:
+        stream = open(path, "rb")
+
+    records = read_dump(stream)
+    if not records:
+        print("trace is empty")
+        return
+
+    # ticks are 16 bits, unwrap them assuming less than 655 s between records. The 
+    # trace survives warm restarts and the ticks start over at each one, so times are 
+    # counted from the last reset record.
+    elapsed = 0
+    previous_tick = records[0][0]
+    for tick, event, arg in records:
+        if event == EVENTS.index("reset"):
+            print("---------- boot ----------")
+            elapsed = 0
+            previous_tick = tick
+        elapsed += (tick - previous_tick) & 0xFFFF
+        previous_tick = tick
+        print("%10.2f s  %s" % (elapsed * TICK_MS / 1000.0, describe(event, arg)))
+
+
+if __name__ == "__main__":
+    main()